@@ -0,0 +1,458 @@
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <algorithm>    // std::min
+
+#include "AsyncFileReader.hpp"
+
+// POSIX reads at any offset
+#if defined(__unix__) || defined(__APPLE__)
+    #define PEPON_HAS_PREAD 1
+
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
+
+// io_uring, through raw system calls
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #include <sys/uio.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+        #include <linux/io_uring.h>
+
+        #if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+            #define PEPON_HAS_IO_URING 1
+        #endif
+    #endif
+#endif
+
+namespace pepon
+{
+
+namespace
+{
+
+#ifdef PEPON_HAS_IO_URING
+
+// Minimal io_uring: its submission and completion rings, for reads only
+class IoUring
+{
+
+    public:
+
+        // ctor. Check isValid(): io_uring may not be available
+        explicit IoUring(unsigned entries) noexcept
+        {
+
+            io_uring_params params {};
+
+            m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+
+            if (m_fd < 0)
+                return;
+
+            m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+            // Both rings in one mapping (kernel 5.4+)
+            m_singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0U;
+
+            if (m_singleMap)
+                m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+            m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+            m_cqRing = m_singleMap ? m_sqRing
+                                   : ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+
+            m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            m_sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+
+            if (m_sqRing == MAP_FAILED || m_cqRing == MAP_FAILED || m_sqes == MAP_FAILED)
+            {
+                this->release();
+                return;
+            }
+
+            auto* sq = static_cast<char*>(m_sqRing);
+            auto* cq = static_cast<char*>(m_cqRing);
+
+            m_sqTail  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            m_sqMask  = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+            m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            m_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            m_cqes   = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        }
+
+        // dtor
+        ~IoUring()
+        {
+            this->release();
+        }
+
+        IoUring(const IoUring&) = delete;
+        auto operator=(const IoUring&) = delete;
+
+
+        auto isValid() const noexcept -> bool
+        {
+            return m_fd >= 0;
+        }
+
+        // Queue a read into "buffer" (it must live until its completion)
+        void pushRead(int fileDescriptor, const iovec* buffer, std::uint64_t offset, std::uint64_t userData) noexcept
+        {
+            // Only this thread writes the tail
+            const unsigned tail  = *m_sqTail;
+            const unsigned index = tail & m_sqMask;
+
+            auto& entry = static_cast<io_uring_sqe*>(m_sqes)[index];
+            entry = io_uring_sqe {};
+
+            // READV (kernel 5.1+) rather than READ (5.6+)
+            entry.opcode    = IORING_OP_READV;
+            entry.fd        = fileDescriptor;
+            entry.addr      = reinterpret_cast<std::uint64_t>(buffer);
+            entry.len       = 1U;
+            entry.off       = offset;
+            entry.user_data = userData;
+
+            m_sqArray[index] = index;
+            __atomic_store_n(m_sqTail, tail + 1U, __ATOMIC_RELEASE);
+        }
+
+        // Submit the queued reads, and wait for at least one completion
+        // Returns how many were submitted, or -1 on errors
+        auto submitAndWait(unsigned toSubmit) noexcept -> int
+        {
+            while (true)
+            {
+                const auto submitted = ::syscall(__NR_io_uring_enter, m_fd, toSubmit, 1U, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+                if (submitted >= 0 || errno != EINTR)
+                    return static_cast<int>(submitted);
+            }
+        }
+
+        // Next completion, if any
+        auto popCompletion(std::uint64_t& userData, int& result) noexcept -> bool
+        {
+            const unsigned head = *m_cqHead;
+
+            if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+                return false;
+
+            const auto& completion = m_cqes[head & m_cqMask];
+            userData = completion.user_data;
+            result   = completion.res;
+
+            __atomic_store_n(m_cqHead, head + 1U, __ATOMIC_RELEASE);
+
+            return true;
+        }
+
+
+    private:
+
+        void release() noexcept
+        {
+            if (m_sqes != MAP_FAILED)
+                ::munmap(m_sqes, m_sqesSize);
+
+            if (m_cqRing != MAP_FAILED && !m_singleMap)
+                ::munmap(m_cqRing, m_cqRingSize);
+
+            if (m_sqRing != MAP_FAILED)
+                ::munmap(m_sqRing, m_sqRingSize);
+
+            if (m_fd >= 0)
+                ::close(m_fd);
+
+            m_sqes = m_cqRing = m_sqRing = MAP_FAILED;
+            m_fd = -1;
+        }
+
+
+    private:
+
+        int m_fd = -1;
+        bool m_singleMap = false;
+
+        void* m_sqRing = MAP_FAILED;
+        void* m_cqRing = MAP_FAILED;
+        void* m_sqes   = MAP_FAILED;
+
+        std::size_t m_sqRingSize = 0U;
+        std::size_t m_cqRingSize = 0U;
+        std::size_t m_sqesSize   = 0U;
+
+        // Submission ring
+        unsigned* m_sqTail  = nullptr;
+        unsigned  m_sqMask  = 0U;
+        unsigned* m_sqArray = nullptr;
+
+        // Completion ring
+        unsigned* m_cqHead = nullptr;
+        unsigned* m_cqTail = nullptr;
+        unsigned  m_cqMask = 0U;
+        io_uring_cqe* m_cqes = nullptr;
+
+};
+
+
+// Up to QUEUE_DEPTH reads of READ_SIZE bytes in flight
+// Returns false if io_uring is not available
+auto readWithIoUring(int fileDescriptor, char* data, std::size_t size, const AsyncFileReader::t_onData& onData) -> bool
+{
+
+    constexpr auto READ_SIZE = AsyncFileReader::READ_SIZE;
+
+    IoUring ring(AsyncFileReader::QUEUE_DEPTH);
+
+    if (!ring.isValid())
+        return false;
+
+    const std::size_t blocks = (size + READ_SIZE - 1U) / READ_SIZE;
+
+    // Bytes still to read of every block (reads can be short)
+    std::vector<std::size_t> pending(blocks);
+    std::vector<iovec> buffers(blocks);
+
+    for (std::size_t block = 0U; block < blocks; ++block)
+        pending[block] = std::min(READ_SIZE, size - block * READ_SIZE);
+
+    std::size_t next  = 0U;     // Next block to read
+    std::size_t ready = 0U;     // Blocks [0, ready) are complete
+    unsigned queued    = 0U;    // Reads in the ring, not submitted yet
+    unsigned submitted = 0U;    // Reads the kernel has, until they complete
+
+    // Read what is missing of a block
+    auto push = [&](std::size_t block)
+    {
+        const auto offset = block * READ_SIZE + (std::min(READ_SIZE, size - block * READ_SIZE) - pending[block]);
+
+        buffers[block] = { data + offset, pending[block] };
+        ring.pushRead(fileDescriptor, &buffers[block], offset, block);
+
+        ++queued;
+    };
+
+    try
+    {
+
+        while (ready < blocks)
+        {
+
+            while (queued + submitted < AsyncFileReader::QUEUE_DEPTH && next < blocks)
+                push(next++);
+
+            const int count = ring.submitAndWait(queued);
+
+            if (count < 0)
+                throw SyntaxError("File cannot be read!");
+
+            queued    -= static_cast<unsigned>(count);
+            submitted += static_cast<unsigned>(count);
+
+
+            std::uint64_t block;
+            int result;
+
+            while (ring.popCompletion(block, result))
+            {
+                --submitted;
+
+                if (result == -EINTR || result == -EAGAIN)
+                {
+                    push(block);
+                    continue;
+                }
+
+                // Errors, or the file is shorter than it was
+                if (result <= 0)
+                    throw SyntaxError("File cannot be read!");
+
+                pending[block] -= static_cast<std::size_t>(result);
+
+                if (pending[block] > 0U)
+                    push(block);
+            }
+
+
+            // More of the beginning of the file is ready?
+            const auto before = ready;
+
+            while (ready < blocks && pending[ready] == 0U)
+                ++ready;
+
+            if (ready != before)
+                onData({ data, std::min(ready * READ_SIZE, size) });
+
+        }
+
+    }
+    catch (...)
+    {
+        // The kernel writes into "data" until every submitted read completes
+        // Reads still queued in the ring are never submitted: do not wait for them
+        std::uint64_t block;
+        int result;
+
+        while (submitted > 0U && ring.submitAndWait(0U) >= 0)
+        {
+            while (ring.popCompletion(block, result))
+                --submitted;
+        }
+
+        throw;
+    }
+
+    return true;
+
+}
+
+#endif // PEPON_HAS_IO_URING
+
+
+#ifdef PEPON_HAS_PREAD
+
+// One read after another
+void readWithPread(int fileDescriptor, char* data, std::size_t size, const AsyncFileReader::t_onData& onData)
+{
+
+    std::size_t done = 0U;
+
+    while (done < size)
+    {
+        const auto bytes = std::min(AsyncFileReader::READ_SIZE, size - done);
+        const auto result = ::pread(fileDescriptor, data + done, bytes, static_cast<off_t>(done));
+
+        if (result < 0 && errno == EINTR)
+            continue;
+
+        if (result <= 0)
+            throw SyntaxError("File cannot be read!");
+
+        done += static_cast<std::size_t>(result);
+
+        onData({ data, done });
+    }
+
+}
+
+#endif // PEPON_HAS_PREAD
+
+} // anonymous namespace
+
+
+// Read a whole file. The last call to "onData" gets all of it
+auto AsyncFileReader::readFile(MappedFile::t_filePath fileName, const t_onData& onData, [[maybe_unused]] bool useIoUring) -> MappedFile
+{
+
+#ifdef PEPON_HAS_PREAD
+
+    #ifdef PEPON_USE_STL_PATH
+        const int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    #else
+        const int fd = ::open(std::string(fileName).c_str(), O_RDONLY | O_CLOEXEC);
+    #endif
+
+    if (fd < 0)
+        throw SyntaxError("File cannot be opened!");
+
+    struct stat info;
+
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw SyntaxError("File cannot be opened!");
+    }
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+    std::unique_ptr<char[]> buffer(new char[size]);
+
+    try
+    {
+
+        bool done = false;
+
+    #ifdef PEPON_HAS_IO_URING
+        if (useIoUring)
+            done = readWithIoUring(fd, buffer.get(), size, onData);
+    #endif
+
+        if (!done)
+            readWithPread(fd, buffer.get(), size, onData);
+
+        if (size == 0U)
+            onData({});
+
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+
+    ::close(fd);
+
+#else
+
+    std::ifstream handle;
+
+    #ifdef PEPON_USE_STL_PATH
+        handle.open(fileName, std::ios_base::binary | std::ios_base::ate);
+    #else
+        handle.open(std::string(fileName), std::ios_base::binary | std::ios_base::ate);
+    #endif
+
+    if (!handle)
+        throw SyntaxError("File cannot be opened!");
+
+    const auto size = static_cast<std::size_t>(handle.tellg());
+    handle.seekg(0, std::ios_base::beg);
+
+    std::unique_ptr<char[]> buffer(new char[size]);
+
+    for (std::size_t done = 0U; done < size; )
+    {
+        const auto bytes = std::min(READ_SIZE, size - done);
+
+        if (!handle.read(buffer.get() + done, static_cast<std::streamsize>(bytes)))
+            throw SyntaxError("File cannot be read!");
+
+        done += bytes;
+        onData({ buffer.get(), done });
+    }
+
+    if (size == 0U)
+        onData({});
+
+#endif
+
+    return MappedFile::fromBuffer(std::move(buffer), size);
+
+}
+
+
+// Can this process use io_uring?
+auto AsyncFileReader::hasIoUring() noexcept -> bool
+{
+
+#ifdef PEPON_HAS_IO_URING
+    static const bool available = IoUring(1U).isValid();
+
+    return available;
+#else
+    return false;
+#endif
+
+}
+
+} // pepon
@@ -0,0 +1,43 @@
+#ifndef ASYNC_FILE_READER_HPP
+#define ASYNC_FILE_READER_HPP
+
+#include <functional>
+#include <string_view>
+
+#include "MappedFile.hpp"
+
+namespace pepon
+{
+
+// Reads a whole file into one buffer, with several large reads in flight,
+// and reports every time the beginning of the file is ready, so it can be processed while the rest is read
+// Linux: io_uring (raw system calls, liburing is not needed)
+// Elsewhere, or when io_uring is not available (old kernels, seccomp...): one read after another
+class AsyncFileReader
+{
+
+    public:
+
+        // Size of every read, and how many are in flight
+        static constexpr std::size_t READ_SIZE = 1024U * 1024U;
+        static constexpr unsigned QUEUE_DEPTH  = 8U;
+
+        // The first bytes of the file, ready to use. Called on the reading thread, with more bytes every time
+        using t_onData = std::function<void(std::string_view ready)>;
+
+    public:
+
+        // Read a whole file. The last call to "onData" gets all of it
+        // useIoUring = false: one read after another, even if io_uring is available
+        // Throws SyntaxError if it cannot be read (or the file gets shorter). Exceptions of "onData" stop the reads, and are rethrown
+        static auto readFile(MappedFile::t_filePath fileName, const t_onData& onData, bool useIoUring = true) -> MappedFile;
+
+        // Can this process use io_uring?
+        static auto hasIoUring() noexcept -> bool;
+
+};
+
+} // pepon
+
+
+#endif // ASYNC_FILE_READER_HPP
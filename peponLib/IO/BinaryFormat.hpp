@@ -0,0 +1,94 @@
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace pepon
+{
+
+// ----------------------------------------------------------------------
+// Binary Pepon image layout
+// Every offset is relative to the beginning of the image, so it can be
+// memory mapped anywhere. Numbers are little endian, and every table and
+// numeric array is 8 bytes aligned
+//
+// [BinaryHeader][BinaryGroup table][BinaryVariable table][payload...]
+// ----------------------------------------------------------------------
+struct BinaryFormat
+{
+    static constexpr std::string_view MAGIC = "PEPONBIN";
+
+    static constexpr std::uint32_t VERSION    = 1U;
+    static constexpr std::uint32_t ENDIANNESS = 0x01020304U;
+
+    static constexpr std::size_t ALIGNMENT = 8U;
+};
+
+
+// Text stored in the payload
+struct BinaryString
+{
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+
+struct BinaryHeader
+{
+    char          magic[8];         // BinaryFormat::MAGIC
+    std::uint32_t version;          // BinaryFormat::VERSION
+    std::uint32_t endianness;       // BinaryFormat::ENDIANNESS, as written by the host
+
+    std::uint64_t imageSize;
+
+    std::uint64_t groupCount;
+    std::uint64_t groupTable;       // BinaryGroup[groupCount], sorted by name
+    std::uint64_t variableCount;
+    std::uint64_t variableTable;    // BinaryVariable[variableCount]
+
+    std::uint64_t reserved[4];      // Zero
+};
+
+
+struct BinaryGroup
+{
+    BinaryString  name;
+
+    std::uint64_t firstVariable;    // Index of its first variable in the variable table
+    std::uint64_t variableCount;
+    std::uint64_t sortedVariables;  // std::uint32_t[variableCount]: variable indices (from firstVariable), sorted by name
+
+    std::uint64_t comments;         // BinaryString[commentCount]
+    std::uint64_t commentCount;
+};
+
+
+// Values:
+// - Single values: int32/uint32/float/double, one byte bools, or the bytes of a string ("count" bytes)
+// - Containers: "count" packed elements (one byte bools), or BinaryString[count] for strings
+// - vector<bool>: "count" bits, in BitVector::wordCount(count) std::uint64_t words
+struct BinaryVariable
+{
+    BinaryString  name;
+
+    std::uint8_t  varType;          // IVariable::e_varType
+    std::uint8_t  cppType;          // e_cppTypes
+    std::uint8_t  padding[6];
+
+    std::uint64_t count;
+    std::uint64_t data;
+};
+
+
+// Values left in an image, decoded on first access (see IVariable::RawValue), keep [image begin, end of their BinaryVariable):
+// the image (its header has its size), and which variable of it
+inline auto getRawEntry(std::string_view raw) noexcept -> const BinaryVariable&
+{
+    return *reinterpret_cast<const BinaryVariable*>(raw.data() + raw.size() - sizeof(BinaryVariable));
+}
+
+} // pepon
+
+
+#endif // BINARY_FORMAT_HPP
@@ -0,0 +1,367 @@
+#include <cstring>      // std::memcmp
+#include <algorithm>    // std::lower_bound
+
+#include "BinaryView.hpp"
+
+namespace pepon
+{
+
+// ----------------------------------------------------------------------
+// VariableView
+// ----------------------------------------------------------------------
+BinaryView::VariableView::VariableView(const BinaryView& view, const BinaryVariable& entry) noexcept
+    : m_view(&view),
+      m_entry(&entry)
+{
+}
+
+
+auto BinaryView::VariableView::getName() const noexcept -> std::string_view
+{
+    return m_view->getString(m_entry->name);
+}
+
+
+auto BinaryView::VariableView::getVarType() const noexcept -> IVariable::e_varType
+{
+    return static_cast<IVariable::e_varType>(m_entry->varType);
+}
+
+
+auto BinaryView::VariableView::getCppType() const noexcept -> e_cppTypes
+{
+    return static_cast<e_cppTypes>(m_entry->cppType);
+}
+
+
+// Number of elements (containers), or bytes (single strings)
+auto BinaryView::VariableView::size() const noexcept -> std::size_t
+{
+    return m_entry->count;
+}
+
+
+// Containers of bools
+auto BinaryView::VariableView::getBool(std::size_t index) const -> bool
+{
+
+    this->checkType(true, e_cppTypes::BOOL);
+
+    if (index >= m_entry->count)
+        throw std::out_of_range("Binary Pepon: index out of range");
+
+    if (this->getVarType() == IVariable::e_varType::VECTOR)
+    {
+        const auto word = m_view->at<BitVector::t_word>(m_entry->data)[index / BitVector::WORD_BITS];
+        return (word >> (index % BitVector::WORD_BITS)) & 1U;
+    }
+
+    return m_view->at<std::uint8_t>(m_entry->data)[index] != 0U;
+
+}
+
+
+// vector<bool>: bit packed words, without copy
+auto BinaryView::VariableView::getWords() const -> Span<const BitVector::t_word>
+{
+
+    this->checkType(true, e_cppTypes::BOOL);
+
+    if (this->getVarType() != IVariable::e_varType::VECTOR)
+        throw SyntaxError("Binary Pepon: only vector<bool> values are bit packed");
+
+    return { m_view->at<BitVector::t_word>(m_entry->data), BitVector::wordCount(m_entry->count) };
+
+}
+
+
+// Containers of strings
+auto BinaryView::VariableView::getString(std::size_t index) const -> std::string_view
+{
+
+    this->checkType(true, e_cppTypes::STRING_UTF8);
+
+    if (index >= m_entry->count)
+        throw std::out_of_range("Binary Pepon: index out of range");
+
+    return m_view->getString(m_view->at<BinaryString>(m_entry->data)[index]);
+
+}
+
+
+// The value as a raw value: [image begin, end of its entry)
+auto BinaryView::VariableView::getRawValue() const noexcept -> std::string_view
+{
+    const auto* image = m_view->m_image.data();
+
+    return { image, static_cast<std::size_t>(reinterpret_cast<const char*>(m_entry + 1) - image) };
+}
+
+
+// Throws if the variable is not this kind of value
+void BinaryView::VariableView::checkType(bool container, e_cppTypes type) const
+{
+
+    const bool isContainer = this->getVarType() != IVariable::e_varType::SINGLE_VALUE;
+
+    if (isContainer != container || this->getCppType() != type)
+        throw SyntaxError("Binary Pepon: wrong type requested for " + std::string(this->getName()));
+
+}
+
+
+// ----------------------------------------------------------------------
+// GroupView
+// ----------------------------------------------------------------------
+BinaryView::GroupView::GroupView(const BinaryView& view, const BinaryGroup& entry) noexcept
+    : m_view(&view),
+      m_entry(&entry)
+{
+}
+
+
+auto BinaryView::GroupView::getName() const noexcept -> std::string_view
+{
+    return m_view->getString(m_entry->name);
+}
+
+
+// Variables, in file order
+auto BinaryView::GroupView::size() const noexcept -> std::size_t
+{
+    return m_entry->variableCount;
+}
+
+
+auto BinaryView::GroupView::operator[](std::size_t index) const noexcept -> VariableView
+{
+    return { *m_view, m_view->m_variables[m_entry->firstVariable + index] };
+}
+
+
+// Binary search
+auto BinaryView::GroupView::find(std::string_view name) const noexcept -> std::optional<VariableView>
+{
+
+    const auto* first = m_view->at<std::uint32_t>(m_entry->sortedVariables);
+    const auto* last  = first + m_entry->variableCount;
+
+    const auto it = std::lower_bound(first, last, name, [this](std::uint32_t index, std::string_view value)
+    {
+        return (*this)[index].getName() < value;
+    });
+
+    if (it == last || (*this)[*it].getName() != name)
+        return std::nullopt;
+
+    return (*this)[*it];
+
+}
+
+
+// Comments
+auto BinaryView::GroupView::getCommentCount() const noexcept -> std::size_t
+{
+    return m_entry->commentCount;
+}
+
+
+auto BinaryView::GroupView::getComment(std::size_t index) const noexcept -> std::string_view
+{
+    return m_view->getString(m_view->at<BinaryString>(m_entry->comments)[index]);
+}
+
+
+// ----------------------------------------------------------------------
+// BinaryView
+// ----------------------------------------------------------------------
+// Image already checked: only its payload is read (see readRawValue())
+BinaryView::BinaryView(std::string_view image, Checked) noexcept
+    : m_image(image)
+{
+}
+
+// ctor
+// Throws a SyntaxError if the image is not valid
+BinaryView::BinaryView(std::string_view image)
+    : m_image(image)
+{
+
+    if (reinterpret_cast<std::uintptr_t>(image.data()) % BinaryFormat::ALIGNMENT != 0U)
+        throw SyntaxError("Binary Pepon: image is not aligned");
+
+    if (image.size() < sizeof(BinaryHeader))
+        throw SyntaxError("Binary Pepon: image is too small");
+
+    m_header = this->at<BinaryHeader>(0U);
+
+    if (std::memcmp(m_header->magic, BinaryFormat::MAGIC.data(), sizeof(m_header->magic)) != 0)
+        throw SyntaxError("Binary Pepon: not a binary Pepon file");
+
+    if (m_header->version != BinaryFormat::VERSION)
+        throw SyntaxError("Binary Pepon: unsupported version");
+
+    if (m_header->endianness != BinaryFormat::ENDIANNESS)
+        throw SyntaxError("Binary Pepon: wrong endianness");
+
+    if (m_header->imageSize != image.size())
+        throw SyntaxError("Binary Pepon: truncated image");
+
+
+    // Tables
+    this->checkRange(m_header->groupTable, m_header->groupCount, sizeof(BinaryGroup), BinaryFormat::ALIGNMENT);
+    this->checkRange(m_header->variableTable, m_header->variableCount, sizeof(BinaryVariable), BinaryFormat::ALIGNMENT);
+
+    m_groups    = this->at<BinaryGroup>(m_header->groupTable);
+    m_variables = this->at<BinaryVariable>(m_header->variableTable);
+
+
+    // Groups
+    for (std::size_t i = 0U; i < m_header->groupCount; ++i)
+    {
+        const auto& group = m_groups[i];
+
+        this->checkString(group.name);
+
+        if (i > 0U && !(this->getString(m_groups[i - 1U].name) < this->getString(group.name)))
+            throw SyntaxError("Binary Pepon: groups are not sorted");
+
+        if (group.firstVariable > m_header->variableCount || group.variableCount > m_header->variableCount - group.firstVariable)
+            throw SyntaxError("Binary Pepon: invalid group");
+
+        this->checkRange(group.sortedVariables, group.variableCount, sizeof(std::uint32_t), alignof(std::uint32_t));
+
+        const auto* sorted = this->at<std::uint32_t>(group.sortedVariables);
+
+        for (std::size_t j = 0U; j < group.variableCount; ++j)
+            if (sorted[j] >= group.variableCount)
+                throw SyntaxError("Binary Pepon: invalid group");
+
+        this->checkRange(group.comments, group.commentCount, sizeof(BinaryString), alignof(BinaryString));
+
+        for (std::size_t j = 0U; j < group.commentCount; ++j)
+            this->checkString(this->at<BinaryString>(group.comments)[j]);
+    }
+
+
+    // Variables
+    for (std::size_t i = 0U; i < m_header->variableCount; ++i)
+        this->checkVariable(m_variables[i]);
+
+}
+
+
+// Groups, sorted by name
+auto BinaryView::size() const noexcept -> std::size_t
+{
+    return m_header->groupCount;
+}
+
+
+auto BinaryView::operator[](std::size_t index) const noexcept -> GroupView
+{
+    return { *this, m_groups[index] };
+}
+
+
+// Binary search
+auto BinaryView::findGroup(std::string_view name) const noexcept -> std::optional<GroupView>
+{
+
+    const auto* last = m_groups + m_header->groupCount;
+
+    const auto* it = std::lower_bound(m_groups, last, name, [this](const BinaryGroup& group, std::string_view value)
+    {
+        return this->getString(group.name) < value;
+    });
+
+    if (it == last || this->getString(it->name) != name)
+        return std::nullopt;
+
+    return GroupView(*this, *it);
+
+}
+
+
+auto BinaryView::getImage() const noexcept -> std::string_view
+{
+    return m_image;
+}
+
+
+// Checks that [offset, offset + count * size) is inside the image
+void BinaryView::checkRange(std::uint64_t offset, std::uint64_t count, std::uint64_t size, std::uint64_t alignment) const
+{
+
+    if (offset % alignment != 0U)
+        throw SyntaxError("Binary Pepon: misaligned data");
+
+    if (offset > m_image.size() || (size > 0U && count > (m_image.size() - offset) / size))
+        throw SyntaxError("Binary Pepon: data out of the image");
+
+}
+
+
+void BinaryView::checkString(const BinaryString& text) const
+{
+    this->checkRange(text.offset, text.size, 1U);
+}
+
+
+void BinaryView::checkVariable(const BinaryVariable& entry) const
+{
+
+    this->checkString(entry.name);
+
+    if (entry.varType > static_cast<std::uint8_t>(IVariable::e_varType::LIST) ||
+        entry.cppType == static_cast<std::uint8_t>(e_cppTypes::UNKNOWN)   ||
+        entry.cppType > static_cast<std::uint8_t>(e_cppTypes::STRING_UTF8))
+        throw SyntaxError("Binary Pepon: invalid type for " + std::string(this->getString(entry.name)));
+
+    const bool container = entry.varType != static_cast<std::uint8_t>(IVariable::e_varType::SINGLE_VALUE);
+
+    switch (static_cast<e_cppTypes>(entry.cppType))
+    {
+        case e_cppTypes::INT:
+        case e_cppTypes::UINT:
+        case e_cppTypes::FLOAT:
+            this->checkRange(entry.data, container ? entry.count : 1U, 4U, 4U);
+            break;
+
+        case e_cppTypes::DOUBLE:
+            this->checkRange(entry.data, container ? entry.count : 1U, 8U, 8U);
+            break;
+
+        case e_cppTypes::BOOL:
+            if (entry.varType == static_cast<std::uint8_t>(IVariable::e_varType::VECTOR))
+                this->checkRange(entry.data, BitVector::wordCount(entry.count), sizeof(BitVector::t_word), BinaryFormat::ALIGNMENT);
+            else
+                this->checkRange(entry.data, container ? entry.count : 1U, 1U);
+            break;
+
+        case e_cppTypes::STRING_UTF8:
+            if (!container)
+            {
+                this->checkRange(entry.data, entry.count, 1U);
+                break;
+            }
+
+            this->checkRange(entry.data, entry.count, sizeof(BinaryString), alignof(BinaryString));
+
+            for (std::size_t i = 0U; i < entry.count; ++i)
+                this->checkString(this->at<BinaryString>(entry.data)[i]);
+            break;
+
+        case e_cppTypes::UNKNOWN:
+            break;
+    }
+
+}
+
+
+auto BinaryView::getString(const BinaryString& text) const noexcept -> std::string_view
+{
+    return m_image.substr(text.offset, text.size);
+}
+
+} // pepon
@@ -0,0 +1,199 @@
+#ifndef BINARY_VIEW_HPP
+#define BINARY_VIEW_HPP
+
+#include <optional>
+#include <string_view>
+
+#include "BinaryFormat.hpp"
+#include "../Pepon.hpp"
+#include "../Utils/Span.hpp"
+#include "../Variables/IVariable.hpp"
+
+namespace pepon
+{
+
+// Zero copy, read only access to a binary Pepon image
+// The image is validated once by the ctor. It is not copied: it MUST outlive this view
+class BinaryView
+{
+
+    public:
+
+        // A variable of the image
+        class VariableView
+        {
+
+            public:
+
+                VariableView(const BinaryView& view, const BinaryVariable& entry) noexcept;
+
+                auto getName() const noexcept -> std::string_view;
+                auto getVarType() const noexcept -> IVariable::e_varType;
+                auto getCppType() const noexcept -> e_cppTypes;
+
+                // Number of elements (containers), or bytes (single strings)
+                auto size() const noexcept -> std::size_t;
+
+                // Single values: bool, int, uint, float, double or std::string_view
+                template <typename Type>
+                auto getValue() const -> Type;
+
+                // Containers of numbers, without copy
+                template <typename Type>
+                auto getArray() const -> Span<const Type>;
+
+                // Containers of bools and strings
+                auto getBool(std::size_t index) const -> bool;
+                // vector<bool>: bit packed words, without copy (see BitVector)
+                auto getWords() const -> Span<const BitVector::t_word>;
+                auto getString(std::size_t index) const -> std::string_view;
+
+                // The value as a raw value: [image begin, end of its entry) (see getRawEntry())
+                auto getRawValue() const noexcept -> std::string_view;
+
+
+            private:
+
+                // Throws if the variable is not this kind of value
+                void checkType(bool container, e_cppTypes type) const;
+
+            private:
+
+                const BinaryView* m_view;
+                const BinaryVariable* m_entry;
+
+        };
+
+
+        // A group of the image
+        class GroupView
+        {
+
+            public:
+
+                GroupView(const BinaryView& view, const BinaryGroup& entry) noexcept;
+
+                auto getName() const noexcept -> std::string_view;
+
+                // Variables, in file order
+                auto size() const noexcept -> std::size_t;
+                auto operator[](std::size_t index) const noexcept -> VariableView;
+
+                // Binary search
+                auto find(std::string_view name) const noexcept -> std::optional<VariableView>;
+
+                // Comments
+                auto getCommentCount() const noexcept -> std::size_t;
+                auto getComment(std::size_t index) const noexcept -> std::string_view;
+
+
+            private:
+
+                const BinaryView* m_view;
+                const BinaryGroup* m_entry;
+
+        };
+
+
+    public:
+
+        // ctor
+        // Throws a SyntaxError if the image is not valid
+        explicit BinaryView(std::string_view image);
+
+
+        // Groups, sorted by name
+        auto size() const noexcept -> std::size_t;
+        auto operator[](std::size_t index) const noexcept -> GroupView;
+
+        // Binary search
+        auto findGroup(std::string_view name) const noexcept -> std::optional<GroupView>;
+
+        auto getImage() const noexcept -> std::string_view;
+
+        // Calls reader(VariableView) with the variable of a raw value (see VariableView::getRawValue())
+        // The image was checked when the raw value was made: it is not checked again
+        template <typename Reader>
+        static decltype(auto) readRawValue(std::string_view raw, Reader&& reader);
+
+
+    private:
+
+        struct Checked {};
+
+        // Image already checked
+        BinaryView(std::string_view image, Checked) noexcept;
+
+        // Checks that [offset, offset + count * size) is inside the image
+        void checkRange(std::uint64_t offset, std::uint64_t count, std::uint64_t size, std::uint64_t alignment = 1U) const;
+        void checkString(const BinaryString& text) const;
+        void checkVariable(const BinaryVariable& entry) const;
+
+        // Access to the payload
+        template <typename Type>
+        auto at(std::uint64_t offset) const noexcept -> const Type*
+        {
+            return reinterpret_cast<const Type*>(m_image.data() + offset);
+        }
+
+        auto getString(const BinaryString& text) const noexcept -> std::string_view;
+
+
+    private:
+
+        std::string_view m_image;
+
+        const BinaryHeader*   m_header    = nullptr;
+        const BinaryGroup*    m_groups    = nullptr;
+        const BinaryVariable* m_variables = nullptr;
+
+};
+
+
+// Single values
+template <typename Type>
+auto BinaryView::VariableView::getValue() const -> Type
+{
+
+    this->checkType(false, getTypeEnum<Type>());
+
+    if constexpr (std::is_same_v<Type, std::string_view>)
+        return m_view->getString({ m_entry->data, m_entry->count });
+    else
+    if constexpr (std::is_same_v<Type, bool>)
+        return *m_view->at<std::uint8_t>(m_entry->data) != 0U;
+    else
+        return *m_view->at<Type>(m_entry->data);
+
+}
+
+
+// Containers of numbers, without copy
+template <typename Type>
+auto BinaryView::VariableView::getArray() const -> Span<const Type>
+{
+
+    static_assert(std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>, "Only numbers can be viewed as arrays");
+
+    this->checkType(true, getTypeEnum<Type>());
+
+    return { m_view->at<Type>(m_entry->data), m_entry->count };
+
+}
+
+
+// Calls reader(VariableView) with the variable of a raw value
+template <typename Reader>
+decltype(auto) BinaryView::readRawValue(std::string_view raw, Reader&& reader)
+{
+    // The payload is after the tables: the whole image
+    const auto& header = *reinterpret_cast<const BinaryHeader*>(raw.data());
+    const BinaryView view({ raw.data(), static_cast<std::size_t>(header.imageSize) }, Checked {});
+
+    return reader(VariableView(view, getRawEntry(raw)));
+}
+
+} // pepon
+
+
+#endif // BINARY_VIEW_HPP
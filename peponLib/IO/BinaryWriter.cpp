@@ -0,0 +1,236 @@
+#include <cstring>      // std::memcpy
+#include <algorithm>    // std::sort
+#include <type_traits>
+
+#include "BinaryWriter.hpp"
+#include "../Utils/Endian.hpp"
+
+namespace pepon
+{
+
+namespace
+{
+
+template <typename Type>
+constexpr bool isString = std::is_same_v<Type, std::string> || std::is_same_v<Type, std::string_view>;
+
+} // anonymous namespace
+
+
+// Binary image of these groups
+auto BinaryWriter::write(std::vector<const Group*> groups) -> std::string
+{
+
+    static_assert(sizeof(int) == 4U && sizeof(float) == 4U && sizeof(double) == 8U, "Unsupported platform");
+
+    if (!isLittleEndian())
+        throw SyntaxError("Binary Pepon files are only supported on little endian platforms");
+
+
+    // Groups are sorted by name, to find them quickly
+    std::sort(groups.begin(), groups.end(), [](const Group* a, const Group* b)
+    {
+        return a->getName() < b->getName();
+    });
+
+    std::size_t variableCount = 0U;
+
+    for (const auto* group : groups)
+        variableCount += group->size();
+
+
+    // Header and tables first. They are filled at the end
+    m_image.clear();
+    m_image.resize(sizeof(BinaryHeader));
+
+    std::vector<BinaryGroup>    groupTable(groups.size());
+    std::vector<BinaryVariable> variableTable(variableCount);
+
+    const auto groupTableOffset    = this->append(groupTable.data(), groupTable.size() * sizeof(BinaryGroup), BinaryFormat::ALIGNMENT);
+    const auto variableTableOffset = this->append(variableTable.data(), variableTable.size() * sizeof(BinaryVariable), BinaryFormat::ALIGNMENT);
+
+
+    // Payload
+    std::size_t variableIndex = 0U;
+
+    for (std::size_t groupIndex = 0U; groupIndex < groups.size(); ++groupIndex)
+    {
+
+        const auto& group = *groups[groupIndex];
+        auto& entry = groupTable[groupIndex];
+
+        entry.name = this->appendString(group.getName());
+
+        // Comments
+        std::vector<BinaryString> comments;
+
+        for (const auto& comment : group.getComments())
+            comments.push_back(this->appendString(comment));
+
+        entry.comments     = this->append(comments.data(), comments.size() * sizeof(BinaryString), BinaryFormat::ALIGNMENT);
+        entry.commentCount = comments.size();
+
+        // Variables, in file order
+        std::vector<std::string_view> names;
+        names.reserve(group.size());
+
+        entry.firstVariable = variableIndex;
+        entry.variableCount = group.size();
+
+        group.forEach([this, &names, &variableTable, &variableIndex](std::string_view name, const auto& value)
+        {
+            using t_value = std::decay_t<decltype(value)>;
+
+            auto& varEntry = variableTable[variableIndex++];
+
+            varEntry.name    = this->appendString(name);
+            varEntry.varType = static_cast<std::uint8_t>(ValueTraits<t_value>::getVarType());
+            varEntry.cppType = static_cast<std::uint8_t>(ValueTraits<t_value>::getCppType());
+
+            this->appendValue(value, varEntry);
+
+            names.push_back(name);
+        });
+
+        // Variables, sorted by name
+        std::vector<std::uint32_t> sorted(names.size());
+
+        for (std::uint32_t i = 0U; i < sorted.size(); ++i)
+            sorted[i] = i;
+
+        std::stable_sort(sorted.begin(), sorted.end(), [&names](std::uint32_t a, std::uint32_t b)
+        {
+            return names[a] < names[b];
+        });
+
+        entry.sortedVariables = this->append(sorted.data(), sorted.size() * sizeof(std::uint32_t), BinaryFormat::ALIGNMENT);
+
+    }
+
+    // Whole image size is aligned too
+    m_image.resize((m_image.size() + BinaryFormat::ALIGNMENT - 1U) & ~(BinaryFormat::ALIGNMENT - 1U), '\0');
+
+
+    // Now, fill the header and the tables
+    BinaryHeader header {};
+
+    std::memcpy(header.magic, BinaryFormat::MAGIC.data(), sizeof(header.magic));
+    header.version       = BinaryFormat::VERSION;
+    header.endianness    = BinaryFormat::ENDIANNESS;
+    header.imageSize     = m_image.size();
+    header.groupCount    = groupTable.size();
+    header.groupTable    = groupTableOffset;
+    header.variableCount = variableTable.size();
+    header.variableTable = variableTableOffset;
+
+    std::memcpy(m_image.data(), &header, sizeof(header));
+
+    if (!groupTable.empty())
+        std::memcpy(m_image.data() + groupTableOffset, groupTable.data(), groupTable.size() * sizeof(BinaryGroup));
+
+    if (!variableTable.empty())
+        std::memcpy(m_image.data() + variableTableOffset, variableTable.data(), variableTable.size() * sizeof(BinaryVariable));
+
+    return std::move(m_image);
+
+}
+
+
+// Appends raw bytes, with the given alignment. Returns their offset
+auto BinaryWriter::append(const void* data, std::size_t size, std::size_t alignment) -> std::uint64_t
+{
+
+    const auto offset = (m_image.size() + alignment - 1U) & ~(alignment - 1U);
+
+    m_image.resize(offset, '\0');
+
+    if (size > 0U)
+        m_image.append(static_cast<const char*>(data), size);
+
+    return offset;
+
+}
+
+
+// Appends text
+auto BinaryWriter::appendString(std::string_view text) -> BinaryString
+{
+    return { this->append(text.data(), text.size()), text.size() };
+}
+
+
+// Appends a value, and fills its entry
+template <typename Type>
+void BinaryWriter::appendValue(const Type& value, BinaryVariable& entry)
+{
+
+    // Single values
+    if constexpr (std::is_same_v<Type, bool>)
+    {
+        const std::uint8_t byte = value ? 1U : 0U;
+
+        entry.count = 1U;
+        entry.data  = this->append(&byte, 1U);
+    }
+    else
+    if constexpr (std::is_arithmetic_v<Type>)
+    {
+        entry.count = 1U;
+        entry.data  = this->append(&value, sizeof(value), BinaryFormat::ALIGNMENT);
+    }
+    else
+    if constexpr (isString<Type>)
+    {
+        const auto text = this->appendString(value);
+
+        entry.count = text.size;
+        entry.data  = text.offset;
+    }
+
+    // Containers
+    else
+    {
+        using t_element = typename Type::value_type;
+
+        entry.count = value.size();
+
+        if constexpr (std::is_same_v<Type, BitVector>)
+        {
+            const auto words = value.getWords();
+            entry.data = this->append(words.data(), words.size() * sizeof(BitVector::t_word), BinaryFormat::ALIGNMENT);
+        }
+        else
+        if constexpr (std::is_same_v<t_element, bool>)
+        {
+            std::vector<std::uint8_t> bytes(value.begin(), value.end());
+            entry.data = this->append(bytes.data(), bytes.size());
+        }
+        else
+        if constexpr (std::is_same_v<t_element, std::string>)
+        {
+            std::vector<BinaryString> texts;
+            texts.reserve(value.size());
+
+            for (const auto& text : value)
+                texts.push_back(this->appendString(text));
+
+            entry.data = this->append(texts.data(), texts.size() * sizeof(BinaryString), BinaryFormat::ALIGNMENT);
+        }
+        else
+        if constexpr (std::is_same_v<Type, std::vector<t_element>>)
+        {
+            // Contiguous: a single copy
+            entry.data = this->append(value.data(), value.size() * sizeof(t_element), BinaryFormat::ALIGNMENT);
+        }
+        else
+        {
+            entry.data = this->append(nullptr, 0U, BinaryFormat::ALIGNMENT);
+
+            for (const auto& element : value)
+                this->append(&element, sizeof(element));
+        }
+    }
+
+}
+
+} // pepon
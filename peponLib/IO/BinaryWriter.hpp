@@ -0,0 +1,43 @@
+#ifndef BINARY_WRITER_HPP
+#define BINARY_WRITER_HPP
+
+#include <string>
+#include <vector>
+
+#include "BinaryFormat.hpp"
+#include "../Variables/Group.hpp"
+
+namespace pepon
+{
+
+// Builds binary Pepon images (see BinaryFormat.hpp)
+class BinaryWriter
+{
+
+    public:
+
+        // Binary image of these groups
+        auto write(std::vector<const Group*> groups) -> std::string;
+
+
+    private:
+
+        // Appends raw bytes, with the given alignment. Returns their offset
+        auto append(const void* data, std::size_t size, std::size_t alignment = 1U) -> std::uint64_t;
+        // Appends text
+        auto appendString(std::string_view text) -> BinaryString;
+        // Appends a value, and fills its entry
+        template <typename Type>
+        void appendValue(const Type& value, BinaryVariable& entry);
+
+
+    private:
+
+        std::string m_image;
+
+};
+
+} // pepon
+
+
+#endif // BINARY_WRITER_HPP
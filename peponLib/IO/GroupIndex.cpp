@@ -0,0 +1,253 @@
+#include <fstream>
+#include <algorithm>    // std::sort, std::lower_bound, std::adjacent_find
+
+#include "GroupIndex.hpp"
+
+#include <myoga-utils/Utils/StringUtils.hpp>
+
+#include "../Parser/LineTokens.hpp"
+#include "../Parser/StructuralIndex.hpp"
+
+namespace pepon
+{
+
+namespace
+{
+
+struct IndexHeader
+{
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t groupCount;
+
+    std::uint64_t fileSize;
+    std::int64_t  fileTime;
+};
+
+struct IndexEntry
+{
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint32_t nameSize;
+};
+
+} // anonymous namespace
+
+
+// Index a Pepon text. Throws SyntaxError if a group is declared twice
+void GroupIndex::build(std::string_view text)
+{
+
+    m_ranges.clear();
+
+    StructuralIndex index;
+    index.build(text);
+
+    GroupScanner scanner;
+    std::string_view comment;
+
+    // Comments and empty lines just before a declaration belong to its group
+    std::size_t runBegin = 0U;
+    bool inRun = false;
+
+    for (const auto& lineInfo : index.getLines())
+    {
+
+        const IndexedLine indexed(text, lineInfo);
+
+        switch (scanner.scan(indexed, comment))
+        {
+            case GroupScanner::e_line::GROUP:
+            {
+                auto closeBracket = indexed.position(lineInfo.closeBracket);
+
+                if (closeBracket == std::string_view::npos)
+                    throw SyntaxError("Syntax error: expected \']\' after group name");
+
+                const auto offset = inRun ? runBegin : lineInfo.begin;
+
+                // The previous group ends here
+                if (!m_ranges.empty())
+                    m_ranges.back().size = offset - m_ranges.back().offset;
+
+                auto& range  = m_ranges.emplace_back();
+                range.name   = myoga::trimStr(indexed.line.substr(1, closeBracket - 1));
+                range.offset = offset;
+
+                inRun = false;
+                break;
+            }
+
+            case GroupScanner::e_line::COMMENT:
+                if (!inRun)
+                {
+                    runBegin = lineInfo.begin;
+                    inRun = true;
+                }
+                break;
+
+            case GroupScanner::e_line::OTHER:
+                if (indexed.line.empty())
+                {
+                    if (!inRun)
+                    {
+                        runBegin = lineInfo.begin;
+                        inRun = true;
+                    }
+                }
+                else
+                    inRun = false;
+                break;
+        }
+
+    }
+
+    // The last group ends with the text
+    if (!m_ranges.empty())
+        m_ranges.back().size = text.size() - m_ranges.back().offset;
+
+
+    std::sort(m_ranges.begin(), m_ranges.end(), [](const GroupRange& a, const GroupRange& b) { return a.name < b.name; });
+
+    const auto duplicated = std::adjacent_find(m_ranges.begin(), m_ranges.end(),
+                                               [](const GroupRange& a, const GroupRange& b) { return a.name == b.name; });
+
+    if (duplicated != m_ranges.end())
+        throw SyntaxError("Group [" + duplicated->name + "] is declared twice");
+
+}
+
+
+// Sidecar file of a text file with this status
+void GroupIndex::save(MappedFile::t_filePath indexFile, const FileStatus& status) const
+{
+
+    std::ofstream handle;
+
+#ifdef PEPON_USE_STL_PATH
+    handle.open(indexFile, std::ios_base::binary | std::ios_base::trunc);
+#else
+    handle.open(std::string(indexFile), std::ios_base::binary | std::ios_base::trunc);
+#endif
+
+    if (!handle)
+        throw SyntaxError("File cannot be opened!");
+
+    IndexHeader header {};
+    MAGIC.copy(header.magic, sizeof(header.magic));
+    header.version    = VERSION;
+    header.groupCount = static_cast<std::uint32_t>(m_ranges.size());
+    header.fileSize   = status.size;
+    header.fileTime   = status.modified;
+
+    handle.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto& range : m_ranges)
+    {
+        IndexEntry entry {};
+        entry.offset   = range.offset;
+        entry.size     = range.size;
+        entry.nameSize = static_cast<std::uint32_t>(range.name.size());
+
+        handle.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        handle.write(range.name.data(), static_cast<std::streamsize>(range.name.size()));
+    }
+
+    if (!handle)
+        throw SyntaxError("File cannot be written!");
+
+}
+
+// Throws SyntaxError if it cannot be read, or if it was made for another version of the text file
+void GroupIndex::load(MappedFile::t_filePath indexFile, const FileStatus& status)
+{
+
+    const MappedFile file(indexFile, MappedFile::e_mode::READ);
+    std::string_view image = file.view();
+
+    IndexHeader header;
+
+    if (image.size() < sizeof(header))
+        throw SyntaxError("Invalid group index: file too small");
+
+    std::copy(image.begin(), image.begin() + sizeof(header), reinterpret_cast<char*>(&header));
+    image.remove_prefix(sizeof(header));
+
+    if (std::string_view(header.magic, sizeof(header.magic)) != MAGIC || header.version != VERSION)
+        throw SyntaxError("Invalid group index: unknown format");
+
+    if (header.fileSize != status.size || header.fileTime != status.modified)
+        throw SyntaxError("Group index is stale: the file has changed since it was indexed");
+
+
+    // Every entry takes some room: a huge count is not even allocated
+    if (header.groupCount > image.size() / sizeof(IndexEntry))
+        throw SyntaxError("Invalid group index: truncated");
+
+    std::vector<GroupRange> ranges(header.groupCount);
+
+    for (auto& range : ranges)
+    {
+        IndexEntry entry;
+
+        if (image.size() < sizeof(entry))
+            throw SyntaxError("Invalid group index: truncated");
+
+        std::copy(image.begin(), image.begin() + sizeof(entry), reinterpret_cast<char*>(&entry));
+        image.remove_prefix(sizeof(entry));
+
+        if (image.size() < entry.nameSize || entry.offset > status.size || entry.size > status.size - entry.offset)
+            throw SyntaxError("Invalid group index: truncated");
+
+        range.name   = image.substr(0U, entry.nameSize);
+        range.offset = entry.offset;
+        range.size   = entry.size;
+
+        image.remove_prefix(entry.nameSize);
+    }
+
+
+    // find() is a binary search: names are sorted, and unique
+    for (std::size_t i = 1U; i < ranges.size(); ++i)
+    {
+        if (!(ranges[i - 1U].name < ranges[i].name))
+            throw SyntaxError("Invalid group index: groups are not sorted");
+    }
+
+    // A group is parsed alone: ranges never overlap
+    std::vector<const GroupRange*> byOffset;
+    byOffset.reserve(ranges.size());
+
+    for (const auto& range : ranges)
+        byOffset.push_back(&range);
+
+    std::sort(byOffset.begin(), byOffset.end(), [](const GroupRange* a, const GroupRange* b) { return a->offset < b->offset; });
+
+    for (std::size_t i = 1U; i < byOffset.size(); ++i)
+    {
+        if (byOffset[i - 1U]->offset + byOffset[i - 1U]->size > byOffset[i]->offset)
+            throw SyntaxError("Invalid group index: overlapping groups");
+    }
+
+    m_ranges = std::move(ranges);
+
+}
+
+
+// Getters:
+// Binary search. Returns nullptr if not found
+auto GroupIndex::find(std::string_view name) const noexcept -> const GroupRange*
+{
+    const auto itr = std::lower_bound(m_ranges.begin(), m_ranges.end(), name,
+                                      [](const GroupRange& range, std::string_view key) { return range.name < key; });
+
+    return (itr != m_ranges.end() && itr->name == name) ? &*itr : nullptr;
+}
+
+// Sorted by name
+auto GroupIndex::getRanges() const noexcept -> const std::vector<GroupRange>&
+{
+    return m_ranges;
+}
+
+} // pepon
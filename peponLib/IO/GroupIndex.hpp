@@ -0,0 +1,68 @@
+#ifndef GROUP_INDEX_HPP
+#define GROUP_INDEX_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include "MappedFile.hpp"
+
+namespace pepon
+{
+
+// Byte range of a group in a Pepon text file
+// It begins with the comments (and empty lines) just before its declaration,
+// and ends where the next group begins
+struct GroupRange
+{
+    std::string name;
+
+    std::uint64_t offset = 0U;
+    std::uint64_t size   = 0U;
+};
+
+
+// Byte offset of every group of a Pepon text file, saved in a small sidecar file
+// Any group can then be parsed alone, without reading the rest of the file
+// The sidecar remembers the size and modification time of its text file: a stale index is never used
+//
+// Sidecar layout (native byte order, it is a cache for this host):
+// [magic "PEPONIDX"][version][group count][file size][file time] then, for every group (sorted by name),
+// [offset][size][name size][name]
+class GroupIndex
+{
+
+    public:
+
+        static constexpr std::string_view MAGIC = "PEPONIDX";
+        static constexpr std::uint32_t VERSION  = 1U;
+
+    public:
+
+        // Index a Pepon text. Throws SyntaxError if a group is declared twice
+        void build(std::string_view text);
+
+        // Sidecar file of a text file with this status
+        void save(MappedFile::t_filePath indexFile, const FileStatus& status) const;
+        // Throws SyntaxError if it cannot be read, if it was made for another version of the text file,
+        // or if its groups are not sorted by name, or overlap
+        void load(MappedFile::t_filePath indexFile, const FileStatus& status);
+
+        // Getters:
+        // Binary search. Returns nullptr if not found
+        auto find(std::string_view name) const noexcept -> const GroupRange*;
+        // Sorted by name
+        auto getRanges() const noexcept -> const std::vector<GroupRange>&;
+
+
+    private:
+
+        std::vector<GroupRange> m_ranges;
+
+};
+
+} // pepon
+
+
+#endif // GROUP_INDEX_HPP
@@ -0,0 +1,297 @@
+#include <fstream>
+
+#include "MappedFile.hpp"
+
+// POSIX memory mapping
+#if defined(__unix__) || defined(__APPLE__)
+    #define PEPON_HAS_MMAP 1
+
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+namespace pepon
+{
+
+// ctor
+MappedFile::MappedFile(t_filePath fileName, e_mode mode)
+{
+
+#ifdef PEPON_HAS_MMAP
+
+    if (mode == e_mode::MEMORY_MAP)
+    {
+
+    #ifdef PEPON_USE_STL_PATH
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+    #else
+        const int fd = ::open(std::string(fileName).c_str(), O_RDONLY);
+    #endif
+
+        if (fd < 0)
+            throw SyntaxError("File cannot be opened!");
+
+        struct stat info;
+
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw SyntaxError("File cannot be opened!");
+        }
+
+        m_size = static_cast<std::size_t>(info.st_size);
+
+        // Empty files cannot be mapped, but they are still valid files
+        if (m_size == 0U)
+        {
+            ::close(fd);
+            return;
+        }
+
+        void* address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+
+        if (address != MAP_FAILED)
+        {
+            // We are going to read it from start to end
+            ::madvise(address, m_size, MADV_SEQUENTIAL);
+
+            m_data   = static_cast<const char*>(address);
+            m_mapped = true;
+
+            return;
+        }
+
+        // mmap() failed (special files, etc.), read it instead
+        m_size = 0U;
+
+    }
+
+#else
+
+    // No memory mapping in this platform
+    static_cast<void>(mode);
+
+#endif
+
+    this->readAll(fileName);
+
+}
+
+
+// Shared, read-only mapping of an open descriptor (shared memory, memfd...). The descriptor is not closed
+auto MappedFile::mapDescriptor(int fileDescriptor) -> MappedFile
+{
+
+    MappedFile file;
+
+#ifdef PEPON_HAS_MMAP
+
+    struct stat info;
+
+    if (::fstat(fileDescriptor, &info) != 0)
+        throw SyntaxError("File cannot be opened!");
+
+    // Empty: nothing to map
+    if (info.st_size == 0)
+        return file;
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+
+    // MAP_SHARED: every process reads the same physical pages
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+
+    if (address == MAP_FAILED)
+        throw SyntaxError("File cannot be mapped!");
+
+    file.m_data   = static_cast<const char*>(address);
+    file.m_size   = size;
+    file.m_mapped = true;
+
+#else
+
+    static_cast<void>(fileDescriptor);
+    throw SyntaxError("Memory mapping is not available in this platform");
+
+#endif
+
+    return file;
+
+}
+
+
+// Takes ownership of a buffer already read (ex: by AsyncFileReader)
+auto MappedFile::fromBuffer(std::unique_ptr<char[]> buffer, std::size_t size) noexcept -> MappedFile
+{
+
+    MappedFile file;
+
+    file.m_buffer = std::move(buffer);
+    file.m_data   = file.m_buffer.get();
+    file.m_size   = size;
+
+    return file;
+
+}
+
+
+// dtor
+MappedFile::~MappedFile()
+{
+    this->release();
+}
+
+
+// Move only
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(other.m_data),
+      m_size(other.m_size),
+      m_buffer(std::move(other.m_buffer)),
+      m_mapped(other.m_mapped)
+{
+    other.m_data   = nullptr;
+    other.m_size   = 0U;
+    other.m_mapped = false;
+}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile&
+{
+    if (this != &other)
+    {
+        this->release();
+
+        m_data   = other.m_data;
+        m_size   = other.m_size;
+        m_buffer = std::move(other.m_buffer);
+        m_mapped = other.m_mapped;
+
+        other.m_data   = nullptr;
+        other.m_size   = 0U;
+        other.m_mapped = false;
+    }
+
+    return *this;
+}
+
+
+// Getters:
+// Entire file content
+auto MappedFile::view() const noexcept -> std::string_view
+{
+    return { m_data, m_size };
+}
+
+auto MappedFile::size() const noexcept -> std::size_t
+{
+    return m_size;
+}
+
+// Is this file memory mapped?
+auto MappedFile::isMapped() const noexcept -> bool
+{
+    return m_mapped;
+}
+
+
+// Private functions:
+// Release the mapping/buffer
+void MappedFile::release() noexcept
+{
+
+#ifdef PEPON_HAS_MMAP
+    if (m_mapped)
+        ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+
+    m_buffer.reset();
+
+    m_data   = nullptr;
+    m_size   = 0U;
+    m_mapped = false;
+
+}
+
+
+// Read the whole file into m_buffer
+void MappedFile::readAll(const t_filePath& fileName)
+{
+
+    std::ifstream handle;
+
+#ifdef PEPON_USE_STL_PATH
+    handle.open(fileName, std::ios_base::binary | std::ios_base::ate);
+#else
+    handle.open(fileName.data(), std::ios_base::binary | std::ios_base::ate);
+#endif
+
+    if (!handle)
+        throw SyntaxError("File cannot be opened!");
+
+    // We opened it at the end
+    const auto fileSize = static_cast<std::size_t>(handle.tellg());
+    handle.seekg(0, std::ios_base::beg);
+
+    // One allocation, one read
+    m_buffer.reset(new char[fileSize]);
+
+    if (fileSize > 0U && !handle.read(m_buffer.get(), static_cast<std::streamsize>(fileSize)))
+        throw SyntaxError("File cannot be read!");
+
+    m_data = m_buffer.get();
+    m_size = fileSize;
+
+}
+
+
+// Size and last modification time of a file
+auto getFileStatus(MappedFile::t_filePath fileName) -> FileStatus
+{
+
+    FileStatus status;
+
+#ifdef PEPON_HAS_MMAP
+
+    struct stat info;
+
+#ifdef PEPON_USE_STL_PATH
+    if (::stat(fileName.c_str(), &info) != 0)
+#else
+    if (::stat(std::string(fileName).c_str(), &info) != 0)
+#endif
+        throw SyntaxError("File cannot be opened!");
+
+    status.size = static_cast<std::uint64_t>(info.st_size);
+
+#ifdef __APPLE__
+    status.modified = static_cast<std::int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+    status.modified = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+
+#else
+
+    // No modification time in this platform: the size only
+    std::ifstream handle;
+
+#ifdef PEPON_USE_STL_PATH
+    handle.open(fileName, std::ios_base::binary | std::ios_base::ate);
+#else
+    handle.open(std::string(fileName), std::ios_base::binary | std::ios_base::ate);
+#endif
+
+    if (!handle)
+        throw SyntaxError("File cannot be opened!");
+
+    status.size = static_cast<std::uint64_t>(handle.tellg());
+
+#endif
+
+    return status;
+
+}
+
+} // pepon
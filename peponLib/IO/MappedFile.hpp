@@ -0,0 +1,108 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <memory>
+#include <cstdint>
+#include <string_view>
+
+#include "../Pepon.hpp"
+#include "PeponConfig.hpp"
+
+#ifdef PEPON_USE_STL_PATH
+    #include <filesystem>
+#endif
+
+namespace pepon
+{
+
+// Read-only view of an entire file, kept in a single contiguous buffer
+// The file is memory mapped when possible, otherwise it is read with one single read call
+class MappedFile
+{
+
+    public:
+
+    #ifdef PEPON_USE_STL_PATH
+        using t_filePath = std::filesystem::path;
+    #else
+        using t_filePath = std::string_view;
+    #endif
+
+        enum class e_mode
+        {
+            MEMORY_MAP,     // mmap() the file (falls back to READ if not available)
+            READ            // One contiguous read into a heap buffer
+        };
+
+    public:
+
+        // ctor
+        MappedFile() = default;
+        MappedFile(t_filePath fileName, e_mode mode = e_mode::MEMORY_MAP);
+
+        // Shared, read-only mapping of an open descriptor (shared memory, memfd...). The descriptor is not closed
+        // Throws SyntaxError if it cannot be mapped
+        static auto mapDescriptor(int fileDescriptor) -> MappedFile;
+        // Takes ownership of a buffer already read (ex: by AsyncFileReader)
+        static auto fromBuffer(std::unique_ptr<char[]> buffer, std::size_t size) noexcept -> MappedFile;
+
+        // dtor
+        ~MappedFile();
+
+        // Move only
+        MappedFile(MappedFile&& other) noexcept;
+        auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+        MappedFile(const MappedFile&) = delete;
+        auto operator=(const MappedFile&) = delete;
+
+
+        // Getters:
+        // Entire file content
+        auto view() const noexcept -> std::string_view;
+        auto size() const noexcept -> std::size_t;
+
+        // Is this file memory mapped?
+        auto isMapped() const noexcept -> bool;
+
+
+    private:
+
+        // Release the mapping/buffer
+        void release() noexcept;
+
+        // Read the whole file into m_buffer
+        void readAll(const t_filePath& fileName);
+
+
+    private:
+
+        // File content
+        const char* m_data = nullptr;
+        std::size_t m_size = 0U;
+
+        // Only used in READ mode
+        std::unique_ptr<char[]> m_buffer;
+
+        bool m_mapped = false;
+
+};
+
+
+// Size and last modification time of a file
+struct FileStatus
+{
+    std::uint64_t size = 0U;
+    std::int64_t modified = 0;      // Nanoseconds since the epoch (0 if not available)
+
+    auto operator==(const FileStatus& other) const noexcept -> bool { return size == other.size && modified == other.modified; }
+    auto operator!=(const FileStatus& other) const noexcept -> bool { return !(*this == other); }
+};
+
+// Throws SyntaxError if the file cannot be found
+auto getFileStatus(MappedFile::t_filePath fileName) -> FileStatus;
+
+} // pepon
+
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,243 @@
+#include <cstdio>       // std::snprintf
+#include <clocale>      // std::localeconv
+#include <cstring>      // std::memcpy
+#include <charconv>     // std::to_chars
+#include <limits>
+#include <algorithm>    // std::max
+
+#include "OutputBuffer.hpp"
+
+// POSIX file descriptors
+#if defined(__unix__) || defined(__APPLE__)
+    #define PEPON_HAS_WRITE 1
+
+    #include <cerrno>
+    #include <unistd.h>
+#endif
+
+namespace pepon
+{
+
+namespace
+{
+
+// Longest formatted number: "-1.2345678901234567e-308"
+constexpr std::size_t MAX_NUMBER_SIZE = 32U;
+
+
+// Integers are always formatted by std::to_chars
+template <typename Type>
+auto formatNumber(char* first, Type value) -> char*
+{
+    return std::to_chars(first, first + MAX_NUMBER_SIZE, value).ptr;
+}
+
+
+#if !defined(__cpp_lib_to_chars) || __cpp_lib_to_chars < 201611L
+
+// No std::to_chars for floating point types:
+// enough digits to round-trip, with a '.' whatever the locale
+template <typename Type>
+auto formatFloatingPoint(char* first, Type value) -> char*
+{
+
+    const int size = std::snprintf(first, MAX_NUMBER_SIZE, "%.*g", std::numeric_limits<Type>::max_digits10, static_cast<double>(value));
+
+    const char decimalPoint = *std::localeconv()->decimal_point;
+
+    if (decimalPoint != '.')
+        std::replace(first, first + size, decimalPoint, '.');
+
+    return first + size;
+
+}
+
+template <>
+auto formatNumber<float>(char* first, float value) -> char*
+{
+    return formatFloatingPoint(first, value);
+}
+
+template <>
+auto formatNumber<double>(char* first, double value) -> char*
+{
+    return formatFloatingPoint(first, value);
+}
+
+#endif
+
+} // anonymous namespace
+
+
+// ctor
+OutputBuffer::OutputBuffer(std::ostream& out, std::size_t capacity)
+    : m_sink(e_sink::STREAM),
+      m_out(&out),
+      m_buffer(new char[std::max(capacity, MAX_NUMBER_SIZE)]),
+      m_capacity(std::max(capacity, MAX_NUMBER_SIZE))
+{
+}
+
+OutputBuffer::OutputBuffer(int fileDescriptor, std::size_t capacity)
+    : m_sink(e_sink::FILE_DESCRIPTOR),
+      m_fileDescriptor(fileDescriptor),
+      m_buffer(new char[std::max(capacity, MAX_NUMBER_SIZE)]),
+      m_capacity(std::max(capacity, MAX_NUMBER_SIZE))
+{
+#ifndef PEPON_HAS_WRITE
+    throw SyntaxError("File descriptors are not supported on this platform");
+#endif
+}
+
+OutputBuffer::OutputBuffer(std::string& memory, std::size_t capacity)
+    : m_sink(e_sink::MEMORY),
+      m_memory(&memory),
+      m_buffer(new char[std::max(capacity, MAX_NUMBER_SIZE)]),
+      m_capacity(std::max(capacity, MAX_NUMBER_SIZE))
+{
+}
+
+
+// dtor
+// Writes what is left (errors are ignored: call flush() to get them)
+OutputBuffer::~OutputBuffer()
+{
+    try
+    {
+        this->flush();
+    }
+    catch (...)
+    {
+    }
+}
+
+
+// Text
+void OutputBuffer::append(char character)
+{
+    *this->reserve(1U) = character;
+    ++m_size;
+}
+
+void OutputBuffer::append(std::string_view text)
+{
+
+    // Too big for the buffer: write it as is
+    if (text.size() > m_capacity)
+    {
+        this->flush();
+        this->writeToSink(text.data(), text.size());
+        return;
+    }
+
+    std::memcpy(this->reserve(text.size()), text.data(), text.size());
+    m_size += text.size();
+
+}
+
+
+// Values
+void OutputBuffer::appendValue(bool value)
+{
+    this->append(value ? std::string_view("true") : std::string_view("false"));
+}
+
+void OutputBuffer::appendValue(int value)
+{
+    char* first = this->reserve(MAX_NUMBER_SIZE);
+    m_size += static_cast<std::size_t>(formatNumber(first, value) - first);
+}
+
+void OutputBuffer::appendValue(uint value)
+{
+    char* first = this->reserve(MAX_NUMBER_SIZE);
+    m_size += static_cast<std::size_t>(formatNumber(first, value) - first);
+}
+
+void OutputBuffer::appendValue(float value)
+{
+    char* first = this->reserve(MAX_NUMBER_SIZE);
+    m_size += static_cast<std::size_t>(formatNumber(first, value) - first);
+}
+
+void OutputBuffer::appendValue(double value)
+{
+    char* first = this->reserve(MAX_NUMBER_SIZE);
+    m_size += static_cast<std::size_t>(formatNumber(first, value) - first);
+}
+
+void OutputBuffer::appendValue(std::string_view value)
+{
+    this->append(value);
+}
+
+
+// Writes the buffer to the sink
+// Throws SyntaxError if the sink fails
+void OutputBuffer::flush()
+{
+
+    if (m_size > 0U)
+    {
+        // Nothing is written twice, even if the sink fails
+        const auto size = m_size;
+        m_size = 0U;
+
+        this->writeToSink(m_buffer.get(), size);
+    }
+
+    if (m_sink == e_sink::STREAM && !*m_out)
+        throw SyntaxError("Output stream cannot be written!");
+
+}
+
+
+// Writes "size" bytes to the sink
+void OutputBuffer::writeToSink(const char* data, std::size_t size)
+{
+
+    switch (m_sink)
+    {
+        case e_sink::STREAM:
+            m_out->write(data, static_cast<std::streamsize>(size));
+            break;
+
+        case e_sink::MEMORY:
+            m_memory->append(data, size);
+            break;
+
+        case e_sink::FILE_DESCRIPTOR:
+#ifdef PEPON_HAS_WRITE
+            // write() can take several calls
+            while (size > 0U)
+            {
+                const auto written = ::write(m_fileDescriptor, data, size);
+
+                if (written < 0 && errno == EINTR)
+                    continue;
+
+                if (written <= 0)
+                    throw SyntaxError("Output file cannot be written!");
+
+                data += written;
+                size -= static_cast<std::size_t>(written);
+            }
+#endif
+            break;
+    }
+
+}
+
+
+// Flushes the buffer if "size" more bytes do not fit
+auto OutputBuffer::reserve(std::size_t size) -> char*
+{
+
+    if (m_capacity - m_size < size)
+        this->flush();
+
+    return m_buffer.get() + m_size;
+
+}
+
+} // pepon
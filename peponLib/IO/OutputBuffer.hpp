@@ -0,0 +1,89 @@
+#ifndef OUTPUT_BUFFER_HPP
+#define OUTPUT_BUFFER_HPP
+
+#include <memory>
+#include <string>
+#include <ostream>
+#include <string_view>
+
+#include "../Pepon.hpp"
+
+namespace pepon
+{
+
+// Formats text into a large buffer, written to the sink with a few large writes
+// Sinks: a std::ostream, a file descriptor (POSIX only) or a std::string
+// Numbers are formatted by std::to_chars (or equivalent):
+// locale-independent, and floating point values are written with their shortest round-trip representation
+class OutputBuffer
+{
+
+    public:
+
+        static constexpr std::size_t DEFAULT_CAPACITY = 1024U * 1024U;
+
+    public:
+
+        // ctor
+        explicit OutputBuffer(std::ostream& out, std::size_t capacity = DEFAULT_CAPACITY);
+        // The descriptor is not closed
+        explicit OutputBuffer(int fileDescriptor, std::size_t capacity = DEFAULT_CAPACITY);
+        // Text is appended to "memory"
+        explicit OutputBuffer(std::string& memory, std::size_t capacity = DEFAULT_CAPACITY);
+
+        // dtor
+        // Writes what is left (errors are ignored: call flush() to get them)
+        ~OutputBuffer();
+
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+
+        // Text
+        void append(char character);
+        void append(std::string_view text);
+
+        // Values
+        void appendValue(bool value);
+        void appendValue(int value);
+        void appendValue(uint value);
+        void appendValue(float value);
+        void appendValue(double value);
+        void appendValue(std::string_view value);
+
+        // Writes the buffer to the sink
+        // Throws SyntaxError if the sink fails
+        void flush();
+
+
+    private:
+
+        enum class e_sink { STREAM, FILE_DESCRIPTOR, MEMORY };
+
+    private:
+
+        // Writes "size" bytes to the sink
+        void writeToSink(const char* data, std::size_t size);
+
+        // Flushes the buffer if "size" more bytes do not fit
+        auto reserve(std::size_t size) -> char*;
+
+
+    private:
+
+        e_sink m_sink;
+
+        std::ostream* m_out    = nullptr;
+        int m_fileDescriptor   = -1;
+        std::string* m_memory  = nullptr;
+
+        std::unique_ptr<char[]> m_buffer;
+        std::size_t m_capacity;
+        std::size_t m_size = 0U;
+
+};
+
+} // pepon
+
+
+#endif // OUTPUT_BUFFER_HPP
@@ -0,0 +1,204 @@
+#include <cstdio>       // std::rename, std::remove
+#include <thread>
+#include <fstream>
+#include <utility>      // std::move
+#include <functional>   // std::hash
+#include <algorithm>    // std::copy
+
+#include "ParseCache.hpp"
+#include "BinaryFormat.hpp"
+#include "../Utils/Hash.hpp"
+
+// POSIX paths and directories
+#if defined(__unix__) || defined(__APPLE__)
+    #define PEPON_HAS_REALPATH 1
+
+    #include <climits>  // PATH_MAX
+    #include <cstdlib>  // realpath
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
+
+namespace pepon
+{
+
+namespace
+{
+
+struct CacheHeader
+{
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t pathSize;
+
+    std::uint64_t fileSize;
+    std::int64_t  fileTime;
+    std::uint64_t contentHash;
+};
+
+// The image begins after the header and the path, 8 bytes aligned
+auto getImageOffset(std::size_t pathSize) noexcept -> std::size_t
+{
+    const auto size = sizeof(CacheHeader) + pathSize;
+
+    return (size + BinaryFormat::ALIGNMENT - 1U) / BinaryFormat::ALIGNMENT * BinaryFormat::ALIGNMENT;
+}
+
+} // anonymous namespace
+
+
+// ctor. The directory is created if needed
+ParseCache::ParseCache(std::string directory)
+
+    : m_directory(std::move(directory))
+{
+
+#ifdef PEPON_HAS_REALPATH
+    // Already there (or not allowed): find() and store() will tell
+    ::mkdir(m_directory.c_str(), 0755);
+#endif
+
+}
+
+
+// Key of a text file with this status and content
+auto ParseCache::makeKey(MappedFile::t_filePath fileName, const FileStatus& status, std::string_view content) -> Key
+{
+
+    Key key;
+
+#ifdef PEPON_USE_STL_PATH
+    const std::string path = fileName.string();
+#else
+    const std::string path(fileName);
+#endif
+
+#ifdef PEPON_HAS_REALPATH
+    char canonical[PATH_MAX];
+
+    key.path = (::realpath(path.c_str(), canonical) != nullptr) ? std::string(canonical) : path;
+#else
+    key.path = path;
+#endif
+
+    key.status      = status;
+    key.contentHash = hashBytes(content);
+
+    return key;
+
+}
+
+
+// Entry of this key. Nothing if there is none, or it is stale
+auto ParseCache::find(const Key& key) const -> std::optional<Entry>
+{
+
+    Entry entry;
+
+    try
+    {
+        entry.file = MappedFile(this->getEntryPath(key));
+    }
+    catch (const SyntaxError&)
+    {
+        // No entry yet
+        return std::nullopt;
+    }
+
+    const auto view = entry.file.view();
+
+    CacheHeader header;
+
+    if (view.size() < sizeof(header))
+        return std::nullopt;
+
+    std::copy(view.begin(), view.begin() + sizeof(header), reinterpret_cast<char*>(&header));
+
+    entry.imageOffset = getImageOffset(header.pathSize);
+
+    // Stale (or another file with the same path hash)?
+    if (std::string_view(header.magic, sizeof(header.magic)) != MAGIC || header.version != VERSION ||
+        header.fileSize != key.status.size || header.fileTime != key.status.modified || header.contentHash != key.contentHash ||
+        view.size() < entry.imageOffset || view.substr(sizeof(header), header.pathSize) != key.path)
+    {
+        return std::nullopt;
+    }
+
+    return entry;
+
+}
+
+
+// Writes (or replaces) the entry of this key
+void ParseCache::store(const Key& key, std::string_view image) const
+{
+
+    const auto entryPath = this->getEntryPath(key);
+
+    // Unique per process and thread
+    std::uint64_t writer = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+#ifdef PEPON_HAS_REALPATH
+    writer ^= static_cast<std::uint64_t>(::getpid()) << 32U;
+#endif
+
+    const auto tempPath = entryPath + '.' + std::to_string(writer) + ".tmp";
+
+
+    CacheHeader header {};
+    MAGIC.copy(header.magic, sizeof(header.magic));
+    header.version     = VERSION;
+    header.pathSize    = static_cast<std::uint32_t>(key.path.size());
+    header.fileSize    = key.status.size;
+    header.fileTime    = key.status.modified;
+    header.contentHash = key.contentHash;
+
+    const std::string padding(getImageOffset(key.path.size()) - sizeof(header) - key.path.size(), '\0');
+
+    {
+        std::ofstream handle(tempPath, std::ios_base::binary | std::ios_base::trunc);
+
+        if (!handle)
+            throw SyntaxError("File cannot be opened!");
+
+        handle.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        handle.write(key.path.data(), static_cast<std::streamsize>(key.path.size()));
+        handle.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        handle.write(image.data(), static_cast<std::streamsize>(image.size()));
+
+        if (!handle.flush())
+        {
+            handle.close();
+            std::remove(tempPath.c_str());
+
+            throw SyntaxError("File cannot be written!");
+        }
+    }
+
+    if (std::rename(tempPath.c_str(), entryPath.c_str()) != 0)
+    {
+        std::remove(tempPath.c_str());
+        throw SyntaxError("File cannot be written!");
+    }
+
+}
+
+
+// Entry file of a key
+auto ParseCache::getEntryPath(const Key& key) const -> std::string
+{
+
+    static constexpr char DIGITS[] = "0123456789abcdef";
+
+    auto hash = hashBytes(key.path);
+
+    std::string name(16U, '0');
+
+    for (auto itr = name.rbegin(); itr != name.rend(); ++itr, hash >>= 4U)
+        *itr = DIGITS[hash & 0xFU];
+
+    return m_directory + '/' + name + ".pbin";
+
+}
+
+} // pepon
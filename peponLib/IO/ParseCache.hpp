@@ -0,0 +1,76 @@
+#ifndef PARSE_CACHE_HPP
+#define PARSE_CACHE_HPP
+
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "MappedFile.hpp"
+
+namespace pepon
+{
+
+// Directory of pre parsed binary images (see IO/BinaryFormat.hpp) of Pepon text files,
+// shared by every process of a host: the first one parses a file, the others map its image
+// An entry is keyed by the canonical path of its text file, its size, its modification time and a hash of its content.
+// Any change makes it stale, and it is written again after the next parse
+//
+// Entry layout (native byte order, it is a cache for this host):
+// [magic "PEPONCAC"][version][path size][file size][file time][content hash][canonical path][padding][binary image]
+class ParseCache
+{
+
+    public:
+
+        static constexpr std::string_view MAGIC = "PEPONCAC";
+        static constexpr std::uint32_t VERSION  = 1U;
+
+        // What an entry must match
+        struct Key
+        {
+            std::string path;               // Canonical path
+            FileStatus status;
+            std::uint64_t contentHash = 0U;
+        };
+
+        // A valid entry. Its image begins at "imageOffset" (8 bytes aligned)
+        struct Entry
+        {
+            MappedFile file;
+            std::size_t imageOffset = 0U;
+        };
+
+    public:
+
+        // ctor. The directory is created if needed
+        explicit ParseCache(std::string directory);
+
+        // Key of a text file with this status and content
+        static auto makeKey(MappedFile::t_filePath fileName, const FileStatus& status, std::string_view content) -> Key;
+
+        // Entry of this key. Nothing if there is none, or it is stale
+        auto find(const Key& key) const -> std::optional<Entry>;
+
+        // Writes (or replaces) the entry of this key
+        // Written to a temporary file first, then renamed: readers never see a partial entry
+        // Throws SyntaxError if it cannot be written
+        void store(const Key& key, std::string_view image) const;
+
+
+    private:
+
+        // Entry file of a key
+        auto getEntryPath(const Key& key) const -> std::string;
+
+
+    private:
+
+        std::string m_directory;
+
+};
+
+} // pepon
+
+
+#endif // PARSE_CACHE_HPP
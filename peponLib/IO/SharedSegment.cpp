@@ -0,0 +1,191 @@
+#include <atomic>       // std::atomic_thread_fence
+#include <string>
+#include <algorithm>    // std::min, std::copy
+
+#include "SharedSegment.hpp"
+#include "BinaryFormat.hpp"
+
+// POSIX shared memory
+#if defined(__unix__) || defined(__APPLE__)
+    #define PEPON_HAS_SHM 1
+
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+// Linux memfds, sealed read-only
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+    #define PEPON_HAS_MEMFD 1
+#endif
+
+namespace pepon
+{
+
+// Publish an image as a named segment
+void SharedSegment::create(std::string_view name, std::string_view image)
+{
+
+#ifdef PEPON_HAS_SHM
+
+    const std::string segmentName(name);
+
+    // A new object: processes attached to the previous one are not disturbed
+    ::shm_unlink(segmentName.c_str());
+
+    const int fd = ::shm_open(segmentName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+    if (fd < 0)
+        throw SyntaxError("Shared memory segment \'" + segmentName + "\' cannot be created");
+
+    try
+    {
+        writeImage(fd, image);
+    }
+    catch (...)
+    {
+        ::close(fd);
+        ::shm_unlink(segmentName.c_str());
+        throw;
+    }
+
+    ::close(fd);
+
+#else
+
+    static_cast<void>(name);
+    static_cast<void>(image);
+    throw SyntaxError("Shared memory is not available in this platform");
+
+#endif
+
+}
+
+// Unlink a named segment. Attached processes keep their mapping
+void SharedSegment::remove(std::string_view name)
+{
+
+#ifdef PEPON_HAS_SHM
+    ::shm_unlink(std::string(name).c_str());
+#else
+    static_cast<void>(name);
+#endif
+
+}
+
+
+// Publish an image as a sealed memfd (Linux). Returns its descriptor: the caller owns it
+auto SharedSegment::createAnonymous(std::string_view image) -> int
+{
+
+#ifdef PEPON_HAS_MEMFD
+
+    // Not MFD_CLOEXEC: child processes inherit it
+    const int fd = ::memfd_create("pepon", MFD_ALLOW_SEALING);
+
+    if (fd < 0)
+        throw SyntaxError("Shared memory segment cannot be created");
+
+    try
+    {
+        writeImage(fd, image);
+
+        // Nobody can change it anymore: readers can trust it
+        if (::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0)
+            throw SyntaxError("Shared memory segment cannot be sealed");
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+
+    return fd;
+
+#else
+
+    static_cast<void>(image);
+    throw SyntaxError("Anonymous shared memory (memfd) is not available in this platform");
+
+#endif
+
+}
+
+
+// Read-only mapping of a named segment
+auto SharedSegment::attach(std::string_view name) -> MappedFile
+{
+
+#ifdef PEPON_HAS_SHM
+
+    const std::string segmentName(name);
+
+    const int fd = ::shm_open(segmentName.c_str(), O_RDONLY, 0);
+
+    if (fd < 0)
+        throw SyntaxError("Shared memory segment \'" + segmentName + "\' not found");
+
+    // The mapping keeps its own reference to the segment
+    try
+    {
+        auto file = MappedFile::mapDescriptor(fd);
+        ::close(fd);
+
+        return file;
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+
+#else
+
+    static_cast<void>(name);
+    throw SyntaxError("Shared memory is not available in this platform");
+
+#endif
+
+}
+
+// Read-only mapping of a descriptor (ex: an inherited memfd). The descriptor is not closed
+auto SharedSegment::attach(int fileDescriptor) -> MappedFile
+{
+    return MappedFile::mapDescriptor(fileDescriptor);
+}
+
+
+// Writes the whole image, header last
+void SharedSegment::writeImage([[maybe_unused]] int fileDescriptor, [[maybe_unused]] std::string_view image)
+{
+
+#ifdef PEPON_HAS_SHM
+
+    if (::ftruncate(fileDescriptor, static_cast<off_t>(image.size())) != 0)
+        throw SyntaxError("Shared memory segment cannot be resized");
+
+    if (image.empty())
+        return;
+
+    // Written through a mapping: write() is not supported by every shared memory implementation
+    void* address = ::mmap(nullptr, image.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+
+    if (address == MAP_FAILED)
+        throw SyntaxError("Shared memory segment cannot be written");
+
+    auto* data = static_cast<char*>(address);
+    const auto headerSize = std::min(image.size(), sizeof(BinaryHeader));
+
+    std::copy(image.begin() + headerSize, image.end(), data + headerSize);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::copy(image.begin(), image.begin() + headerSize, data);
+
+    // Sealing requires no writable mapping
+    ::munmap(address, image.size());
+
+#endif
+
+}
+
+} // pepon
@@ -0,0 +1,47 @@
+#ifndef SHARED_SEGMENT_HPP
+#define SHARED_SEGMENT_HPP
+
+#include <string_view>
+
+#include "MappedFile.hpp"
+
+namespace pepon
+{
+
+// Binary Pepon images (see IO/BinaryFormat.hpp) in shared memory, attached read-only by every process of a host
+// Images only hold offsets, so each process maps them anywhere: nothing is parsed or relocated
+// Segments are either named POSIX shared memory objects ("/name", see shm_open), or Linux memfds
+// (anonymous, sealed read-only, shared by inheriting or sending their descriptor)
+// Throws SyntaxError when shared memory is not available in this platform
+class SharedSegment
+{
+
+    public:
+
+        // Publish an image as a named segment. A previous segment with that name is unlinked first:
+        // processes still attached to it keep their mapping
+        // The header is written last, so a process attaching too early gets a SyntaxError, never a partial image
+        static void create(std::string_view name, std::string_view image);
+        // Unlink a named segment. Attached processes keep their mapping
+        static void remove(std::string_view name);
+
+        // Publish an image as a sealed memfd (Linux). Returns its descriptor: the caller owns it
+        static auto createAnonymous(std::string_view image) -> int;
+
+        // Read-only mapping of a named segment
+        static auto attach(std::string_view name) -> MappedFile;
+        // Read-only mapping of a descriptor (ex: an inherited memfd). The descriptor is not closed
+        static auto attach(int fileDescriptor) -> MappedFile;
+
+
+    private:
+
+        // Writes the whole image, header last
+        static void writeImage(int fileDescriptor, std::string_view image);
+
+};
+
+} // pepon
+
+
+#endif // SHARED_SEGMENT_HPP
@@ -0,0 +1,88 @@
+#ifndef VALUE_WRITER_HPP
+#define VALUE_WRITER_HPP
+
+#include <iterator>     // std::begin
+#include <string_view>
+#include <type_traits>
+
+#include "../Pepon.hpp"
+#include "OutputBuffer.hpp"
+
+namespace pepon
+{
+
+// Text format of every value (same as the print() functions)
+
+// Single value: "name : type = value"
+// Strings are always between double quotation marks: "name : string = \"value\""
+template <typename Type>
+void writeSingleValue(std::string_view name, const Type& value, const PeponQuotes& quotes, OutputBuffer& out)
+{
+
+    out.append(name);
+    out.append(" : ");
+    out.append(getTypeName<Type>());
+    out.append(" = ");
+
+    if constexpr (std::is_same_v<Type, std::string> || std::is_same_v<Type, std::string_view>)
+    {
+        out.append('"');
+        out.append(value);
+        out.append("\"\n");
+    }
+    else
+    {
+        if (quotes.useQuotes)
+            out.append(quotes.quotesChar);
+
+        out.appendValue(value);
+
+        if (quotes.useQuotes)
+            out.append(quotes.quotesChar);
+
+        out.append('\n');
+    }
+
+}
+
+
+// Container: "name : container<type> = { values }"
+template <typename Range>
+void writeContainerValues(std::string_view name, std::string_view containerName, const Range& values, const PeponQuotes& quotes, OutputBuffer& out)
+{
+
+    using t_element = std::decay_t<decltype(*std::begin(values))>;
+
+    out.append(name);
+    out.append(" : ");
+    out.append(containerName);
+    out.append('<');
+    out.append(getTypeName<t_element>());
+    out.append("> = { ");
+
+    bool first = true;
+
+    for (const auto& elem : values)
+    {
+        if (!first)
+            out.append(", ");
+
+        if (quotes.useQuotes)
+            out.append(quotes.quotesChar);
+
+        out.appendValue(elem);
+
+        if (quotes.useQuotes)
+            out.append(quotes.quotesChar);
+
+        first = false;
+    }
+
+    out.append(" }\n");
+
+}
+
+} // pepon
+
+
+#endif // VALUE_WRITER_HPP
@@ -0,0 +1,109 @@
+#include <cstring>      // std::memcpy
+#include <algorithm>    // std::min, std::max
+#include <iterator>     // std::make_move_iterator
+
+#include "TextArena.hpp"
+
+namespace pepon
+{
+
+// Copy text into the arena. Returns a view of the copy
+auto TextArena::store(std::string_view text) -> std::string_view
+{
+
+    if (text.empty())
+        return {};
+
+    char* dest = this->allocate(text.size());
+    std::memcpy(dest, text.data(), text.size());
+
+    return { dest, text.size() };
+
+}
+
+
+// Takes ownership of a loaded file. Returns a view of its content
+auto TextArena::adopt(MappedFile file) -> std::string_view
+{
+
+    m_size += file.size();
+
+    // Mapped memory (or its read buffer) does not move with the MappedFile object
+    m_files.push_back(std::move(file));
+
+    return m_files.back().view();
+
+}
+
+
+// Takes everything another arena owns. Views into it stay valid
+void TextArena::merge(TextArena other)
+{
+
+    // Blocks and mapped memory do not move with their owners
+    m_blocks.insert(m_blocks.end(), std::make_move_iterator(other.m_blocks.begin()), std::make_move_iterator(other.m_blocks.end()));
+    m_files.insert(m_files.end(), std::make_move_iterator(other.m_files.begin()), std::make_move_iterator(other.m_files.end()));
+
+    m_size += other.m_size;
+
+    other.clear();
+
+}
+
+
+// Total bytes owned (copied text + adopted files)
+auto TextArena::size() const noexcept -> std::size_t
+{
+    return m_size;
+}
+
+
+// Releases everything. All views are invalidated!
+void TextArena::clear() noexcept
+{
+    m_blocks.clear();
+    m_files.clear();
+
+    m_head      = nullptr;
+    m_available = 0U;
+    m_blockSize = 0U;
+    m_size      = 0U;
+}
+
+
+// Get room for "size" characters, to be written by the caller
+auto TextArena::allocate(std::size_t size) -> char*
+{
+
+    // Big requests get their own block,
+    // so the current one can still be used
+    if (size > BLOCK_SIZE / 4U)
+    {
+        m_blocks.push_back(std::unique_ptr<char[]>(new char[size]));
+        m_size += size;
+
+        return m_blocks.back().get();
+    }
+
+    // Need a new block?
+    if (size > m_available)
+    {
+        m_blockSize = std::min(std::max({ m_blockSize * 2U, MIN_BLOCK_SIZE, size }), BLOCK_SIZE);
+
+        m_blocks.push_back(std::unique_ptr<char[]>(new char[m_blockSize]));
+
+        m_head      = m_blocks.back().get();
+        m_available = m_blockSize;
+    }
+
+    char* result = m_head;
+
+    m_head      += size;
+    m_available -= size;
+    m_size      += size;
+
+    return result;
+
+}
+
+} // pepon
@@ -0,0 +1,77 @@
+#ifndef TEXT_ARENA_HPP
+#define TEXT_ARENA_HPP
+
+#include <memory>
+#include <vector>
+#include <string_view>
+
+#include "../IO/MappedFile.hpp"
+
+namespace pepon
+{
+
+// Owns parsed text: names, comments and string values are views into it
+// Memory is handed out from big blocks, and it's never moved or released
+// until the arena dies, so every view stays valid for the arena lifetime
+class TextArena
+{
+
+    public:
+
+        // ctor
+        TextArena() = default;
+
+        // Move only. Moving an arena does not move its text
+        TextArena(TextArena&&) noexcept = default;
+        auto operator=(TextArena&&) noexcept -> TextArena& = default;
+
+        TextArena(const TextArena&) = delete;
+        auto operator=(const TextArena&) = delete;
+
+
+        // Copy text into the arena. Returns a view of the copy
+        auto store(std::string_view text) -> std::string_view;
+
+        // Get room for "size" characters, to be written by the caller
+        auto allocate(std::size_t size) -> char*;
+
+        // Takes ownership of a loaded file. Returns a view of its content
+        auto adopt(MappedFile file) -> std::string_view;
+
+        // Takes everything another arena owns. Views into it stay valid
+        void merge(TextArena other);
+
+        // Total bytes owned (copied text + adopted files)
+        auto size() const noexcept -> std::size_t;
+
+        // Releases everything. All views are invalidated!
+        void clear() noexcept;
+
+
+    private:
+
+        // Block sizes: the first blocks are small (most groups store little text),
+        // then each new block doubles, up to BLOCK_SIZE
+        static constexpr std::size_t MIN_BLOCK_SIZE = 256U;
+        static constexpr std::size_t BLOCK_SIZE     = 16U * 1024U;
+
+        // Memory blocks
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+
+        // Current block status
+        char*       m_head      = nullptr;
+        std::size_t m_available = 0U;
+        std::size_t m_blockSize = 0U;
+
+        // Adopted files
+        std::vector<MappedFile> m_files;
+
+        // Statistics
+        std::size_t m_size = 0U;
+
+};
+
+} // pepon
+
+
+#endif // TEXT_ARENA_HPP
@@ -0,0 +1,308 @@
+#include <array>
+#include <algorithm>    // std::min
+#include <cstdint>
+
+#include "BlobCodec.hpp"
+
+namespace pepon
+{
+
+namespace
+{
+
+// Lookup tables: one entry per character
+constexpr unsigned char INVALID = 0xFFU;
+constexpr unsigned char SPACE   = 0xFEU;
+constexpr unsigned char PADDING = 0xFDU;
+
+constexpr std::string_view BASE64_DIGITS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Characters that are ignored
+constexpr auto withSpaces(std::array<unsigned char, 256U> table) -> std::array<unsigned char, 256U>
+{
+    table[' ']  = SPACE;
+    table['\t'] = SPACE;
+    table['\r'] = SPACE;
+    table['\n'] = SPACE;
+
+    return table;
+}
+
+constexpr auto BASE64_TABLE = []
+{
+    std::array<unsigned char, 256U> table {};
+
+    for (auto& entry : table)
+        entry = INVALID;
+
+    for (std::size_t i = 0U; i < BASE64_DIGITS.size(); ++i)
+        table[static_cast<unsigned char>(BASE64_DIGITS[i])] = static_cast<unsigned char>(i);
+
+    table['='] = PADDING;
+
+    return withSpaces(table);
+}();
+
+constexpr auto HEX_TABLE = []
+{
+    std::array<unsigned char, 256U> table {};
+
+    for (auto& entry : table)
+        entry = INVALID;
+
+    for (unsigned i = 0U; i < 10U; ++i)
+        table['0' + i] = static_cast<unsigned char>(i);
+
+    for (unsigned i = 0U; i < 6U; ++i)
+    {
+        table['a' + i] = static_cast<unsigned char>(10U + i);
+        table['A' + i] = static_cast<unsigned char>(10U + i);
+    }
+
+    return withSpaces(table);
+}();
+
+
+[[noreturn]] void invalidBlob(std::string_view encoding, unsigned char character)
+{
+    throw SyntaxError("Invalid character \'" + std::string(1U, static_cast<char>(character)) + "\' in " + std::string(encoding) + " literal");
+}
+
+
+auto decodeBase64(std::string_view text, unsigned char* dest) -> std::size_t
+{
+
+    const auto* in  = reinterpret_cast<const unsigned char*>(text.data());
+    const auto* end = in + text.size();
+    auto* out = dest;
+
+    // Digits of an incomplete group of 4
+    std::uint32_t bits  = 0U;
+    unsigned      count = 0U;
+
+    while (in < end)
+    {
+
+        // Fast path: 4 digits -> 3 bytes
+        if (count == 0U && end - in >= 4)
+        {
+            const std::uint32_t a = BASE64_TABLE[in[0]];
+            const std::uint32_t b = BASE64_TABLE[in[1]];
+            const std::uint32_t c = BASE64_TABLE[in[2]];
+            const std::uint32_t d = BASE64_TABLE[in[3]];
+
+            if ((a | b | c | d) < 64U)
+            {
+                const auto value = (a << 18U) | (b << 12U) | (c << 6U) | d;
+
+                out[0] = static_cast<unsigned char>(value >> 16U);
+                out[1] = static_cast<unsigned char>(value >> 8U);
+                out[2] = static_cast<unsigned char>(value);
+
+                out += 3;
+                in  += 4;
+                continue;
+            }
+        }
+
+        // Slow path: whitespace, padding, or a group split by whitespace
+        const auto digit = BASE64_TABLE[*in];
+
+        if (digit < 64U)
+        {
+            bits = (bits << 6U) | digit;
+
+            if (++count == 4U)
+            {
+                out[0] = static_cast<unsigned char>(bits >> 16U);
+                out[1] = static_cast<unsigned char>(bits >> 8U);
+                out[2] = static_cast<unsigned char>(bits);
+
+                out  += 3;
+                bits  = 0U;
+                count = 0U;
+            }
+        }
+        else
+        if (digit == PADDING)
+            break;
+        else
+        if (digit != SPACE)
+            invalidBlob("base64", *in);
+
+        ++in;
+
+    }
+
+
+    // Only padding and whitespace after the padding
+    for (; in < end; ++in)
+    {
+        if (BASE64_TABLE[*in] != PADDING && BASE64_TABLE[*in] != SPACE)
+            invalidBlob("base64", *in);
+    }
+
+    // Last incomplete group
+    switch (count)
+    {
+        case 0U:
+            break;
+
+        case 2U:
+            *out++ = static_cast<unsigned char>(bits >> 4U);
+            break;
+
+        case 3U:
+            *out++ = static_cast<unsigned char>(bits >> 10U);
+            *out++ = static_cast<unsigned char>(bits >> 2U);
+            break;
+
+        default:
+            throw SyntaxError("Truncated base64 literal");
+    }
+
+    return static_cast<std::size_t>(out - dest);
+
+}
+
+
+auto decodeHex(std::string_view text, unsigned char* dest) -> std::size_t
+{
+
+    const auto* in  = reinterpret_cast<const unsigned char*>(text.data());
+    const auto* end = in + text.size();
+    auto* out = dest;
+
+    while (in < end)
+    {
+
+        // Fast path: 2 digits -> 1 byte
+        if (end - in >= 2)
+        {
+            const unsigned high = HEX_TABLE[in[0]];
+            const unsigned low  = HEX_TABLE[in[1]];
+
+            if ((high | low) < 16U)
+            {
+                *out++ = static_cast<unsigned char>((high << 4U) | low);
+                in += 2;
+                continue;
+            }
+        }
+
+        // Whitespace
+        if (HEX_TABLE[*in] != SPACE)
+        {
+            if (HEX_TABLE[*in] < 16U)
+                throw SyntaxError("Hexadecimal literal with an odd number of digits");
+
+            invalidBlob("hexadecimal", *in);
+        }
+
+        ++in;
+
+    }
+
+    return static_cast<std::size_t>(out - dest);
+
+}
+
+} // anonymous namespace
+
+
+// Encoding of a container literal, from the text between '=' and '{' (trimmed)
+auto getBlobEncoding(std::string_view prefix) noexcept -> e_blobEncoding
+{
+    if (prefix == "b64")
+        return e_blobEncoding::BASE64;
+
+    if (prefix == "hex")
+        return e_blobEncoding::HEX;
+
+    return e_blobEncoding::NONE;
+}
+
+// Upper bound of the number of decoded bytes
+auto getMaxBlobSize(std::string_view text, e_blobEncoding encoding) noexcept -> std::size_t
+{
+    switch (encoding)
+    {
+        case e_blobEncoding::BASE64:
+            return (text.size() / 4U + 1U) * 3U;
+
+        case e_blobEncoding::HEX:
+            return text.size() / 2U + 1U;
+
+        case e_blobEncoding::NONE:
+            break;
+    }
+
+    return 0U;
+}
+
+// Decodes the text into "dest"
+auto decodeBlob(std::string_view text, e_blobEncoding encoding, unsigned char* dest) -> std::size_t
+{
+    switch (encoding)
+    {
+        case e_blobEncoding::BASE64:
+            return decodeBase64(text, dest);
+
+        case e_blobEncoding::HEX:
+            return decodeHex(text, dest);
+
+        case e_blobEncoding::NONE:
+            break;
+    }
+
+    throw SyntaxError("Not a blob literal");
+}
+
+// Writes "size" bytes, base64 encoded
+void encodeBase64(const unsigned char* data, std::size_t size, OutputBuffer& out)
+{
+
+    // Encoded by chunks of 3 KiB -> 4 KiB of text
+    constexpr std::size_t CHUNK_SIZE = 3U * 1024U;
+
+    char text[CHUNK_SIZE / 3U * 4U];
+
+    while (size >= 3U)
+    {
+        const auto chunk = std::min(size - size % 3U, CHUNK_SIZE);
+        auto* digit = text;
+
+        for (std::size_t i = 0U; i < chunk; i += 3U)
+        {
+            const std::uint32_t value = (std::uint32_t(data[i]) << 16U) | (std::uint32_t(data[i + 1U]) << 8U) | data[i + 2U];
+
+            digit[0] = BASE64_DIGITS[(value >> 18U) & 0x3FU];
+            digit[1] = BASE64_DIGITS[(value >> 12U) & 0x3FU];
+            digit[2] = BASE64_DIGITS[(value >> 6U) & 0x3FU];
+            digit[3] = BASE64_DIGITS[value & 0x3FU];
+
+            digit += 4;
+        }
+
+        out.append(std::string_view(text, static_cast<std::size_t>(digit - text)));
+
+        data += chunk;
+        size -= chunk;
+    }
+
+    // Last 1 or 2 bytes, padded
+    if (size > 0U)
+    {
+        const std::uint32_t value = (std::uint32_t(data[0]) << 16U) | ((size == 2U) ? (std::uint32_t(data[1]) << 8U) : 0U);
+
+        text[0] = BASE64_DIGITS[(value >> 18U) & 0x3FU];
+        text[1] = BASE64_DIGITS[(value >> 12U) & 0x3FU];
+        text[2] = (size == 2U) ? BASE64_DIGITS[(value >> 6U) & 0x3FU] : '=';
+        text[3] = '=';
+
+        out.append(std::string_view(text, 4U));
+    }
+
+}
+
+} // pepon
@@ -0,0 +1,110 @@
+#ifndef BLOB_CODEC_HPP
+#define BLOB_CODEC_HPP
+
+#include <any>
+#include <vector>
+#include <string_view>
+#include <type_traits>
+
+#include "../Pepon.hpp"
+#include "../IO/OutputBuffer.hpp"
+#include "../Utils/Span.hpp"
+#include "../Utils/Endian.hpp"
+
+namespace pepon
+{
+
+// Blob literals: raw little endian bytes of a numeric vector, base64 or hex encoded
+// Ex: "w : vector<float> = b64{AACAPwAAAEA=}" -> { 1.0, 2.0 }
+// Whitespace (and new lines) between the curly brackets is ignored
+enum class e_blobEncoding
+{
+    NONE,       // regular comma separated values
+    BASE64,     // b64{...}
+    HEX,        // hex{...}
+};
+
+// Values that can be written as blob literals
+template <typename Type>
+constexpr bool isBlobType = std::is_same_v<Type, int> || std::is_same_v<Type, uint> ||
+                            std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+
+// Encoding of a container literal, from the text between '=' and '{' (trimmed)
+// Anything else than "b64" and "hex" is a regular container
+auto getBlobEncoding(std::string_view prefix) noexcept -> e_blobEncoding;
+
+// Upper bound of the number of decoded bytes
+auto getMaxBlobSize(std::string_view text, e_blobEncoding encoding) noexcept -> std::size_t;
+
+// Decodes the text into "dest" (getMaxBlobSize() bytes at least)
+// Returns the number of bytes written. Throws SyntaxError on invalid characters
+auto decodeBlob(std::string_view text, e_blobEncoding encoding, unsigned char* dest) -> std::size_t;
+
+// Writes "size" bytes, base64 encoded (without prefix nor curly brackets)
+void encodeBase64(const unsigned char* data, std::size_t size, OutputBuffer& out);
+
+
+// Blob literal -> vector<Type>
+template <typename Type>
+auto decodeBlobValues(std::string_view text, e_blobEncoding encoding) -> std::vector<Type>
+{
+
+    static_assert(isBlobType<Type>, "Blob literals hold int, uint, float and double values only");
+
+    const auto maxSize = getMaxBlobSize(text, encoding);
+
+    std::vector<Type> values(maxSize / sizeof(Type) + 1U);
+    const auto size = decodeBlob(text, encoding, reinterpret_cast<unsigned char*>(values.data()));
+
+    if (size % sizeof(Type) != 0U)
+        throw SyntaxError("Blob literal of " + std::to_string(size) + " bytes is not an array of " + std::string(getTypeName<Type>()));
+
+    values.resize(size / sizeof(Type));
+
+    if (!isLittleEndian())
+        byteSwap(values.data(), values.size());
+
+    return values;
+
+}
+
+// Same, for lazy variables
+template <typename Type, e_blobEncoding Encoding>
+auto decodeBlobAny(std::string_view text) -> std::any
+{
+    return std::make_any<std::vector<Type>>(decodeBlobValues<Type>(text, Encoding));
+}
+
+// Writes a vector as a base64 blob literal: "name : vector<type> = b64{...}"
+template <typename Type>
+void writeBlobLiteral(std::string_view name, Span<const Type> values, OutputBuffer& out)
+{
+
+    static_assert(isBlobType<Type>, "Blob literals hold int, uint, float and double values only");
+
+    out.append(name);
+    out.append(" : vector<");
+    out.append(getTypeName<Type>());
+    out.append("> = b64{");
+
+    if (isLittleEndian())
+    {
+        encodeBase64(reinterpret_cast<const unsigned char*>(values.data()), values.size() * sizeof(Type), out);
+    }
+    else
+    {
+        std::vector<Type> swapped(values.begin(), values.end());
+        byteSwap(swapped.data(), swapped.size());
+
+        encodeBase64(reinterpret_cast<const unsigned char*>(swapped.data()), swapped.size() * sizeof(Type), out);
+    }
+
+    out.append("}\n");
+
+}
+
+} // pepon
+
+
+#endif // BLOB_CODEC_HPP
@@ -0,0 +1,69 @@
+#include <algorithm>    // std::count
+
+#include <myoga-utils/Utils/StringUtils.hpp>
+
+#include "BoolParser.hpp"
+
+namespace pepon
+{
+
+// Single value
+auto parseBool(std::string_view str) -> bool
+{
+
+    // Usual values first
+    switch (str.size())
+    {
+        case 1U:
+            if (str[0] == '1')
+                return true;
+            if (str[0] == '0')
+                return false;
+            break;
+
+        case 4U:
+            if (str == "true")
+                return true;
+            break;
+
+        case 5U:
+            if (str == "false")
+                return false;
+            break;
+
+        default:
+            break;
+    }
+
+    return myoga::boolFromStr(str);
+
+}
+
+
+// Comma separated booleans, bit packed
+auto parseBools(std::string_view values) -> BitVector
+{
+
+    BitVector result;
+    result.reserve(static_cast<std::size_t>(std::count(values.begin(), values.end(), ',')) + 1U);
+
+    while (!values.empty())
+    {
+        const auto comma = values.find(',');
+        const auto value = myoga::trimStr(values.substr(0, comma));
+
+        // Skip empty values (ex: trailing commas)
+        if (!value.empty())
+            result.push_back(parseBool(value));
+
+        if (comma == std::string_view::npos)
+            break;
+
+        values.remove_prefix(comma + 1);
+    }
+
+    return result;
+
+}
+
+} // pepon
@@ -0,0 +1,25 @@
+#ifndef BOOL_PARSER_HPP
+#define BOOL_PARSER_HPP
+
+#include <string_view>
+
+#include "../Utils/BitVector.hpp"
+
+namespace pepon
+{
+
+// Boolean parsers
+// "true", "false", "1" and "0" are recognized at once,
+// anything else goes through myoga::boolFromStr()
+
+// Single value
+auto parseBool(std::string_view str) -> bool;
+
+// Comma separated booleans, bit packed
+// Ex: "true, 0,\n NOT_TRUE" -> { 1, 0, 0 }
+auto parseBools(std::string_view values) -> BitVector;
+
+} // pepon
+
+
+#endif // BOOL_PARSER_HPP
@@ -0,0 +1,128 @@
+#include "LineTokens.hpp"
+
+namespace pepon
+{
+
+// Is this (trimmed) line a comment? Gets the comment text
+// Its indexed comment marker ("//", "--" or "#") must start the line
+auto isComment(const IndexedLine& indexed, std::string_view& comment) -> bool
+{
+
+    const auto& line = indexed.line;
+
+    if (line.size() < 2U || indexed.position(indexed.info.comment) != 0U)
+        return false;
+
+    // Remove "#", or "//" and "--"
+    comment = myoga::trimStr(line.substr((line[0] == '#') ? 1U : 2U));
+    return true;
+
+}
+
+
+// Gets variable name and type
+// Returns the substring between ':' and '='
+auto getVarNameAndType(std::string_view line, std::size_t colon, std::size_t assignment) -> std::pair<std::string_view, std::string_view>
+{
+
+    if (colon == std::string_view::npos || assignment < colon)
+        throw SyntaxError("Colon character \':\' not found, or equal sign \'=\' is in the wrong position\n a : int = 10");
+
+    auto name = myoga::trimStr(line.substr(0, colon));
+    auto type = myoga::trimStr(line.substr(colon + 1, assignment - colon - 1));
+
+    return std::make_pair(name, type);
+
+}
+
+
+// Separates the "container" and the "type" elements
+auto getContainerAndType(std::string_view str) -> std::pair<std::string, e_cppTypes>
+{
+
+    auto lessThan    = str.find('<');
+    auto greaterThan = str.find('>');
+
+    if (lessThan == std::string_view::npos || greaterThan == std::string_view::npos)
+        throw SyntaxError("Complete container<type> for containers must be specified\nEx: elements : vector<int> = { -1, -2, -3 }");
+
+    // Get container and its inner template typename
+    auto container = myoga::lowercase(myoga::trimStr(str.substr(0, lessThan)));
+    auto innerType = myoga::lowercase(myoga::trimStr(str.substr(lessThan + 1, greaterThan - lessThan - 1)));
+
+    // Type to enum
+    auto typeAsEnum = stringTypeToEnum(innerType);
+
+    if (typeAsEnum == e_cppTypes::UNKNOWN)
+        throw SyntaxError("Unknown template data type for \"" + container + "<" + innerType + ">\"");
+
+    return { container, typeAsEnum };
+
+}
+
+
+// Encoding of a container literal: "= b64{", "= hex{", or regular values "= {"
+auto getBlobEncoding(std::string_view line, std::size_t assignment, std::size_t openCurlyBracket) -> e_blobEncoding
+{
+
+    if (openCurlyBracket < assignment)
+        return e_blobEncoding::NONE;
+
+    return getBlobEncoding(myoga::trimStr(line.substr(assignment + 1, openCurlyBracket - assignment - 1)));
+
+}
+
+
+// Kind of line (comments get their text)
+auto GroupScanner::scan(const IndexedLine& indexed, std::string_view& comment) -> e_line
+{
+
+    constexpr auto STR_TOKEN_NOT_FOUND = std::string_view::npos;
+
+    const auto& info = indexed.info;
+
+    // Inside a multiline string: wait for its closing quotation mark
+    if (m_inString)
+    {
+        m_inString = (info.closeQuote == StructuralIndex::NOT_FOUND);
+        return e_line::OTHER;
+    }
+
+    if (isComment(indexed, comment))
+        return e_line::COMMENT;
+
+    // Inside a multiline container: wait for its closing bracket
+    if (m_inContainer)
+    {
+        m_inContainer = (info.closeCurly == StructuralIndex::NOT_FOUND);
+        return e_line::OTHER;
+    }
+
+    if (indexed.position(info.openBracket) == 0U)
+        return e_line::GROUP;
+
+
+    // Does this variable start a multiline value?
+    if (info.assignment != StructuralIndex::NOT_FOUND)
+    {
+        auto openCurlyBracket   = indexed.position(info.openCurly);
+        auto closeCurlyBracket  = indexed.position(info.closeCurly);
+        auto openQuotetionMark  = indexed.position(info.openQuote);
+        auto closeQuotetionMark = indexed.position(info.closeQuote);
+
+        if (openCurlyBracket != STR_TOKEN_NOT_FOUND)
+        {
+            m_inContainer = (closeCurlyBracket == STR_TOKEN_NOT_FOUND);
+        }
+        else
+        if (closeCurlyBracket == STR_TOKEN_NOT_FOUND && openQuotetionMark != STR_TOKEN_NOT_FOUND)
+        {
+            m_inString = (closeQuotetionMark == STR_TOKEN_NOT_FOUND || closeQuotetionMark <= openQuotetionMark);
+        }
+    }
+
+    return e_line::OTHER;
+
+}
+
+} // pepon
@@ -0,0 +1,89 @@
+#ifndef LINE_TOKENS_HPP
+#define LINE_TOKENS_HPP
+
+#include <string>
+#include <utility>
+#include <string_view>
+
+#include <myoga-utils/Utils/StringUtils.hpp>
+
+#include "../Pepon.hpp"
+#include "BlobCodec.hpp"
+#include "StructuralIndex.hpp"
+
+namespace pepon
+{
+
+// Line level tokens, shared by every parser (PeponFile, PeponReader)
+
+// A trimmed line, and its indexed structural characters
+struct IndexedLine
+{
+
+    IndexedLine(std::string_view text, const StructuralIndex::Line& lineInfo)
+        : info(lineInfo)
+    {
+        std::string_view rawLine = text.substr(info.begin, info.size);
+
+        line    = myoga::trimStr(rawLine);
+        trimmed = static_cast<std::size_t>(line.data() - rawLine.data());
+    }
+
+    // Indexed positions are relative to the raw line
+    auto position(std::uint32_t relative) const noexcept -> std::size_t
+    {
+        return (relative == StructuralIndex::NOT_FOUND) ? std::string_view::npos : relative - trimmed;
+    }
+
+    const StructuralIndex::Line& info;
+
+    std::string_view line;
+    std::size_t trimmed;
+
+};
+
+
+// Is this (trimmed) line a comment? Gets the comment text
+// Its indexed comment marker ("//", "--" or "#") must start the line
+auto isComment(const IndexedLine& indexed, std::string_view& comment) -> bool;
+
+// Gets variable name and type
+// Returns the substring between ':' and '='
+// Ex: input = "elements : vector<int> = { -1, -2, -3 }", output = { "elements", "vector<int>" }"
+auto getVarNameAndType(std::string_view line, std::size_t colon, std::size_t assignment) -> std::pair<std::string_view, std::string_view>;
+
+// Separates the "container" and the "type" elements
+// Ex: input = "vector<int>", output = { "vector", e_cppTypes::INT }
+auto getContainerAndType(std::string_view str) -> std::pair<std::string, e_cppTypes>;
+
+// Encoding of a container literal: "= b64{", "= hex{", or regular values "= {"
+auto getBlobEncoding(std::string_view line, std::size_t assignment, std::size_t openCurlyBracket) -> e_blobEncoding;
+
+// Finds group declarations and comments, without parsing anything else
+// Multiline values are followed: a '[' inside them is never a group
+// This MUST follow the same rules as parseChunk()
+class GroupScanner
+{
+
+    public:
+
+        enum class e_line { GROUP, COMMENT, OTHER };
+
+    public:
+
+        // Kind of line (comments get their text)
+        auto scan(const IndexedLine& indexed, std::string_view& comment) -> e_line;
+
+
+    private:
+
+        // Multiline values state
+        bool m_inString    = false;
+        bool m_inContainer = false;
+
+};
+
+} // pepon
+
+
+#endif // LINE_TOKENS_HPP
@@ -0,0 +1,278 @@
+#include <cmath>
+#include <clocale>      // std::localeconv
+#include <cstdlib>      // std::strtod, std::strtof
+#include <cstring>      // std::memcpy
+#include <limits>
+#include <string>
+#include <system_error>
+
+#include "NumberParser.hpp"
+
+namespace pepon
+{
+
+namespace
+{
+
+[[noreturn]] void invalidNumber(std::string_view str)
+{
+    throw SyntaxError("Invalid floating point value \'" + std::string(str) + '\'');
+}
+
+
+// An optional sign, then a digit or a decimal point: no "inf", "nan" or "+-1"
+auto isDecimalNumber(std::string_view str) noexcept -> bool
+{
+    if (!str.empty() && (str.front() == '+' || str.front() == '-'))
+        str.remove_prefix(1);
+
+    return !str.empty() && ((str.front() >= '0' && str.front() <= '9') || str.front() == '.');
+}
+
+
+// Exact powers of ten a double can hold
+constexpr double POWERS_OF_TEN[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Exact powers of ten a float can hold
+constexpr float FLOAT_POWERS_OF_TEN[] =
+{
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+
+// Fast path limits of Type: exact mantissas, and exact powers of ten
+template <typename Type>
+struct FastPath
+{
+    static constexpr std::uint64_t MAX_MANTISSA = std::uint64_t(1) << 53;
+    static constexpr int MAX_EXPONENT = 22;
+
+    static auto power(int exponent) noexcept -> double { return POWERS_OF_TEN[exponent]; }
+    static auto convert(const char* str, char** end) -> double { return std::strtod(str, end); }
+};
+
+template <>
+struct FastPath<float>
+{
+    static constexpr std::uint64_t MAX_MANTISSA = std::uint64_t(1) << 24;
+    static constexpr int MAX_EXPONENT = 10;
+
+    static auto power(int exponent) noexcept -> float { return FLOAT_POWERS_OF_TEN[exponent]; }
+    static auto convert(const char* str, char** end) -> float { return std::strtof(str, end); }
+};
+
+
+// Portable parser, used when std::from_chars cannot parse floating point types:
+// Clinger's fast path handles the usual values exactly, in the arithmetic of Type (no double rounding),
+// and strtof()/strtod() take care of the rest, with the locale decimal point
+template <typename Type>
+auto parsePortable(std::string_view str) -> Type
+{
+
+    const char* cursor = str.data();
+    const char* end    = str.data() + str.size();
+
+    bool negative = false;
+
+    if (cursor != end && (*cursor == '+' || *cursor == '-'))
+    {
+        negative = (*cursor == '-');
+        ++cursor;
+    }
+
+    // Significant digits
+    std::uint64_t mantissa = 0U;
+    int exponent = 0;
+    int digits   = 0;
+    bool anyDigit = false;
+
+    while (cursor != end && *cursor >= '0' && *cursor <= '9')
+    {
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10U + static_cast<std::uint64_t>(*cursor - '0');
+            digits += (mantissa != 0U);
+        }
+        else
+            ++exponent;
+
+        anyDigit = true;
+        ++cursor;
+    }
+
+    if (cursor != end && *cursor == '.')
+    {
+        ++cursor;
+
+        while (cursor != end && *cursor >= '0' && *cursor <= '9')
+        {
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10U + static_cast<std::uint64_t>(*cursor - '0');
+                digits += (mantissa != 0U);
+                --exponent;
+            }
+
+            anyDigit = true;
+            ++cursor;
+        }
+    }
+
+    if (!anyDigit)
+        invalidNumber(str);
+
+    bool simpleExponent = true;
+
+    if (cursor != end && (*cursor == 'e' || *cursor == 'E'))
+    {
+        ++cursor;
+
+        bool negativeExponent = false;
+
+        if (cursor != end && (*cursor == '+' || *cursor == '-'))
+        {
+            negativeExponent = (*cursor == '-');
+            ++cursor;
+        }
+
+        // An exponent needs digits
+        if (cursor == end || *cursor < '0' || *cursor > '9')
+            invalidNumber(str);
+
+        int value = 0;
+
+        while (cursor != end && *cursor >= '0' && *cursor <= '9')
+        {
+            if (value < 10000)
+                value = value * 10 + (*cursor - '0');
+            else
+                simpleExponent = false;
+
+            ++cursor;
+        }
+
+        exponent += negativeExponent ? -value : value;
+    }
+
+    // The whole text must be the number
+    if (cursor != end)
+        invalidNumber(str);
+
+
+    // Fast path: both mantissa and power of ten are exact values of Type
+    if (simpleExponent && mantissa <= FastPath<Type>::MAX_MANTISSA && exponent >= -FastPath<Type>::MAX_EXPONENT && exponent <= FastPath<Type>::MAX_EXPONENT)
+    {
+        auto result = static_cast<Type>(mantissa);
+
+        if (exponent < 0)
+            result /= FastPath<Type>::power(-exponent);
+        else
+            result *= FastPath<Type>::power(exponent);
+
+        return negative ? -result : result;
+    }
+
+
+    // Slow path: strtof()/strtod() need a null terminated string, using the locale decimal point
+    // Long numbers (lots of digits) do not fit in the stack buffer
+    char stackBuffer[128];
+    std::string heapBuffer;
+
+    char* buffer = stackBuffer;
+
+    if (str.size() >= sizeof(stackBuffer))
+    {
+        heapBuffer.resize(str.size() + 1U);
+        buffer = heapBuffer.data();
+    }
+
+    std::memcpy(buffer, str.data(), str.size());
+    buffer[str.size()] = '\0';
+
+    const char decimalPoint = *std::localeconv()->decimal_point;
+
+    for (std::size_t i = 0U; i < str.size(); ++i)
+    {
+        if (buffer[i] == '.')
+            buffer[i] = decimalPoint;
+    }
+
+    char* parsedEnd = nullptr;
+    const Type result = FastPath<Type>::convert(buffer, &parsedEnd);
+
+    // Out of range, like std::from_chars: too large, or too small to be anything but zero
+    if (parsedEnd != buffer + str.size() || std::isinf(result) || (result == Type(0) && mantissa != 0U))
+        invalidNumber(str);
+
+    return result;
+
+}
+
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+
+// std::from_chars is available for floating point types
+template <typename Type>
+auto parseFloatingPoint(std::string_view str) -> Type
+{
+
+    // Same syntax as the portable parser: std::from_chars also accepts "inf" and "nan",
+    // and it does not accept a '+' sign
+    if (!isDecimalNumber(str))
+        invalidNumber(str);
+
+    if (str.front() == '+')
+        str.remove_prefix(1);
+
+    Type result {};
+    const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), result);
+
+    // The whole text must be the number: "1.5abc" and "0x1p3" are not
+    if (error != std::errc() || end != str.data() + str.size())
+        invalidNumber(str);
+
+    return result;
+
+}
+
+#else
+
+template <typename Type>
+auto parseFloatingPoint(std::string_view str) -> Type
+{
+    return parsePortable<Type>(str);
+}
+
+#endif
+
+} // anonymous namespace
+
+
+// Floating point values. Throws SyntaxError if "str" is not a number
+auto parseFloat(std::string_view str) -> float
+{
+    return parseFloatingPoint<float>(str);
+}
+
+auto parseDouble(std::string_view str) -> double
+{
+    return parseFloatingPoint<double>(str);
+}
+
+
+// Portable parsers, without std::from_chars. Same rules as parseFloat() and parseDouble()
+auto parseFloatPortable(std::string_view str) -> float
+{
+    return parsePortable<float>(str);
+}
+
+auto parseDoublePortable(std::string_view str) -> double
+{
+    return parsePortable<double>(str);
+}
+
+} // pepon
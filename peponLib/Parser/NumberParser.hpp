@@ -0,0 +1,188 @@
+#ifndef NUMBER_PARSER_HPP
+#define NUMBER_PARSER_HPP
+
+#include <vector>
+#include <charconv>     // std::from_chars
+#include <iterator>     // std::back_inserter
+#include <algorithm>    // std::count, std::copy_n
+#include <string_view>
+#include <type_traits>
+
+#include <myoga-utils/Utils/StringUtils.hpp>
+
+#include "../Pepon.hpp"
+#include "../Utils/Parallel.hpp"
+
+namespace pepon
+{
+
+// Locale independent, non allocating number parsers
+
+// Floating point values. Throws SyntaxError if "str" is not a number
+auto parseFloat(std::string_view str) -> float;
+auto parseDouble(std::string_view str) -> double;
+
+// Portable parsers, used when std::from_chars cannot parse floating point types
+// Same rules: an optional sign, decimal digits and exponent, no infinities or NaN
+auto parseFloatPortable(std::string_view str) -> float;
+auto parseDoublePortable(std::string_view str) -> double;
+
+
+// Any numeric type
+// Integers keep std::from_chars behaviour: invalid values are 0
+template <typename Type>
+auto parseNumber(std::string_view str) -> Type
+{
+    static_assert(std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>, "Numeric types only");
+
+    if constexpr (std::is_same_v<Type, float>)
+    {
+        return parseFloat(str);
+    }
+    else
+    if constexpr (std::is_same_v<Type, double>)
+    {
+        return parseDouble(str);
+    }
+    else
+    {
+        Type result {};
+        std::from_chars(str.data(), str.data() + str.size(), result);
+
+        return result;
+    }
+}
+
+
+// Vectors with this much text (or more) per thread are parsed in parallel
+constexpr std::size_t PARALLEL_PARSE_MIN_SIZE = 256U * 1024U;
+
+
+// Comma separated numbers, appended to "result"
+// Returns the number of values
+template <typename Type, typename OutputIt>
+auto parseNumbersInto(std::string_view values, OutputIt result) -> std::size_t
+{
+
+    std::size_t count = 0U;
+
+    while (!values.empty())
+    {
+        const auto comma = values.find(',');
+        const auto value = myoga::trimStr(values.substr(0, comma));
+
+        // Skip empty values (ex: trailing commas)
+        if (!value.empty())
+        {
+            *result++ = parseNumber<Type>(value);
+            ++count;
+        }
+
+        if (comma == std::string_view::npos)
+            break;
+
+        values.remove_prefix(comma + 1);
+    }
+
+    return count;
+
+}
+
+
+// Comma separated numbers, parsed by up to "threads" threads
+// The text is split at commas into one part per thread, and every part is parsed
+// straight into its own slice of the vector
+template <typename Type>
+auto parseNumbersParallel(std::string_view values, unsigned threads) -> std::vector<Type>
+{
+
+    const auto partCount = std::max<std::size_t>(1U, std::min<std::size_t>(threads, values.size() / PARALLEL_PARSE_MIN_SIZE));
+
+    // Parts end right after a comma
+    std::vector<std::string_view> parts;
+    parts.reserve(partCount);
+
+    while (parts.size() < partCount - 1U && !values.empty())
+    {
+        const auto comma = values.find(',', values.size() / (partCount - parts.size()));
+
+        if (comma == std::string_view::npos)
+            break;
+
+        parts.push_back(values.substr(0, comma + 1));
+        values.remove_prefix(comma + 1);
+    }
+
+    parts.push_back(values);
+
+
+    // First pass: room for every value of every part (empty values included)
+    std::vector<std::size_t> offsets(parts.size() + 1U, 0U);
+
+    parallelFor(parts.size(), threads, [&parts, &offsets](std::size_t index)
+    {
+        offsets[index + 1U] = static_cast<std::size_t>(std::count(parts[index].begin(), parts[index].end(), ',')) + 1U;
+    });
+
+    for (std::size_t i = 0U; i < parts.size(); ++i)
+        offsets[i + 1U] += offsets[i];
+
+
+    // Second pass: parse every part into its slice
+    std::vector<Type> result(offsets.back());
+    std::vector<std::size_t> counts(parts.size());
+
+    parallelFor(parts.size(), threads, [&parts, &offsets, &counts, &result](std::size_t index)
+    {
+        counts[index] = parseNumbersInto<Type>(parts[index], result.data() + offsets[index]);
+    });
+
+
+    // Close the gaps left by empty values
+    std::size_t size = counts.front();
+
+    for (std::size_t i = 1U; i < parts.size(); ++i)
+    {
+        if (size != offsets[i])
+            std::copy_n(result.data() + offsets[i], counts[i], result.data() + size);
+
+        size += counts[i];
+    }
+
+    result.resize(size);
+
+    return result;
+
+}
+
+
+// Comma separated numbers
+// Ex: "1.5, 2.0,\n 3" -> { 1.5, 2.0, 3.0 }
+// Large vectors are parsed in parallel, when using more than one thread
+template <typename Container>
+auto parseNumbers(std::string_view values, unsigned threads = 1U) -> Container
+{
+
+    using t_value = typename Container::value_type;
+
+    Container result;
+
+    // Only vectors can reserve memory
+    if constexpr (std::is_same_v<Container, std::vector<t_value>>)
+    {
+        if (threads > 1U && values.size() >= 2U * PARALLEL_PARSE_MIN_SIZE)
+            return parseNumbersParallel<t_value>(values, threads);
+
+        result.reserve(static_cast<std::size_t>(std::count(values.begin(), values.end(), ',')) + 1U);
+    }
+
+    parseNumbersInto<t_value>(values, std::back_inserter(result));
+
+    return result;
+
+}
+
+} // pepon
+
+
+#endif // NUMBER_PARSER_HPP
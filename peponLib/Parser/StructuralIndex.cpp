@@ -0,0 +1,410 @@
+#include <array>
+#include <cstring>      // std::memcpy
+#include <algorithm>    // std::min
+
+#include "StructuralIndex.hpp"
+#include "../Pepon.hpp"
+
+// x86 SIMD support
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PEPON_HAS_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+// GCC and Clang can compile AVX2 code without -mavx2, and choose it at runtime
+#if defined(PEPON_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__))
+    #define PEPON_HAS_AVX2 1
+    #define PEPON_TARGET_AVX2 __attribute__((target("avx2")))
+    #include <immintrin.h>
+#elif defined(PEPON_HAS_SSE2) && defined(__AVX2__)
+    #define PEPON_HAS_AVX2 1
+    #define PEPON_TARGET_AVX2
+    #include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace pepon
+{
+
+namespace
+{
+
+// Text is scanned in blocks of 64 characters: one bit per character
+constexpr std::size_t BLOCK_SIZE = 64U;
+
+// Masks computed per kernel call (4 KiB of text)
+constexpr std::size_t BLOCKS_PER_CHUNK = 64U;
+
+// Kernel: sets a bit for every structural character in "blocks" blocks of text
+using t_kernel = void (*)(const char* text, std::size_t blocks, std::uint64_t* masks);
+
+
+// Lowest set bit position
+inline auto countTrailingZeros(std::uint64_t mask) -> unsigned
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    unsigned index = 0U;
+    while ((mask & 1U) == 0U)
+    {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+
+// Scalar kernel
+[[maybe_unused]] auto makeStructuralTable() -> std::array<bool, 256>
+{
+    std::array<bool, 256> table {};
+
+    for (unsigned char c : std::string_view("\n[]:={}\",/-#", 12))
+        table[c] = true;
+
+    return table;
+}
+
+[[maybe_unused]] void scalarKernel(const char* text, std::size_t blocks, std::uint64_t* masks)
+{
+    static const auto isStructural = makeStructuralTable();
+
+    for (std::size_t block = 0U; block < blocks; ++block)
+    {
+        std::uint64_t mask = 0U;
+
+        for (std::size_t i = 0U; i < BLOCK_SIZE; ++i)
+        {
+            if (isStructural[static_cast<unsigned char>(text[i])])
+                mask |= (std::uint64_t(1) << i);
+        }
+
+        masks[block] = mask;
+        text += BLOCK_SIZE;
+    }
+}
+
+
+#ifdef PEPON_HAS_SSE2
+
+// SSE2 kernel: 16 characters per comparison
+void sse2Kernel(const char* text, std::size_t blocks, std::uint64_t* masks)
+{
+    const __m128i newLine      = _mm_set1_epi8('\n');
+    const __m128i openBracket  = _mm_set1_epi8('[');
+    const __m128i closeBracket = _mm_set1_epi8(']');
+    const __m128i colon        = _mm_set1_epi8(':');
+    const __m128i assignment   = _mm_set1_epi8('=');
+    const __m128i openCurly    = _mm_set1_epi8('{');
+    const __m128i closeCurly   = _mm_set1_epi8('}');
+    const __m128i quote        = _mm_set1_epi8('"');
+    const __m128i comma        = _mm_set1_epi8(',');
+    const __m128i slash        = _mm_set1_epi8('/');
+    const __m128i dash         = _mm_set1_epi8('-');
+    const __m128i hash         = _mm_set1_epi8('#');
+
+    for (std::size_t block = 0U; block < blocks; ++block)
+    {
+        std::uint64_t mask = 0U;
+
+        for (std::size_t i = 0U; i < BLOCK_SIZE; i += 16U)
+        {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+
+            __m128i found = _mm_or_si128(_mm_cmpeq_epi8(chars, newLine), _mm_cmpeq_epi8(chars, openBracket));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, closeBracket));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, colon));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, assignment));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, openCurly));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, closeCurly));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, quote));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, comma));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, slash));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, dash));
+            found = _mm_or_si128(found, _mm_cmpeq_epi8(chars, hash));
+
+            mask |= std::uint64_t(static_cast<std::uint16_t>(_mm_movemask_epi8(found))) << i;
+        }
+
+        masks[block] = mask;
+        text += BLOCK_SIZE;
+    }
+}
+
+#endif
+
+
+#ifdef PEPON_HAS_AVX2
+
+// AVX2 kernel: 32 characters per comparison
+PEPON_TARGET_AVX2
+void avx2Kernel(const char* text, std::size_t blocks, std::uint64_t* masks)
+{
+    const __m256i newLine      = _mm256_set1_epi8('\n');
+    const __m256i openBracket  = _mm256_set1_epi8('[');
+    const __m256i closeBracket = _mm256_set1_epi8(']');
+    const __m256i colon        = _mm256_set1_epi8(':');
+    const __m256i assignment   = _mm256_set1_epi8('=');
+    const __m256i openCurly    = _mm256_set1_epi8('{');
+    const __m256i closeCurly   = _mm256_set1_epi8('}');
+    const __m256i quote        = _mm256_set1_epi8('"');
+    const __m256i comma        = _mm256_set1_epi8(',');
+    const __m256i slash        = _mm256_set1_epi8('/');
+    const __m256i dash         = _mm256_set1_epi8('-');
+    const __m256i hash         = _mm256_set1_epi8('#');
+
+    for (std::size_t block = 0U; block < blocks; ++block)
+    {
+        std::uint64_t mask = 0U;
+
+        for (std::size_t i = 0U; i < BLOCK_SIZE; i += 32U)
+        {
+            const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+
+            __m256i found = _mm256_or_si256(_mm256_cmpeq_epi8(chars, newLine), _mm256_cmpeq_epi8(chars, openBracket));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, closeBracket));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, colon));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, assignment));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, openCurly));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, closeCurly));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, quote));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, comma));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, slash));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, dash));
+            found = _mm256_or_si256(found, _mm256_cmpeq_epi8(chars, hash));
+
+            mask |= std::uint64_t(static_cast<std::uint32_t>(_mm256_movemask_epi8(found))) << i;
+        }
+
+        masks[block] = mask;
+        text += BLOCK_SIZE;
+    }
+}
+
+#endif
+
+
+// Best kernel for this CPU
+struct Kernel
+{
+    t_kernel function;
+    std::string_view name;
+};
+
+auto selectKernel() -> Kernel
+{
+#if defined(PEPON_HAS_AVX2) && (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx2"))
+        return { avx2Kernel, "AVX2" };
+#elif defined(PEPON_HAS_AVX2)
+    return { avx2Kernel, "AVX2" };
+#endif
+
+#ifdef PEPON_HAS_SSE2
+    return { sse2Kernel, "SSE2" };
+#else
+    return { scalarKernel, "Scalar" };
+#endif
+}
+
+auto getKernel() -> const Kernel&
+{
+    static const Kernel kernel = selectKernel();
+    return kernel;
+}
+
+
+// An empty line, starting at "begin"
+constexpr auto makeLine(std::size_t begin) -> StructuralIndex::Line
+{
+    constexpr auto NF = StructuralIndex::NOT_FOUND;
+
+    return { begin, 0U, NF, NF, NF, NF, NF, NF, NF, NF, NF, 0U };
+}
+
+} // anonymous namespace
+
+
+// Index the entire text
+void StructuralIndex::build(std::string_view text)
+{
+
+    m_lines.clear();
+    m_lines.reserve(text.size() / 32U + 1U);
+
+    this->append(text, 0U);
+
+}
+
+// Index more text: complete lines, starting at byte "textOffset" of the whole text
+void StructuralIndex::append(std::string_view text, std::size_t textOffset)
+{
+
+    const auto firstLine = m_lines.size();
+
+    const auto kernel = getKernel().function;
+
+    std::array<std::uint64_t, BLOCKS_PER_CHUNK> masks;
+
+    Line current = makeLine(0U);
+
+
+    // Closes the current line at "position"
+    auto endLine = [&](std::size_t position)
+    {
+        std::size_t size = position - current.begin;
+
+        if (size >= NOT_FOUND)
+            throw SyntaxError("Line too long at byte offset " + std::to_string(textOffset + current.begin));
+
+        // Windows line endings
+        if (size > 0U && text[position - 1U] == '\r')
+            --size;
+
+        current.size = static_cast<std::uint32_t>(size);
+        m_lines.push_back(current);
+
+        current = makeLine(position + 1U);
+    };
+
+
+    std::size_t offset = 0U;
+
+    while (offset < text.size())
+    {
+
+        const std::size_t bytes  = std::min(text.size() - offset, BLOCK_SIZE * BLOCKS_PER_CHUNK);
+        std::size_t       blocks = bytes / BLOCK_SIZE;
+
+        kernel(text.data() + offset, blocks, masks.data());
+
+        // Last incomplete block: scan a padded copy
+        if (bytes % BLOCK_SIZE != 0U)
+        {
+            char padded[BLOCK_SIZE] = {};
+            std::memcpy(padded, text.data() + offset + blocks * BLOCK_SIZE, bytes % BLOCK_SIZE);
+
+            kernel(padded, 1U, masks.data() + blocks);
+            ++blocks;
+        }
+
+
+        // Visit every structural character found
+        for (std::size_t block = 0U; block < blocks; ++block)
+        {
+
+            std::uint64_t mask = masks[block];
+            const std::size_t base = offset + block * BLOCK_SIZE;
+
+            while (mask != 0U)
+            {
+
+                const std::size_t position = base + countTrailingZeros(mask);
+                mask &= (mask - 1U);
+
+                const auto relative = static_cast<std::uint32_t>(position - current.begin);
+
+                switch (text[position])
+                {
+                    case '\n':
+                        endLine(position);
+                        break;
+
+                    case '[':
+                        if (current.openBracket == NOT_FOUND)
+                            current.openBracket = relative;
+                        break;
+
+                    case ']':
+                        if (current.openBracket != NOT_FOUND && current.closeBracket == NOT_FOUND)
+                            current.closeBracket = relative;
+                        break;
+
+                    case ':':
+                        if (current.colon == NOT_FOUND)
+                            current.colon = relative;
+                        break;
+
+                    case '=':
+                        if (current.assignment == NOT_FOUND)
+                            current.assignment = relative;
+                        break;
+
+                    case '{':
+                        if (current.assignment != NOT_FOUND && current.openCurly == NOT_FOUND)
+                            current.openCurly = relative;
+                        break;
+
+                    case '}':
+                        current.closeCurly = relative;
+                        break;
+
+                    case '"':
+                        if (current.assignment != NOT_FOUND && current.openQuote == NOT_FOUND)
+                            current.openQuote = relative;
+                        current.closeQuote = relative;
+                        break;
+
+                    case ',':
+                        ++current.commas;
+                        break;
+
+                    // "//" and "--" start at their first character
+                    case '/':
+                    case '-':
+                        if (current.comment == NOT_FOUND && position + 1U < text.size() && text[position + 1U] == text[position])
+                            current.comment = relative;
+                        break;
+
+                    case '#':
+                        if (current.comment == NOT_FOUND)
+                            current.comment = relative;
+                        break;
+                }
+
+            }
+
+        }
+
+        offset += bytes;
+
+    }
+
+
+    // Last line, without end of line
+    if (current.begin < text.size())
+        endLine(text.size());
+
+    // Positions in the whole text
+    if (textOffset != 0U)
+    {
+        for (auto line = m_lines.begin() + static_cast<std::ptrdiff_t>(firstLine); line != m_lines.end(); ++line)
+            line->begin += textOffset;
+    }
+
+}
+
+
+// Getters:
+auto StructuralIndex::getLines() const noexcept -> const t_lines&
+{
+    return m_lines;
+}
+
+
+// Name of the implementation in use ("AVX2", "SSE2", "Scalar")
+auto StructuralIndex::getImplementationName() noexcept -> std::string_view
+{
+    return getKernel().name;
+}
+
+} // pepon
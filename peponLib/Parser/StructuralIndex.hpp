@@ -0,0 +1,67 @@
+#ifndef STRUCTURAL_INDEX_HPP
+#define STRUCTURAL_INDEX_HPP
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+namespace pepon
+{
+
+// First parsing stage: finds every line and the position of its structural
+// characters ('[', ']', ':', '=', '{', '}', '"', ',') and comment markers ("//", "--", "#") in one single sweep over the text
+// Uses AVX2 or SSE2 when available, with a scalar fallback
+class StructuralIndex
+{
+
+    public:
+
+        // Character not found in this line
+        static constexpr std::uint32_t NOT_FOUND = UINT32_MAX;
+
+        // Positions are relative to the beginning of the line
+        // They have the same meaning as the std::string_view::find() calls the parser used to make
+        struct Line
+        {
+            std::size_t   begin;
+            std::uint32_t size;             // Without the end of line characters
+
+            std::uint32_t openBracket;      // First '['
+            std::uint32_t closeBracket;     // First ']' after openBracket
+            std::uint32_t colon;            // First ':'
+            std::uint32_t assignment;       // First '='
+            std::uint32_t openCurly;        // First '{' after assignment
+            std::uint32_t closeCurly;       // Last '}'
+            std::uint32_t openQuote;        // First '"' after assignment
+            std::uint32_t closeQuote;       // Last '"'
+            std::uint32_t comment;          // First comment marker: "//", "--" or "#"
+            std::uint32_t commas;           // How many ',' (container elements - 1)
+        };
+
+        using t_lines = std::vector<Line>;
+
+    public:
+
+        // Index the entire text
+        void build(std::string_view text);
+        // Index more text, as it arrives: complete lines (ending with '\n', or the end of the text),
+        // starting at byte "textOffset" of the whole text. Same lines as one build() of the whole text
+        void append(std::string_view text, std::size_t textOffset);
+
+        // Getters:
+        auto getLines() const noexcept -> const t_lines&;
+
+        // Name of the implementation in use ("AVX2", "SSE2", "Scalar")
+        static auto getImplementationName() noexcept -> std::string_view;
+
+
+    private:
+
+        t_lines m_lines;
+
+};
+
+} // pepon
+
+
+#endif // STRUCTURAL_INDEX_HPP
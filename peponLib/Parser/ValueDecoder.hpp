@@ -0,0 +1,78 @@
+#ifndef VALUE_DECODER_HPP
+#define VALUE_DECODER_HPP
+
+#include <any>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <myoga-utils/Utils/StringUtils.hpp>
+
+#include "BoolParser.hpp"
+#include "NumberParser.hpp"
+
+namespace pepon
+{
+
+// Decodes the text of a value into its C++ type
+// Single values: int, uint, bool, float, double, strings
+// Containers: comma separated values, without curly brackets (vector<bool>: BitVector)
+// Large numeric vectors are parsed by up to "threads" threads
+template <typename Type>
+auto decodeValue(std::string_view text, [[maybe_unused]] unsigned threads = 1U) -> Type
+{
+
+    // Single values
+    if constexpr (std::is_same_v<Type, bool>)
+    {
+        return parseBool(text);
+    }
+    else
+    if constexpr (std::is_same_v<Type, std::string_view>)
+    {
+        return text;
+    }
+    else
+    if constexpr (std::is_same_v<Type, std::string>)
+    {
+        return std::string(text);
+    }
+    else
+    if constexpr (std::is_arithmetic_v<Type>)
+    {
+        return parseNumber<Type>(text);
+    }
+
+    // Containers
+    else
+    if constexpr (std::is_same_v<Type, BitVector>)
+    {
+        return parseBools(text);
+    }
+    else
+    {
+        using t_element = typename Type::value_type;
+
+        if constexpr (std::is_same_v<t_element, std::string>)
+            return myoga::parseCSStrings<Type>(std::string(text));
+        else
+        if constexpr (std::is_same_v<t_element, bool>)
+            return myoga::parseCSV<Type>(text);
+        else
+            return parseNumbers<Type>(text, threads);
+    }
+
+}
+
+
+// Same, for lazy variables
+template <typename Type>
+auto decodeAny(std::string_view text) -> std::any
+{
+    return std::make_any<Type>(decodeValue<Type>(text));
+}
+
+} // pepon
+
+
+#endif // VALUE_DECODER_HPP
@@ -21,6 +21,86 @@ auto SyntaxError::what() const noexcept -> const char*
 }
 
 
+// ----------------------------------------------------------------------
+// Is there anything to filter?
+auto PeponFilter::isEmpty() const noexcept -> bool
+{
+    return groups.empty() && !variables;
+}
+
+auto PeponFilter::matchesGroup(std::string_view group) const -> bool
+{
+
+    if (groups.empty())
+        return true;
+
+    for (const auto& pattern : groups)
+    {
+        if (globMatch(pattern, group))
+            return true;
+    }
+
+    return false;
+
+}
+
+auto PeponFilter::matchesVariable(std::string_view group, std::string_view variable) const -> bool
+{
+    return !variables || variables(group, variable);
+}
+
+
+// Did anything change?
+auto PeponChanges::isEmpty() const noexcept -> bool
+{
+    return addedGroups.empty() && removedGroups.empty() && changedGroups.empty() &&
+           addedVariables.empty() && removedVariables.empty() && changedVariables.empty();
+}
+
+
+// Glob pattern matching: '*' matches any text, '?' any character
+auto globMatch(std::string_view pattern, std::string_view text) noexcept -> bool
+{
+
+    std::size_t p = 0U;
+    std::size_t t = 0U;
+
+    // Last '*' seen, and where its text starts: backtrack there on mismatch
+    std::size_t star      = std::string_view::npos;
+    std::size_t starMatch = 0U;
+
+    while (t < text.size())
+    {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+        {
+            ++p;
+            ++t;
+        }
+        else
+        if (p < pattern.size() && pattern[p] == '*')
+        {
+            star      = p++;
+            starMatch = t;
+        }
+        else
+        if (star != std::string_view::npos)
+        {
+            p = star + 1U;
+            t = ++starMatch;
+        }
+        else
+            return false;
+    }
+
+    // Only '*' left
+    while (p < pattern.size() && pattern[p] == '*')
+        ++p;
+
+    return p == pattern.size();
+
+}
+
+
 // ----------------------------------------------------------------------
 // Recognize types from string format to enum
 auto stringTypeToEnum(std::string_view str) -> e_cppTypes
@@ -2,9 +2,14 @@
 #define PEPON_LIBRARY_HPP
 
 #include <tuple>
+#include <functional>
 #include <string>
 #include <string_view>
+#include <vector>
 #include <stdexcept>
+#include <type_traits>
+
+#include "Utils/BitVector.hpp"
 
 
 // Library configuration
@@ -26,6 +31,101 @@ struct PeponQuotes
 };
 
 
+// ----------------------------------------------------------------------
+// Selective loading: only the matching groups and variables are parsed
+// ----------------------------------------------------------------------
+struct PeponFilter
+{
+    // Group names, or glob patterns ('*': any text, '?': any character)
+    // Empty: every group
+    std::vector<std::string> groups;
+
+    // Variables of the matching groups: keep(group, variable)?
+    // Empty: every variable
+    std::function<bool(std::string_view group, std::string_view variable)> variables;
+
+
+    // Is there anything to filter?
+    auto isEmpty() const noexcept -> bool;
+
+    auto matchesGroup(std::string_view group) const -> bool;
+    auto matchesVariable(std::string_view group, std::string_view variable) const -> bool;
+};
+
+// Glob pattern matching: '*' matches any text, '?' any character
+auto globMatch(std::string_view pattern, std::string_view text) noexcept -> bool;
+
+
+// ----------------------------------------------------------------------
+// File loading configuration
+// ----------------------------------------------------------------------
+struct PeponLoadOptions
+{
+    // Read the file with a single read call (false) or memory map it (true)
+    // Either way, the file is parsed straight from one contiguous buffer
+    // Names, comments and strings of a mapped file are views into the mapping: the file must then be replaced
+    // (write another file, then rename it), never truncated or rewritten in place, while it is loaded.
+    // Otherwise values change under the reader, or reading them crashes (SIGBUS)
+    bool useMemoryMap = false;
+
+    // Groups, and large numeric vectors, are parsed in parallel when using more than one thread
+    // 0 means one thread per hardware thread
+    unsigned threads = 1U;
+
+    // Keep the text of every value, and decode it on first access
+    // Binary images are never parsed: their containers of numbers and bools are always left in them,
+    // and this leaves their containers of strings too
+    bool lazy = false;
+
+    // Store values inline in their groups (Group::e_storage::COMPACT), instead of one IVariable each
+    // Compact values are always decoded at load time
+    bool compact = false;
+
+    // Groups that do not match are skipped up to the next group, without being parsed
+    PeponFilter filter;
+
+    // loadFile() only: directory of pre parsed binary images, shared by every process of the host (see IO/ParseCache.hpp)
+    // A file is parsed once, then its image is mapped instead, until the file changes
+    // Empty: no cache
+    std::string cacheDirectory;
+};
+
+
+// ----------------------------------------------------------------------
+// File saving configuration
+// ----------------------------------------------------------------------
+struct PeponSaveOptions
+{
+    // vector<int|uint|float|double> values with at least this many elements
+    // are written as base64 blob literals: "w : vector<float> = b64{...}"
+    // 0 writes every value as text
+    std::size_t binaryLiteralsFrom = 0U;
+};
+
+
+// ----------------------------------------------------------------------
+// What changed in a PeponFile::loadFile() or reload()
+// ----------------------------------------------------------------------
+struct PeponChanges
+{
+    // Group names. A group changes when any of its values or comments change
+    // Decoded values are compared: another layout of the text, or "01" instead of "1", is no change, however the values were loaded
+    // Lazy values are decoded (into a copy) only if their text changed: one that cannot be decoded has changed
+    std::vector<std::string> addedGroups;
+    std::vector<std::string> removedGroups;
+    std::vector<std::string> changedGroups;
+
+    // "Group/variable" keys, of every added, removed and changed group
+    std::vector<std::string> addedVariables;
+    std::vector<std::string> removedVariables;
+    std::vector<std::string> changedVariables;
+
+
+    // Did anything change?
+    auto isEmpty() const noexcept -> bool;
+};
+
+
 // ----------------------------------------------------------------------
 // Exception class
 // ----------------------------------------------------------------------
@@ -102,10 +202,14 @@ inline auto getTypeName<float>() -> std::string_view       { return "float";  }
 template <>
 inline auto getTypeName<double>() -> std::string_view      { return "double"; }
 
-// String type
+// String types
 template <>
 inline auto getTypeName<std::string>() -> std::string_view { return "string"; }
 
+// Parsed strings are views into the PeponFile text
+template <>
+inline auto getTypeName<std::string_view>() -> std::string_view { return "string"; }
+
 
 // ----------------------------------------------------------------------
 template <typename Type>
@@ -131,10 +235,20 @@ inline auto getTypeEnum<float>() -> e_cppTypes       { return e_cppTypes::FLOAT;
 template <>
 inline auto getTypeEnum<double>() -> e_cppTypes      { return e_cppTypes::DOUBLE; }
 
-// String type
+// String types
 template <>
 inline auto getTypeEnum<std::string>() -> e_cppTypes { return e_cppTypes::STRING_UTF8; }
 
+template <>
+inline auto getTypeEnum<std::string_view>() -> e_cppTypes { return e_cppTypes::STRING_UTF8; }
+
+
+// ----------------------------------------------------------------------
+// Storage of Pepon vector<Type> values: bools are bit packed
+// ----------------------------------------------------------------------
+template <typename Type>
+using t_peponVector = std::conditional_t<std::is_same_v<Type, bool>, BitVector, std::vector<Type>>;
+
 
 // ----------------------------------------------------------------------
 // Free functions
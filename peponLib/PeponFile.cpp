@@ -1,4 +1,12 @@
+#include <cstdio>         // std::rename, std::remove
 #include <fstream>
+#include <atomic>
+#include <optional>
+#include <utility>        // std::as_const
+#include <iterator>       // std::back_inserter
+#include <algorithm>      // std::copy
+#include <typeinfo>
+#include <type_traits>
 
 #include "PeponFile.hpp"
 #include "PeponConfig.hpp"
@@ -6,83 +14,1232 @@
 #include <myoga-utils/Utils/MapFinder.hpp>
 #include <myoga-utils/Utils/StringUtils.hpp>
 
+#include "Utils/Parallel.hpp"
+#include "Parser/LineTokens.hpp"
+#include "IO/BinaryView.hpp"
+#include "IO/BinaryWriter.hpp"
+#include "IO/ParseCache.hpp"
+#include "IO/AsyncFileReader.hpp"
+#include "IO/SharedSegment.hpp"
+#include "Utils/Hash.hpp"
+#include "Variables/VectorValue.hpp"
+#include "Variables/DequeValue.hpp"
+#include "Variables/ListValue.hpp"
+
+
 namespace pepon
 {
 
-// Load and parse an entire Pepon file from disk
-void PeponFile::loadFile(t_filePath fileName)
+// Load and parse an entire Pepon file from disk
+void PeponFile::loadFile(t_filePath fileName, PeponLoadOptions options)
+{
+    this->loadSource(fileName, std::move(options), false);
+}
+
+// Same as loadFile(), on another thread
+auto PeponFile::loadFileAsync(t_filePath fileName, PeponLoadOptions options) -> std::future<void>
+{
+
+    // The caller may not keep the name alive
+#ifdef PEPON_USE_STL_PATH
+    std::filesystem::path path(fileName);
+#else
+    std::string path(fileName);
+#endif
+
+    return std::async(std::launch::async, [this, path = std::move(path), options = std::move(options)]() mutable
+    {
+        this->loadSource(path, std::move(options), true);
+    });
+
+}
+
+
+// loadFile(). Streamed: read by AsyncFileReader, indexed as it arrives (instead of memory mapped)
+void PeponFile::loadSource(t_filePath fileName, PeponLoadOptions options, bool streamed)
+{
+
+    // Remembered for reload()
+    auto source = std::make_unique<Source>();
+
+#ifdef PEPON_USE_STL_PATH
+    source->fileName = fileName.string();
+#else
+    source->fileName = fileName;
+#endif
+
+    source->status = getFileStatus(fileName);
+
+    LoadedData data;
+
+    if (!options.cacheDirectory.empty())
+    {
+        source->text = this->loadCached(fileName, source->status, options, data);
+    }
+    else
+    if (streamed)
+    {
+        source->text = this->loadStreamed(fileName, options, data);
+    }
+    else
+    {
+        // Map (or read) the whole file into a single buffer
+        MappedFile file(fileName, options.useMemoryMap ? MappedFile::e_mode::MEMORY_MAP
+                                                       : MappedFile::e_mode::READ);
+
+        // Keep it alive: parsed data points into it
+        // Then parse it in place
+        source->text = data.text.adopt(std::move(file));
+        data.groups  = this->parseBuffer(source->text, options);
+    }
+
+    source->isTracked = !source->text.empty() || source->status.size == 0U;
+    source->options   = std::move(options);
+
+    // What changed, for the subscribers: the previous data is still loaded
+    PeponChanges changes;
+
+    if (m_subscriptions)
+        changes = diffGroups(m_groups, data.groups);
+
+    this->commit(std::move(data), std::move(source), nullptr);
+
+    if (!changes.isEmpty())
+        this->notify(changes);
+
+}
+
+
+namespace
+{
+
+// Bytes of "count" values
+template <typename Type>
+auto bytesOf(const Type* data, std::size_t count) -> std::string_view
+{
+    return std::string_view(reinterpret_cast<const char*>(data), count * sizeof(Type));
+}
+
+// Hash of a decoded value and its type: another layout of the text, or "01" instead of "1", is the same value
+template <typename Type>
+auto hashValue(const Type& value) -> std::uint64_t
+{
+
+    // Single strings are std::string or std::string_view
+    using t_value = std::conditional_t<std::is_same_v<Type, std::string>, std::string_view, Type>;
+
+    const auto seed = static_cast<std::uint64_t>(typeid(t_value).hash_code());
+
+    if constexpr (std::is_arithmetic_v<Type>)
+    {
+        return hashBytes(bytesOf(&value, 1U), seed);
+    }
+    else
+    if constexpr (std::is_same_v<t_value, std::string_view>)
+    {
+        return hashBytes(value, seed);
+    }
+    else
+    if constexpr (std::is_same_v<Type, BitVector>)
+    {
+        // Unused bits of the last word are always 0
+        const auto words = value.getWords();
+        return hashBytes(bytesOf(words.data(), words.size()), seed + value.size());
+    }
+    else
+    if constexpr (std::is_same_v<Type, std::vector<typename Type::value_type>> && std::is_arithmetic_v<typename Type::value_type>)
+    {
+        return hashBytes(bytesOf(value.data(), value.size()), seed);
+    }
+    else
+    {
+        // deque, list and vector<string>: element by element
+        auto hash = seed + value.size();
+
+        for (const auto& element : value)
+        {
+            const auto elementHash = hashValue(element);
+            hash = hashBytes(bytesOf(&elementHash, 1U), hash);
+        }
+
+        return hash;
+    }
+
+}
+
+// Hash of a container left in a binary image, read in place: the same as hashValue() of its decoded copy
+template <typename Container>
+auto hashImageContainer(const BinaryView::VariableView& var) -> std::uint64_t
+{
+
+    using t_element = typename Container::value_type;
+
+    const auto seed = static_cast<std::uint64_t>(typeid(Container).hash_code());
+
+    if constexpr (std::is_same_v<Container, BitVector>)
+    {
+        const auto words = var.getWords();
+        return hashBytes(bytesOf(words.data(), words.size()), seed + var.size());
+    }
+    else
+    if constexpr (std::is_same_v<t_element, bool> || std::is_same_v<t_element, std::string>)
+    {
+        auto hash = seed + var.size();
+
+        for (std::size_t i = 0U; i < var.size(); ++i)
+        {
+            std::uint64_t elementHash = 0U;
+
+            if constexpr (std::is_same_v<t_element, bool>)
+                elementHash = hashValue(var.getBool(i));
+            else
+                elementHash = hashValue(var.getString(i));
+
+            hash = hashBytes(bytesOf(&elementHash, 1U), hash);
+        }
+
+        return hash;
+    }
+    else
+    {
+        const auto values = var.getArray<t_element>();
+
+        if constexpr (std::is_same_v<Container, std::vector<t_element>>)
+            return hashBytes(bytesOf(values.data(), values.size()), seed);
+
+        auto hash = seed + values.size();
+
+        for (const auto& element : values)
+        {
+            const auto elementHash = hashValue(element);
+            hash = hashBytes(bytesOf(&elementHash, 1U), hash);
+        }
+
+        return hash;
+    }
+
+}
+
+// Container<Type> left in a binary image
+template <template <typename...> class Container>
+auto hashImageContainers(const BinaryView::VariableView& var) -> std::uint64_t
+{
+
+    switch (var.getCppType())
+    {
+        case e_cppTypes::INT:
+            return hashImageContainer<Container<int>>(var);
+
+        case e_cppTypes::UINT:
+            return hashImageContainer<Container<uint>>(var);
+
+        case e_cppTypes::BOOL:
+            return hashImageContainer<Container<bool>>(var);
+
+        case e_cppTypes::FLOAT:
+            return hashImageContainer<Container<float>>(var);
+
+        case e_cppTypes::DOUBLE:
+            return hashImageContainer<Container<double>>(var);
+
+        case e_cppTypes::STRING_UTF8:
+            return hashImageContainer<Container<std::string>>(var);
+
+        case e_cppTypes::UNKNOWN:
+            break;
+    }
+
+    throw SyntaxError("Unknown variable type for " + std::string(var.getName()));
+
+}
+
+// Hash of a variable:
+// - Values left in a binary image are read in place
+// - Lazy values not decoded yet are decoded into a copy, that is not kept
+// - Others hash their decoded value
+// The same value has the same hash, however it was loaded. Throws SyntaxError for lazy values that cannot be decoded
+auto hashVariable(const IVariable& variable) -> std::uint64_t
+{
+
+    if (variable.isInImage())
+    {
+        return BinaryView::readRawValue(variable.getRawValue(), [](const BinaryView::VariableView& var)
+        {
+            switch (var.getVarType())
+            {
+                case IVariable::e_varType::VECTOR:
+                    return hashImageContainers<t_peponVector>(var);
+
+                case IVariable::e_varType::DEQUE:
+                    return hashImageContainers<std::deque>(var);
+
+                case IVariable::e_varType::LIST:
+                    return hashImageContainers<std::list>(var);
+
+                case IVariable::e_varType::SINGLE_VALUE:
+                    break;
+            }
+
+            throw SyntaxError("Binary Pepon: " + std::string(var.getName()) + " is not a container");
+        });
+    }
+
+    std::uint64_t hash = 0U;
+
+    auto hashOf = [&hash](const auto& value)
+    {
+        hash = hashValue(value);
+    };
+
+    if (variable.isDecoded())
+        visitVariable(variable, hashOf);
+    else
+        visitVariable(variable, variable.decodeCopy(), hashOf);
+
+    return hash;
+
+}
+
+// A value to compare: the hash of a decoded value, or a lazy variable, hashed only when needed (see isSameValue())
+struct ComparedValue
+{
+    std::uint64_t hash = 0U;
+    const IVariable* lazy = nullptr;
+};
+
+// <Variable name, value to compare>
+auto getComparedValues(const Group& group) -> std::unordered_map<std::string_view, ComparedValue>
+{
+
+    std::unordered_map<std::string_view, ComparedValue> values;
+    values.reserve(group.size());
+
+    if (group.getStorage() == Group::e_storage::COMPACT)
+    {
+        group.forEach([&values](std::string_view name, const auto& value)
+        {
+            values.try_emplace(name, ComparedValue { hashValue(value), nullptr });
+        });
+    }
+    else
+    {
+        for (const auto& variable : group.getVars())
+        {
+            if (variable->isLazy() && !variable->isInImage())
+                values.try_emplace(variable->getName(), ComparedValue { 0U, variable.get() });
+            else
+                values.try_emplace(variable->getName(), ComparedValue { hashVariable(*variable), nullptr });
+        }
+    }
+
+    return values;
+
+}
+
+// Lazy values of the same text and type are the same, without decoding them: a bad value nobody reads is no error
+// Others compare their decoded values (a lazy value that cannot be decoded has changed)
+auto isSameValue(const ComparedValue& before, const ComparedValue& after) -> bool
+{
+
+    if (before.lazy != nullptr && after.lazy != nullptr &&
+        before.lazy->getRawValue() == after.lazy->getRawValue() &&
+        before.lazy->getVarType() == after.lazy->getVarType() && before.lazy->getCppType() == after.lazy->getCppType())
+    {
+        return true;
+    }
+
+    try
+    {
+        return ((before.lazy != nullptr) ? hashVariable(*before.lazy) : before.hash) ==
+               ((after.lazy  != nullptr) ? hashVariable(*after.lazy)  : after.hash);
+    }
+    catch (const SyntaxError&)
+    {
+        return false;
+    }
+
+}
+
+// Adds what changed from "before" to "after" (nullptr: the group was added, or removed) to "changes"
+// Decoded values are compared, not their text. Lazy values are decoded only if their text changed. Returns true if anything changed
+auto diffGroup(const std::string& name, const Group* before, const Group* after, PeponChanges& changes) -> bool
+{
+
+    // Added or removed group: only the names of its variables are needed
+    auto addKeys = [&name](std::vector<std::string>& keys, const Group& group)
+    {
+        if (group.getStorage() == Group::e_storage::COMPACT)
+        {
+            for (const auto& value : group.getValues())
+                keys.push_back(name + '/' + std::string(value.name));
+        }
+        else
+        {
+            for (const auto& variable : group.getVars())
+                keys.push_back(name + '/' + std::string(variable->getName()));
+        }
+    };
+
+    if (before == nullptr || after == nullptr)
+    {
+        (before == nullptr ? changes.addedGroups : changes.removedGroups).push_back(name);
+        addKeys(before == nullptr ? changes.addedVariables : changes.removedVariables, (before == nullptr) ? *after : *before);
+
+        return true;
+    }
+
+    const auto oldValues = getComparedValues(*before);
+    const auto newValues = getComparedValues(*after);
+
+    bool changed = (before->getComments() != after->getComments());
+
+    for (const auto& [variable, value] : newValues)
+    {
+        const auto oldItr = oldValues.find(variable);
+
+        if (oldItr != oldValues.end() && isSameValue(oldItr->second, value))
+            continue;
+
+        (oldItr == oldValues.end() ? changes.addedVariables : changes.changedVariables).push_back(name + '/' + std::string(variable));
+        changed = true;
+    }
+
+    for (const auto& [variable, _] : oldValues)
+    {
+        if (newValues.count(variable) != 0U)
+            continue;
+
+        changes.removedVariables.push_back(name + '/' + std::string(variable));
+        changed = true;
+    }
+
+    if (changed)
+        changes.changedGroups.push_back(name);
+
+    return changed;
+
+}
+
+// Every list in name order
+void sortChanges(PeponChanges& changes)
+{
+    for (auto* names : { &changes.addedGroups, &changes.removedGroups, &changes.changedGroups,
+                         &changes.addedVariables, &changes.removedVariables, &changes.changedVariables })
+    {
+        std::sort(names->begin(), names->end());
+    }
+}
+
+} // anonymous namespace
+
+
+// Read a file with AsyncFileReader, and index every line as soon as it is read, into "data"
+// Returns the parsed text
+auto PeponFile::loadStreamed(t_filePath fileName, const PeponLoadOptions& options, LoadedData& data) const -> std::string_view
+{
+
+    StructuralIndex index;
+    std::size_t indexed = 0U;
+
+    // Complete lines only, until the end (the last call gets the whole file)
+    auto file = AsyncFileReader::readFile(fileName, [&index, &indexed](std::string_view ready)
+    {
+        auto end = ready.rfind('\n');
+        end = (end == std::string_view::npos || end < indexed) ? indexed : end + 1U;
+
+        if (end > indexed)
+        {
+            index.append(ready.substr(indexed, end - indexed), indexed);
+            indexed = end;
+        }
+    });
+
+    const auto text = file.view();
+
+    // Last line, without end of line
+    if (indexed < text.size())
+        index.append(text.substr(indexed), indexed);
+
+    // Views into the buffer stay valid: it does not move with the MappedFile object
+    data.text.adopt(std::move(file));
+    data.groups = this->parseIndexed(text, index.getLines(), options);
+
+    return text;
+
+}
+
+
+// Incremental reload of the file of the last loadFile(), with the same options
+auto PeponFile::reload() -> PeponChanges
+{
+
+    if (!m_source)
+        throw SyntaxError("Nothing to reload: no file was loaded by loadFile()");
+
+    auto& source = *m_source;
+    const auto& options = source.options;
+
+    PeponChanges changes;
+
+    const auto status = getFileStatus(source.fileName);
+
+    if (status == source.status)
+        return changes;
+
+
+    // Groups of the previous text, the first time
+    if (source.groups.empty() && !source.text.empty())
+    {
+        for (const auto& [name, group] : trackGroups(source.text, options.filter))
+            source.groups.try_emplace(name, group.hash);
+
+        source.text = {};
+    }
+
+    // Read, not mapped: only a copy of the parsed groups is kept
+    MappedFile file(source.fileName, MappedFile::e_mode::READ);
+
+    const auto groups = trackGroups(file.view(), options.filter);
+
+
+    // Groups whose text changed (every group, the first time): their text is copied, parsed, and owned by the new group
+    // Same text, same values: the other groups are not parsed at all
+    std::vector<std::string_view> texts;
+    std::vector<TextArena> arenas;
+
+    for (const auto& [name, group] : groups)
+    {
+        const auto oldItr = source.groups.find(name);
+
+        if (source.isSplit && source.isTracked && oldItr != source.groups.end() && oldItr->second == group.hash)
+            continue;
+
+        arenas.emplace_back();
+        texts.push_back(arenas.back().store(group.text));
+    }
+
+    std::vector<Chunk> chunks(texts.size());
+
+    // Groups in parallel, or the large containers of a single group
+    const auto threads = resolveThreadCount(options.threads);
+    const auto containerThreads = (texts.size() == 1U) ? threads : 1U;
+
+    parallelFor(texts.size(), threads, [&](std::size_t index)
+    {
+        try
+        {
+            chunks[index] = this->parseGroups(texts[index], options, containerThreads);
+        }
+        catch (...)
+        {
+            chunks[index].error = std::current_exception();
+        }
+    });
+
+    // Report the first error: nothing has changed yet
+    for (auto& chunk : chunks)
+    {
+        if (chunk.error)
+            std::rethrow_exception(chunk.error);
+    }
+
+    for (std::size_t i = 0U; i < chunks.size(); ++i)
+    {
+        if (!chunks[i].groups.empty())
+            chunks[i].groups.front().adoptText(std::move(arenas[i]));
+    }
+
+
+    // Find what changed first: m_groups is only updated once nothing can fail
+    // Groups with the same values are kept (but the first time, they are replaced to release the loaded file)
+    std::vector<Group*> newGroups;
+    std::vector<std::string_view> removedGroups;
+
+    for (auto& chunk : chunks)
+    {
+        for (auto& group : chunk.groups)
+        {
+            const auto oldItr = m_groups.find(group.getName());
+            const auto* before = (oldItr != m_groups.end()) ? &oldItr->second : nullptr;
+
+            if (diffGroup(std::string(group.getName()), before, &group, changes) || !source.isSplit)
+                newGroups.push_back(&group);
+        }
+    }
+
+    for (const auto& [groupName, group] : m_groups)
+    {
+        if (groups.count(std::string(groupName)) != 0U)
+            continue;
+
+        diffGroup(std::string(groupName), &group, nullptr, changes);
+        removedGroups.push_back(groupName);
+    }
+
+
+    // Replace the changed groups, add the new ones, remove the ones that are gone
+    for (auto* group : newGroups)
+    {
+        m_groups.erase(group->getName());
+
+        auto groupName = group->getName();
+        m_groups.try_emplace(groupName, std::move(*group));
+    }
+
+    for (auto groupName : removedGroups)
+        m_groups.erase(groupName);
+
+    // No group is a view into the loaded file anymore
+    if (!source.isSplit)
+        m_text.clear();
+
+    source.status = status;
+    source.groups.clear();
+
+    for (const auto& [name, group] : groups)
+        source.groups.try_emplace(name, group.hash);
+
+    source.isTracked = true;
+    source.isSplit   = true;
+
+    sortChanges(changes);
+
+    // Handles into replaced groups are resolved again
+    if (!newGroups.empty() || !removedGroups.empty())
+        m_generation = nextGeneration();
+
+    if (!changes.isEmpty())
+        this->notify(changes);
+
+    return changes;
+
+}
+
+
+namespace
+{
+
+// Writes a file through "writeTo(handle)" next to it, then renames it over the file (like ParseCache::store()):
+// a failed write never leaves it truncated, and groups that are views into the old file (memory mapped) keep it
+// Throws SyntaxError if it cannot be written
+template <typename Writer>
+void replaceFile(const PeponFile::t_filePath& fileName, Writer&& writeTo)
+{
+
+#ifdef PEPON_USE_STL_PATH
+    const std::filesystem::path filePath(fileName);
+    const auto tempPath = std::filesystem::path(filePath) += ".tmp";
+#else
+    const std::string filePath(fileName);
+    const auto tempPath = filePath + ".tmp";
+#endif
+
+    const auto removeTemp = [&tempPath]()
+    {
+#ifdef PEPON_USE_STL_PATH
+        std::error_code error;
+        std::filesystem::remove(tempPath, error);
+#else
+        std::remove(tempPath.c_str());
+#endif
+    };
+
+    {
+        std::ofstream handle(tempPath, std::ios_base::binary | std::ios_base::trunc);
+
+        if (!handle)
+            throw SyntaxError("File cannot be opened!");
+
+        try
+        {
+            writeTo(handle);
+        }
+        catch (...)
+        {
+            handle.close();
+            removeTemp();
+
+            throw;
+        }
+
+        if (!handle.flush())
+        {
+            handle.close();
+            removeTemp();
+
+            throw SyntaxError("File cannot be written!");
+        }
+
+        handle.close();
+
+        if (!handle)
+        {
+            removeTemp();
+            throw SyntaxError("File cannot be written!");
+        }
+    }
+
+#ifdef PEPON_USE_STL_PATH
+    std::error_code error;
+    std::filesystem::rename(tempPath, filePath, error);
+    const bool renamed = !error;
+#else
+    const bool renamed = (std::rename(tempPath.c_str(), filePath.c_str()) == 0);
+#endif
+
+    if (!renamed)
+    {
+        removeTemp();
+        throw SyntaxError("File cannot be written!");
+    }
+
+}
+
+} // anonymous namespace
+
+
+// Save Pepon data to a file on disk
+void PeponFile::saveFile(t_filePath fileName, PeponSaveOptions options)
+{
+
+    // Every group of an indexed file is written
+    const auto lock = this->lockAllGroups();
+
+    // Nothing to write?
+    if (m_groups.empty())
+        return;
+
+    replaceFile(fileName, [this, &options](std::ofstream& handle)
+    {
+        // Same format as print(), formatted into a large buffer:
+        // no flush per line, and no iostream formatting
+        OutputBuffer buffer(handle);
+
+        std::size_t written = 0U;
+
+        for (auto& [_, group] : m_groups)
+        {
+            group.write(m_quotes, options, buffer);
+
+            if (written < m_groups.size() - 1)
+            {
+                buffer.append('\n');
+                ++written;
+            }
+        }
+
+        buffer.flush();
+    });
+
+}
+
+
+namespace
+{
+
+// Container value, copied from a binary image (vector<bool>: BitVector)
+template <typename Container>
+auto copyBinaryContainer(const BinaryView::VariableView& var) -> Container
+{
+
+    using t_element = typename Container::value_type;
+
+    // vector<bool> values are bit packed
+    if constexpr (std::is_same_v<Container, BitVector>)
+    {
+        const auto words = var.getWords();
+        return BitVector({ words.begin(), words.end() }, var.size());
+    }
+    else
+    if constexpr (std::is_same_v<t_element, bool> || std::is_same_v<t_element, std::string>)
+    {
+        Container values;
+
+        for (std::size_t i = 0U; i < var.size(); ++i)
+        {
+            if constexpr (std::is_same_v<t_element, bool>)
+                values.push_back(var.getBool(i));
+            else
+                values.emplace_back(var.getString(i));
+        }
+
+        return values;
+    }
+    else
+    {
+        const auto values = var.getArray<t_element>();
+        return Container(values.begin(), values.end());
+    }
+
+}
+
+
+// Container<Type> value, copied from a binary image
+template <template <typename...> class Container>
+auto makeBinaryContainer(const BinaryView::VariableView& var) -> t_compactValue
+{
+
+    switch (var.getCppType())
+    {
+        case e_cppTypes::INT:
+            return makeCompactValue(copyBinaryContainer<Container<int>>(var));
+
+        case e_cppTypes::UINT:
+            return makeCompactValue(copyBinaryContainer<Container<uint>>(var));
+
+        case e_cppTypes::BOOL:
+            return makeCompactValue(copyBinaryContainer<Container<bool>>(var));
+
+        case e_cppTypes::FLOAT:
+            return makeCompactValue(copyBinaryContainer<Container<float>>(var));
+
+        case e_cppTypes::DOUBLE:
+            return makeCompactValue(copyBinaryContainer<Container<double>>(var));
+
+        case e_cppTypes::STRING_UTF8:
+            return makeCompactValue(copyBinaryContainer<Container<std::string>>(var));
+
+        case e_cppTypes::UNKNOWN:
+            break;
+    }
+
+    throw SyntaxError("Unknown variable type for " + std::string(var.getName()));
+
+}
+
+
+// Decoder of containers left in a binary image: copies them on first access
+template <typename Container>
+auto decodeImageAny(std::string_view raw) -> std::any
+{
+    return std::make_any<Container>(BinaryView::readRawValue(raw, &copyBinaryContainer<Container>));
+}
+
+
+// Container<Type> variable left in a binary image
+template <template <typename> class Variable, template <typename...> class Container>
+auto makeImageContainer(const BinaryView::VariableView& var) -> t_varSmartPtr
+{
+
+    const IVariable::NameView name { var.getName() };
+    const IVariable::RawValue raw { var.getRawValue(), true };
+
+    switch (var.getCppType())
+    {
+        case e_cppTypes::INT:
+            return std::make_unique<Variable<int>>(name, raw, &decodeImageAny<Container<int>>);
+
+        case e_cppTypes::UINT:
+            return std::make_unique<Variable<uint>>(name, raw, &decodeImageAny<Container<uint>>);
+
+        case e_cppTypes::BOOL:
+            return std::make_unique<Variable<bool>>(name, raw, &decodeImageAny<Container<bool>>);
+
+        case e_cppTypes::FLOAT:
+            return std::make_unique<Variable<float>>(name, raw, &decodeImageAny<Container<float>>);
+
+        case e_cppTypes::DOUBLE:
+            return std::make_unique<Variable<double>>(name, raw, &decodeImageAny<Container<double>>);
+
+        case e_cppTypes::STRING_UTF8:
+            return std::make_unique<Variable<std::string>>(name, raw, &decodeImageAny<Container<std::string>>);
+
+        case e_cppTypes::UNKNOWN:
+            break;
+    }
+
+    throw SyntaxError("Unknown variable type for " + std::string(var.getName()));
+
+}
+
+
+// Container variable left in a binary image, decoded (copied) on first access
+auto makeImageVariable(const BinaryView::VariableView& var) -> t_varSmartPtr
+{
+
+    switch (var.getVarType())
+    {
+        case IVariable::e_varType::VECTOR:
+            return makeImageContainer<VectorValue, t_peponVector>(var);
+
+        case IVariable::e_varType::DEQUE:
+            return makeImageContainer<DequeValue, std::deque>(var);
+
+        case IVariable::e_varType::LIST:
+            return makeImageContainer<ListValue, std::list>(var);
+
+        case IVariable::e_varType::SINGLE_VALUE:
+            break;
+    }
+
+    throw SyntaxError("Binary Pepon: " + std::string(var.getName()) + " is not a container");
+
+}
+
+
+// Value copied from a binary image. Single strings are views into it
+auto makeBinaryValue(const BinaryView::VariableView& var) -> t_compactValue
+{
+
+    switch (var.getVarType())
+    {
+        case IVariable::e_varType::SINGLE_VALUE:
+            break;
+
+        case IVariable::e_varType::VECTOR:
+            return makeBinaryContainer<t_peponVector>(var);
+
+        case IVariable::e_varType::DEQUE:
+            return makeBinaryContainer<std::deque>(var);
+
+        case IVariable::e_varType::LIST:
+            return makeBinaryContainer<std::list>(var);
+    }
+
+    switch (var.getCppType())
+    {
+        case e_cppTypes::INT:
+            return var.getValue<int>();
+
+        case e_cppTypes::UINT:
+            return var.getValue<uint>();
+
+        case e_cppTypes::BOOL:
+            return var.getValue<bool>();
+
+        case e_cppTypes::FLOAT:
+            return var.getValue<float>();
+
+        case e_cppTypes::DOUBLE:
+            return var.getValue<double>();
+
+        case e_cppTypes::STRING_UTF8:
+            return var.getValue<std::string_view>();
+
+        case e_cppTypes::UNKNOWN:
+            break;
+    }
+
+    throw SyntaxError("Unknown variable type for " + std::string(var.getName()));
+
+}
+
+} // anonymous namespace
+
+
+// Load a binary Pepon file. Names, comments and strings are views into it
+void PeponFile::loadBinary(t_filePath fileName, PeponLoadOptions options)
+{
+
+    MappedFile file(fileName, options.useMemoryMap ? MappedFile::e_mode::MEMORY_MAP
+                                                   : MappedFile::e_mode::READ);
+
+    // Keep it alive: groups point into it
+    LoadedData data;
+    const BinaryView image(data.text.adopt(std::move(file)));
+
+    data.groups = loadBinaryImage(image, options);
+    this->commit(std::move(data), nullptr, nullptr);
+
+}
+
+
+// Groups of a binary image. They are views into it
+auto PeponFile::loadBinaryImage(const BinaryView& image, const PeponLoadOptions& options) -> t_groupNameToVars
 {
 
-    // Open file
-    std::ifstream handle;
+    t_groupNameToVars groups;
 
-#ifdef PEPON_USE_STL_PATH
-    handle.open(fileName);
-#else
-    handle.open(fileName.data());
-#endif
+    for (std::size_t i = 0U; i < image.size(); ++i)
+    {
 
-    if (!handle)
-        throw SyntaxError("File cannot be opened!");
+        const auto groupView = image[i];
 
-    // Buffers
-    std::vector<std::string> entireFile;
-    std::string line;
+        // Selective loading
+        if (!options.filter.matchesGroup(groupView.getName()))
+            continue;
+
+        Group group(groupView.getName(), options.compact ? Group::e_storage::COMPACT
+                                                         : Group::e_storage::VARIABLES);
+
+        Group::t_commentsContainer comments;
+        comments.reserve(groupView.getCommentCount());
+
+        for (std::size_t j = 0U; j < groupView.getCommentCount(); ++j)
+            comments.push_back(groupView.getComment(j));
+
+        group.takeOwnershipOfComments(std::move(comments));
+
+        for (std::size_t j = 0U; j < groupView.size(); ++j)
+        {
+            const auto var = groupView[j];
+
+            if (!options.filter.matchesVariable(groupView.getName(), var.getName()))
+                continue;
+
+            // Containers of numbers and bools are left in the image, and so are containers of strings when lazy
+            // Compact values are always copied
+            const bool leftInImage = !options.compact && var.getVarType() != IVariable::e_varType::SINGLE_VALUE &&
+                                     (options.lazy || var.getCppType() != e_cppTypes::STRING_UTF8);
+
+            if (leftInImage)
+                group.addVariable(makeImageVariable(var));
+            else
+                group.addValue(var.getName(), makeBinaryValue(var));
+        }
 
-    // Read line by line
-    while(std::getline(handle, line))
-        entireFile.push_back(line);
+        // Try to create the new group in place
+        auto name = group.getName();
+        auto [itr, emplaced] = groups.try_emplace(name, std::move(group));
 
-    // Close it
-    handle.close();
+        if (!emplaced)
+            throw SyntaxError("New group was not emplaced correctly");
 
+    }
 
-    // Load from memory
-    //this->loadFromString(data.str());
-    this->loadFromMemory(entireFile);
+    return groups;
 
 }
 
-// Save Pepon data to a file on disk
-void PeponFile::saveFile(t_filePath fileName)
+
+// Save Pepon data to a binary file on disk
+void PeponFile::saveBinary(t_filePath fileName) const
 {
 
-    // Nothing to write?
-    if (m_groups.empty())
-        return;
+    const auto image = [this]()
+    {
+        const auto lock = this->lockAllGroups();
+        return makeBinaryImage(m_groups);
+    }();
 
+    replaceFile(fileName, [&image](std::ofstream& handle)
+    {
+        handle.write(image.data(), static_cast<std::streamsize>(image.size()));
+    });
 
-    // Get a file handle
-    std::ofstream handle;
+}
+
+
+// Publish the data as a named POSIX shared memory segment ("/name")
+void PeponFile::saveShared(std::string_view segmentName) const
+{
+    const auto lock = this->lockAllGroups();
+    SharedSegment::create(segmentName, makeBinaryImage(m_groups));
+}
+
+// Publish the data as a sealed memfd (Linux). Returns its descriptor: the caller owns it
+auto PeponFile::saveShared() const -> int
+{
+    const auto lock = this->lockAllGroups();
+    return SharedSegment::createAnonymous(makeBinaryImage(m_groups));
+}
+
+// Attach a segment: like loadBinary(), nothing is parsed
+void PeponFile::loadShared(std::string_view segmentName, PeponLoadOptions options)
+{
+    // Keep it attached: groups point into it
+    LoadedData data;
+    const BinaryView image(data.text.adopt(SharedSegment::attach(segmentName)));
+
+    data.groups = loadBinaryImage(image, options);
+    this->commit(std::move(data), nullptr, nullptr);
+}
+
+void PeponFile::loadShared(int fileDescriptor, PeponLoadOptions options)
+{
+    LoadedData data;
+    const BinaryView image(data.text.adopt(SharedSegment::attach(fileDescriptor)));
+
+    data.groups = loadBinaryImage(image, options);
+    this->commit(std::move(data), nullptr, nullptr);
+}
+
+
+// Binary image of these groups
+auto PeponFile::makeBinaryImage(const t_groupNameToVars& groups) -> std::string
+{
+
+    std::vector<const Group*> list;
+    list.reserve(groups.size());
+
+    for (const auto& [_, group] : groups)
+        list.push_back(&group);
+
+    return BinaryWriter().write(std::move(list));
+
+}
+
+
+// loadFile() through the parse cache, into "data"
+auto PeponFile::loadCached(t_filePath fileName, const FileStatus& status, const PeponLoadOptions& options, LoadedData& data) const -> std::string_view
+{
+
+    MappedFile file(fileName, options.useMemoryMap ? MappedFile::e_mode::MEMORY_MAP
+                                                   : MappedFile::e_mode::READ);
+
+    const ParseCache cache(options.cacheDirectory);
+    const auto key = ParseCache::makeKey(fileName, status, file.view());
+
+    // Replaced while opening it? Then its status does not describe its content
+    const bool isCacheable = (file.size() == status.size);
+
+    if (auto entry = isCacheable ? cache.find(key) : std::nullopt)
+    {
+        std::optional<BinaryView> image;
+
+        // A damaged entry is parsed and written again
+        try
+        {
+            image.emplace(entry->file.view().substr(entry->imageOffset));
+        }
+        catch (const SyntaxError&)
+        {
+        }
+
+        if (image)
+        {
+            // Keep it alive (the view does not move): groups point into it
+            data.text.adopt(std::move(entry->file));
+            data.groups = loadBinaryImage(*image, options);
+
+            return {};
+        }
+    }
 
-#ifdef PEPON_USE_STL_PATH
-    handle.open(fileName, std::ios_base::trunc);
-#else
-    handle.open(fileName.data(), std::ios_base::trunc);
-#endif
 
-    this->print(handle);
+    const auto text = data.text.adopt(std::move(file));
+    data.groups = this->parseBuffer(text, options);
+
+    // Selective loads do not hold the whole file: they are not cached
+    if (isCacheable && options.filter.isEmpty())
+    {
+        try
+        {
+            cache.store(key, makeBinaryImage(data.groups));
+        }
+        catch (const SyntaxError&)
+        {
+            // The cache is only an optimization
+        }
+    }
 
-    handle.close();
+    return text;
 
 }
 
 
 // Get group by reference/const reference
+// The error message is only built when the group is not found
 auto PeponFile::getGroup(std::string_view name) -> Group&
 {
-    auto itr = myoga::mapFinder(m_groups, name,
-                                std::string(PEPON_LIBRARY_NAME) + ": Group [" + std::string(name) + "] not found!");
-
-    return const_cast<Group&>(itr->second);
+    return const_cast<Group&>(std::as_const(*this).getGroup(name));
 }
 
 auto PeponFile::getGroup(std::string_view name) const -> const Group&
 {
-    const auto cItr = myoga::mapFinder(m_groups, name,
-                                       std::string(PEPON_LIBRARY_NAME) + ": Group [" + std::string(name) + "] not found!");
+    if (const auto* group = this->findGroup(name))
+        return *group;
+
+    // Not found: let mapFinder report it
+    std::unique_lock<std::mutex> lock;
+
+    if (m_onDemand)
+        lock = std::unique_lock<std::mutex>(m_onDemand->mutex);
+
+    return myoga::mapFinder(m_groups, name,
+                            std::string(PEPON_LIBRARY_NAME) + ": Group [" + std::string(name) + "] not found!")->second;
+}
+
+// Bytes of text owned: loaded files, and the text of every group
+auto PeponFile::getTextSize() const -> std::size_t
+{
+
+    std::unique_lock<std::mutex> lock;
+
+    if (m_onDemand)
+        lock = std::unique_lock<std::mutex>(m_onDemand->mutex);
+
+    auto size = m_text.size();
+
+    for (const auto& [_, group] : m_groups)
+        size += group.getTextSize();
+
+    return size;
+
+}
+
+
+// Resolve "Group/variable" once. Throws SyntaxError if it is not found
+auto PeponFile::resolve(std::string_view key) const -> KeyHandle
+{
+
+    // Group names may contain '/', variable names may not
+    const auto separator = key.rfind('/');
+
+    if (separator == std::string_view::npos)
+        throw SyntaxError("Invalid key \'" + std::string(key) + "\', expected \"Group/variable\"");
+
+    const auto* groupPtr = this->findGroup(key.substr(0U, separator));
+
+    if (groupPtr == nullptr)
+        throw SyntaxError("Group of \'" + std::string(key) + "\' not found");
+
+    const auto& group  = *groupPtr;
+    const auto varName = key.substr(separator + 1U);
+
+    KeyHandle handle;
+    handle.m_key        = key;
+    handle.m_generation = m_generation;
+    handle.m_revision   = group.getRevision();
+    handle.m_group      = &group;
+    handle.m_variable   = group.find(varName);
+    handle.m_value      = group.findValue(varName);
+
+    if (handle.m_variable == nullptr && handle.m_value == nullptr)
+        throw SyntaxError("Variable \'" + std::string(key) + "\' not found");
+
+    return handle;
+
+}
+
+
+// Change notifications:
+// Call "callback" after every loadFile() or reload() that changed this group, or this "Group/variable"
+auto PeponFile::subscribe(std::string key, t_changeCallback callback) -> std::size_t
+{
+
+    if (!m_subscriptions)
+        m_subscriptions = std::make_unique<Subscriptions>();
+
+    std::lock_guard<std::mutex> lock(m_subscriptions->mutex);
+
+    const auto id = ++m_subscriptions->lastId;
+    m_subscriptions->list.push_back({ id, std::move(key), std::move(callback) });
+
+    return id;
+
+}
+
+// Notifications already queued are still delivered
+void PeponFile::unsubscribe(std::size_t id)
+{
+
+    if (!m_subscriptions)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_subscriptions->mutex);
+
+    auto& list = m_subscriptions->list;
+    list.erase(std::remove_if(list.begin(), list.end(), [id](const Subscription& subscription) { return subscription.id == id; }),
+               list.end());
+
+}
 
-    return cItr->second;
+// Wait until every queued notification has been delivered
+void PeponFile::waitForNotifications() const
+{
+    if (m_subscriptions)
+        m_subscriptions->notifier.wait();
 }
 
 
@@ -94,184 +1251,463 @@ void PeponFile::useQuotation(PeponQuotes quotes)
 }
 
 
-// Shows every group and its content
-void PeponFile::print(std::ostream& out) const
-{
+// Shows every group and its content
+void PeponFile::print(std::ostream& out) const
+{
+
+    // Every group of an indexed file is shown
+    const auto lock = this->lockAllGroups();
+
+    // Nothing to write?
+    if (m_groups.empty())
+    {
+        out << "PeponFile is empty!" << '\n';
+        return;
+    }
+
+    std::size_t written = 0U;
+
+    // Iterate through every group
+    for (auto& [_, group] : m_groups)
+    {
+        group.print(m_quotes, out);
+
+        if (written < m_groups.size() - 1)
+        {
+            out << '\n';
+            ++written;
+        }
+
+    }
+
+}
+
+
+
+// Private functions
+// Helper to add a new single line container
+void PeponFile::makeSingleLineContainer(std::string_view line, std::size_t colon, std::size_t assignment, std::size_t openCurlyBracket, std::size_t closeCurlyBracket, Group& group, bool lazy, unsigned threads) const
+{
+
+    // Get Container<Type>
+    auto nameAndType = getVarNameAndType(line, colon, assignment);
+
+    // Get "container", enum type
+    auto contAndType = getContainerAndType(nameAndType.second);
+
+    // Remove curly braces from the values
+    auto cleanValues = line.substr(openCurlyBracket + 1, closeCurlyBracket - openCurlyBracket - 1);
+
+//    cout << " --->>> SL Container: \"" << nameAndType.first << "\" : \"" << contAndType.first << ", values: " << cleanValues << endl;
+
+    // Make it!
+    group.addContainer(nameAndType.first, contAndType.first, contAndType.second, cleanValues, lazy,
+                       getBlobEncoding(line, assignment, openCurlyBracket), threads);
+
+}
+
+
+
+// Index a Pepon text file
+void PeponFile::saveIndex(t_filePath fileName, t_filePath indexFile)
+{
+
+    const auto status = getFileStatus(fileName);
+    const MappedFile file(fileName);
+
+    GroupIndex index;
+    index.build(file.view());
+    index.save(indexFile, status);
+
+}
+
+// Map a Pepon text file without parsing it: every group is parsed on its first getGroup()/resolve()
+void PeponFile::loadIndexed(t_filePath fileName, t_filePath indexFile, PeponLoadOptions options)
+{
+
+    const auto status = getFileStatus(fileName);
+
+    auto onDemand = std::make_unique<OnDemand>();
+    onDemand->index.load(indexFile, status);
+    onDemand->options = std::move(options);
+
+    MappedFile file(fileName, onDemand->options.useMemoryMap ? MappedFile::e_mode::MEMORY_MAP
+                                                             : MappedFile::e_mode::READ);
+
+    // Replaced between both calls?
+    if (file.size() != status.size)
+        throw SyntaxError("Group index is stale: the file has changed since it was indexed");
+
+    // Keep it alive: groups will point into it
+    LoadedData data;
+    onDemand->text = data.text.adopt(std::move(file));
+
+    this->commit(std::move(data), nullptr, std::move(onDemand));
+
+}
+
+
+// Load and parse Pepon data from strings
+void PeponFile::loadFromMemory(const std::vector<std::string>& lines, PeponLoadOptions options)
+{
+
+    // Caller owns the lines: keep our own copy of them, in a single buffer
+    std::size_t size = 0U;
+
+    for (const auto& line : lines)
+        size += line.size() + 1U;
+
+    LoadedData data;
+
+    char* text = data.text.allocate(size);
+    char* dest = text;
+
+    for (const auto& line : lines)
+    {
+        dest  = std::copy(line.begin(), line.end(), dest);
+        *dest = '\n';
+        ++dest;
+    }
+
+    data.groups = this->parseBuffer({ text, size }, options);
+    this->commit(std::move(data), nullptr, nullptr);
+
+}
+
+
+// Load and parse Pepon data from a single buffer
+void PeponFile::loadFromMemory(std::string_view text, PeponLoadOptions options)
+{
+    // Caller owns the text: keep our own copy of it
+    LoadedData data;
+
+    data.groups = this->parseBuffer(data.text.store(text), options);
+    this->commit(std::move(data), nullptr, nullptr);
+}
+
+
+// Replaces the loaded data. Older key handles are resolved again
+void PeponFile::commit(LoadedData data, std::unique_ptr<Source> source, std::unique_ptr<OnDemand> onDemand)
+{
+
+    // Old groups first: they point into the old text
+    m_groups   = std::move(data.groups);
+    m_text     = std::move(data.text);
+    m_source   = std::move(source);
+    m_onDemand = std::move(onDemand);
+
+    m_generation = nextGeneration();
+
+}
+
+
+// A new, never used, generation
+auto PeponFile::nextGeneration() noexcept -> std::uint64_t
+{
+    static std::atomic<std::uint64_t> generations { 0U };
+
+    return ++generations;
+}
+
+
+// Parse a buffer. Groups are views into it
+auto PeponFile::parseBuffer(std::string_view text, const PeponLoadOptions& options) const -> t_groupNameToVars
+{
+
+    // First stage: find every line and its structural characters
+    StructuralIndex index;
+    index.build(text);
+
+    return this->parseIndexed(text, index.getLines(), options);
+
+}
+
+// Parse a buffer, already indexed
+auto PeponFile::parseIndexed(std::string_view text, const StructuralIndex::t_lines& lines, const PeponLoadOptions& options) const -> t_groupNameToVars
+{
+
+    // Second stage: parse line by line
+    const auto threads = resolveThreadCount(options.threads);
+
+    std::vector<Chunk> chunks;
+
+    if (threads > 1U)
+    {
+        // Groups are independent: split the text at group declarations
+        // A few chunks per thread, so they can balance the work
+        const auto chunkSize = std::max(MIN_CHUNK_SIZE, text.size() / (threads * 8U));
 
-    // Nothing to write?
-    if (m_groups.empty())
+        chunks = this->splitAtGroups(text, lines, chunkSize);
+    }
+    else
     {
-        out << "PeponFile is empty!" << std::endl;
-        return;
+        // Everything at once
+        chunks.resize(1U);
+        chunks.front().firstLine = 0U;
+        chunks.front().lastLine  = lines.size();
     }
 
-    std::size_t written = 0U;
+    // Chunks in parallel, or the large containers of a single chunk
+    const auto containerThreads = (chunks.size() == 1U) ? threads : 1U;
 
-    // Iterate through every group
-    for (auto& [_, group] : m_groups)
+    parallelFor(chunks.size(), threads, [&](std::size_t index)
     {
-        group.print(m_quotes, out);
+        auto& chunk = chunks[index];
 
-        if (written < m_groups.size() - 1)
+        try
         {
-            out << std::endl;
-            ++written;
+            this->parseChunk(text, lines, options, containerThreads, chunk);
+        }
+        catch (...)
+        {
+            chunk.error = std::current_exception();
         }
+    });
 
-    }
+
+    // Save parsed groups
+    return mergeChunks(chunks);
 
 }
 
 
 
-// Private functions
-// Separates the "container" and the "type" elements
-// Ex: input = "vector<int>", output = { "vector", e_cppTypes::INT }
-auto PeponFile::getContainerAndType(std::string_view str) -> std::pair<std::string, e_cppTypes>
+
+// Splits the text at group declarations, into chunks of about "chunkSize" bytes
+// Multiline values are never splitted
+auto PeponFile::splitAtGroups(std::string_view text, const StructuralIndex::t_lines& lines, std::size_t chunkSize) const -> std::vector<Chunk>
 {
 
-    auto lessThan    = str.find('<');
-    auto greaterThan = str.find('>');
+    std::vector<Chunk> chunks;
 
-    if (lessThan == std::string_view::npos || greaterThan == std::string_view::npos)
-        throw SyntaxError("Complete container<type> for containers must be specified\nEx: elements : vector<int> = { -1, -2, -3 }");
+    std::size_t chunkBegin = 0U;
 
-    // Get container and its inner template typename
-    auto container = myoga::lowercase(myoga::trimStr(str.substr(0, lessThan)));
-    auto innerType = myoga::lowercase(myoga::trimStr(str.substr(lessThan + 1, greaterThan - lessThan - 1)));
+    GroupScanner scanner;
+    std::string_view comment;
 
-    // Type to enum
-    auto typeAsEnum = stringTypeToEnum(innerType);
 
-    if (typeAsEnum == e_cppTypes::UNKNOWN)
-        throw SyntaxError("Unknown template data type for \"" + container + "<" + innerType + ">\"");
+    for (std::size_t lineNumber = 0U; lineNumber < lines.size(); ++lineNumber)
+    {
 
-    return { container, typeAsEnum };
+        const IndexedLine indexed(text, lines[lineNumber]);
 
-}
+        // New group: start a new chunk here?
+        if (scanner.scan(indexed, comment) == GroupScanner::e_line::GROUP &&
+            lineNumber > chunkBegin && (indexed.info.begin - lines[chunkBegin].begin) >= chunkSize)
+        {
+            auto& chunk = chunks.emplace_back();
 
+            chunk.firstLine = chunkBegin;
+            chunk.lastLine  = lineNumber;
 
-// Gets variable name and type
-// Returns the substring between ':' and '='
-// Ex: input = "elements : vector<int> = { -1, -2, -3 }", output = { "elements", "vector<int>" }"
-constexpr auto PeponFile::getVarNameAndType(std::string_view line, std::size_t assignment) const -> std::pair<std::string_view, std::string_view>
-{
+            chunkBegin = lineNumber;
+        }
+
+    }
 
-    auto colon = line.find_first_of(':');
 
-    if (colon == std::string_view::npos || assignment < colon)
-        throw SyntaxError("Colon character \':\' not found, or equal sign \'=\' is in the wrong position\n a : int = 10");
+    // Last chunk
+    auto& chunk = chunks.emplace_back();
 
-    auto name = myoga::trimStr(line.substr(0, colon));
-    auto type = myoga::trimStr(line.substr(colon + 1, assignment - colon - 1));
+    chunk.firstLine = chunkBegin;
+    chunk.lastLine  = lines.size();
 
-    return std::make_pair(name, type);
+    return chunks;
 
 }
 
 
-// Helper to add a new single line container
-void PeponFile::makeSingleLineContainer(std::string_view line, std::size_t assignment, std::size_t openCurlyBracket, std::size_t closeCurlyBracket, Group& group)
+// Skips the lines of a group that is not loaded, up to the next group
+// Returns the line of the next group (or lastLine). Comments are kept for the next group
+auto PeponFile::skipGroup(std::string_view text, const StructuralIndex::t_lines& lines, std::size_t firstLine, std::size_t lastLine,
+                          Group::t_commentsContainer& comments) const -> std::size_t
 {
 
-    // Get Container<Type>
-    auto nameAndType = this->getVarNameAndType(line, assignment);
+    GroupScanner scanner;
+    std::string_view comment;
 
-    // Get "container", enum type
-    auto contAndType = this->getContainerAndType(nameAndType.second);
+    for (std::size_t lineNumber = firstLine; lineNumber < lastLine; ++lineNumber)
+    {
 
-    // Remove curly braces from the values
-    auto cleanValues = line.substr(openCurlyBracket + 1, closeCurlyBracket - openCurlyBracket - 1);
+        switch (scanner.scan(IndexedLine(text, lines[lineNumber]), comment))
+        {
+            case GroupScanner::e_line::GROUP:
+                return lineNumber;
 
-//    cout << " --->>> SL Container: \"" << nameAndType.first << "\" : \"" << contAndType.first << ", values: " << cleanValues << endl;
+            case GroupScanner::e_line::COMMENT:
+                comments.emplace_back(comment);
+                break;
 
-    // Make it!
-    group.addContainer(nameAndType.first, contAndType.first, contAndType.second, cleanValues);
+            case GroupScanner::e_line::OTHER:
+                break;
+        }
 
-}
+    }
+
+    return lastLine;
 
+}
 
 
-// Load and parse Pepon data from strings
-void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
+// Parse the lines of a chunk
+void PeponFile::parseChunk(std::string_view text, const StructuralIndex::t_lines& lines, const PeponLoadOptions& options, unsigned threads, Chunk& chunk) const
 {
 
     // Token not found constant
     constexpr auto STR_TOKEN_NOT_FOUND = std::string_view::npos;
 
-    // Current line number being processed
-    std::size_t lineNumber = 0U;
-
     // Are we looking at a value that
     // is splitted into multiple lines?
     Multiline multi;
-    multi.isActive = false;
+    multi.isActive    = false;
+    multi.isContainer = false;
 
     // Comments
     Group::t_commentsContainer comments;
+    std::string_view comment;
 
+    // Group being filled (always the last one)
+    Group* currGroup = nullptr;
 
-    // Initialize iterator to invalid state
-    t_groupNameToVars::iterator currGroup = m_groups.end();
+    // Selective loading: is this variable of the current group loaded?
+    const auto isLoaded = [&options, &currGroup](std::string_view name)
+    {
+        return options.filter.matchesVariable(currGroup->getName(), name);
+    };
 
 
-    // Process the entire text
-    while(lineNumber < lines.size())
+    // Process the entire chunk
+    for (std::size_t lineNumber = chunk.firstLine; lineNumber < chunk.lastLine; ++lineNumber)
     {
 
-        // Implicit convertion operator
-        // https://en.cppreference.com/w/cpp/string/basic_string/operator_basic_string_view
-        std::string_view line = lines[lineNumber];
-        line = myoga::trimStr(line);
+        const IndexedLine indexed(text, lines[lineNumber]);
 
+        const auto& info = indexed.info;
+        const auto  line = indexed.line;
 
-        // Find comments
-        if (line.size() > 1)
+
+        // Inside a multiline string, every line is part of it
+        if (multi.isActive && !multi.isContainer)
         {
 
-            // C & C++ (//), Lua (--) style comments
-            if ((line[0] == '/' && line[1] == '/') || (line[0] == '-' && line[1] == '-'))
+            auto closeQuotetionMark = indexed.position(info.closeQuote);
+
+            // Closing a multiline string
+            if (closeQuotetionMark != STR_TOKEN_NOT_FOUND)
             {
-                // Remove those two characters
-                line.remove_prefix(2);
 
-                // Save the line
-                comments.emplace_back(myoga::trimStr(line));
-//                cout << '[' << lineNumber << "]: Comment" << endl;
+                // Disable multiline mode
+                multi.isActive = false;
+
+                // Is there any value before the closing quotation mark? Take it!
+                auto something = line.substr(0, closeQuotetionMark);
+                multi.buffer += something;
+
+//                cout << '[' << lineNumber << "]: MultiLine string ENDS! -> name: \"" << multi.varName << "\", started at line " << multi.startLine << endl;
+
+                // The buffer is reused: the group keeps its own copy
+                if (isLoaded(multi.varName))
+                {
+                    auto value = currGroup->storeText(multi.buffer);
+
+                    currGroup->addVariable(multi.varName, value, e_cppTypes::STRING_UTF8);
+                }
+
+                // Clear the multiline buffer
+                multi.buffer.clear();
 
-                // Continue iteration
-                ++lineNumber;
-                continue;
             }
             else
-            // Python style comments are supported too
-            if (line[0] == '#')
             {
-                // Remove that character
-                line.remove_prefix(1);
+                // Add this line to the multiline buffer
+                multi.buffer += line;
+                multi.buffer += '\n';
+            }
 
-                // Save the line
-                comments.emplace_back(myoga::trimStr(line));
-//                cout << '[' << lineNumber << "]: Comment" << endl;
+            continue;
 
-                // Continue iteration
-                ++lineNumber;
-                continue;
+        }
+
+
+        // Find comments
+        if (isComment(indexed, comment))
+        {
+            // Save the line
+            comments.emplace_back(comment);
+//            cout << '[' << lineNumber << "]: Comment" << endl;
+
+            // Continue iteration
+            continue;
+        }
+
+
+        // Inside a multiline container, only its closing bracket is expected
+        if (multi.isActive)
+        {
+
+            auto closeCurlyBracket = indexed.position(info.closeCurly);
+
+            // Closing a multiline container
+            if (closeCurlyBracket != STR_TOKEN_NOT_FOUND)
+            {
+
+                // Disable multiline mode
+                multi.isActive = false;
+
+                // Is there any value before the closing bracket? Take it!
+                auto something = myoga::trimStr(line.substr(0, closeCurlyBracket));
+
+                if (!myoga::isEmptyStr(something))
+                    multi.buffer += something;
+
+
+                // Get container and type
+                auto contAndType = getContainerAndType(multi.varType);
+
+//                cout << '[' << lineNumber << "]: MultiLine container ENDS! -> name: \"" << multi.varName << "\", container: \"" << contAndType.first << "\", started at line " << multi.startLine << endl;
+//                cout << '\'' << multi.buffer << '\'' << endl;
+
+                // The buffer is reused: lazy values need their own copy
+                if (isLoaded(multi.varName))
+                {
+                    std::string_view values = multi.buffer;
+
+                    if (options.lazy)
+                        values = currGroup->storeText(values);
+
+                    currGroup->addContainer(multi.varName, contAndType.first, contAndType.second, values, options.lazy, multi.encoding, threads);
+                }
+
+                // Clear the multiline buffer
+                multi.buffer.clear();
+
+            }
+            else
+            // Add this line to the multiline buffer
+            {
+                multi.buffer += line;
+                multi.buffer += '\n';
+
+//                cout << "\tadding line to buffer... " << line << endl;
             }
 
+            continue;
+
         }
 
 
 
         // Find [Group]
-        auto openBracket = line.find('[');
+        auto openBracket = indexed.position(info.openBracket);
 
         // Check for group name
-        if (openBracket != STR_TOKEN_NOT_FOUND)
+        // (it must be the first thing in the line: values can contain '[' too)
+        if (openBracket == 0U)
         {
 
             // Find close bracket
-            auto closeBracket = line.find(']', ++openBracket);
+            auto closeBracket = indexed.position(info.closeBracket);
+            ++openBracket;
 
             if (closeBracket == STR_TOKEN_NOT_FOUND)
                 throw SyntaxError("Syntax error: expected \']\' after group name\nin line: " + std::to_string(lineNumber));
@@ -281,27 +1717,31 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
             groupName = myoga::trimStr(groupName);
 
 
-            // Create the new group (with an empty container)
-//            cout << '[' << lineNumber << "]: Group [" << groupName << ']' << endl;
+            // Selective loading: jump to the next group, without parsing this one
+            if (!options.filter.matchesGroup(groupName))
+            {
+                // Its comments are skipped too
+                comments.clear();
+                currGroup = nullptr;
 
-            // Try to create the new group in place
-            auto [itr, emplaced] = m_groups.try_emplace(groupName, Group(groupName));
+                lineNumber = this->skipGroup(text, lines, lineNumber + 1U, chunk.lastLine, comments) - 1U;
+                continue;
+            }
 
-            if (!emplaced)
-                throw SyntaxError("New group was not emplaced correctly");
 
-            // Update iterator
-            currGroup = itr;
+            // Create the new group (with an empty container)
+//            cout << '[' << lineNumber << "]: Group [" << groupName << ']' << endl;
+            currGroup = &chunk.groups.emplace_back(groupName, options.compact ? Group::e_storage::COMPACT
+                                                                              : Group::e_storage::VARIABLES);
 
             // Save comments, if not empty
-            currGroup->second.takeOwnershipOfComments(comments);
+            currGroup->takeOwnershipOfComments(std::move(comments));
 
             // Delete them
             comments.clear();
 
 
             // Continue iteration
-            ++lineNumber;
             continue;
 
         }
@@ -309,20 +1749,21 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
 
 
         // Check for variable assignment
-        auto assignment = line.find('=');
+        auto assignment = indexed.position(info.assignment);
+        auto colon      = indexed.position(info.colon);
 
         if (assignment != STR_TOKEN_NOT_FOUND)
         {
 
             // In order to make a new variable,
             // a group is absolutely needed
-            if (currGroup == m_groups.end())
+            if (currGroup == nullptr)
                 throw SyntaxError("You cannot create variables without defining a [Group] first");
 
 
             // Find curly brackets
-            auto openCurlyBracket  = line.find_first_of('{', assignment + 1);
-            auto closeCurlyBracket = line.find_last_of ('}');
+            auto openCurlyBracket  = indexed.position(info.openCurly);
+            auto closeCurlyBracket = indexed.position(info.closeCurly);
 
             bool hasOpenCurlyBracket   = (openCurlyBracket  != STR_TOKEN_NOT_FOUND);
             bool hasClosedCurlyBracket = (closeCurlyBracket != STR_TOKEN_NOT_FOUND);
@@ -335,7 +1776,8 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
             {
 
 //                cout << '[' << lineNumber << "]: SingleLine container: " << line << endl;
-                this->makeSingleLineContainer(line, assignment, openCurlyBracket, closeCurlyBracket, currGroup->second);
+                if (!options.filter.variables || isLoaded(getVarNameAndType(line, colon, assignment).first))
+                    this->makeSingleLineContainer(line, colon, assignment, openCurlyBracket, closeCurlyBracket, *currGroup, options.lazy, threads);
 
             }
             else
@@ -344,16 +1786,18 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
             if (hasOpenCurlyBracket && !hasClosedCurlyBracket)
             {
 
-                auto nameAndType = this->getVarNameAndType(line, assignment);
+                auto nameAndType = getVarNameAndType(line, colon, assignment);
 
                 // Activate multiline mode
                 // starting from this line
-                multi.isActive  = true;
-                multi.startLine = lineNumber;
+                multi.isActive    = true;
+                multi.isContainer = true;
+                multi.startLine   = lineNumber;
 
                 // Save var name and type for later
-                multi.varName = nameAndType.first;
-                multi.varType = nameAndType.second;
+                multi.varName  = nameAndType.first;
+                multi.varType  = nameAndType.second;
+                multi.encoding = getBlobEncoding(line, assignment, openCurlyBracket);
 
                 // Is there any value beyond the bracket? Take it!
                 auto something = myoga::trimStr(line.substr(openCurlyBracket + 1));
@@ -383,8 +1827,8 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
             {
 
                 // Search for double quotation marks
-                auto openQuotetionMark  = line.find_first_of('"', assignment + 1);
-                auto closeQuotetionMark = line.find_last_of('"');
+                auto openQuotetionMark  = indexed.position(info.openQuote);
+                auto closeQuotetionMark = indexed.position(info.closeQuote);
 
                 bool hasOpeningQuotation = (openQuotetionMark   != STR_TOKEN_NOT_FOUND);
                 bool hasClosingQuotation = ((closeQuotetionMark != STR_TOKEN_NOT_FOUND) &&
@@ -399,7 +1843,7 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
 //                    cout << '[' << lineNumber << "]: SingleLine string -> " << line << endl;
 
                     // Get var name and type
-                    auto nameAndType = this->getVarNameAndType(line, assignment);
+                    auto nameAndType = getVarNameAndType(line, colon, assignment);
                     auto typeAsEnum = stringTypeToEnum(nameAndType.second);
 
                     // Type MUST be string!
@@ -410,7 +1854,8 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
                     auto value = line.substr(openQuotetionMark + 1, closeQuotetionMark - openQuotetionMark - 1);
 
                     // Make it!
-                    currGroup->second.addVariable(nameAndType.first, value, e_cppTypes::STRING_UTF8);
+                    if (isLoaded(nameAndType.first))
+                        currGroup->addVariable(nameAndType.first, value, e_cppTypes::STRING_UTF8);
 
 //                    cout << " --->>> SL String: \"" << nameAndType.first << "\" : \"string\" = \"" << value << "\"" << endl;
 
@@ -422,7 +1867,7 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
                 {
 
                     // Get variable name and type
-                    auto nameAndType = this->getVarNameAndType(line, assignment);
+                    auto nameAndType = getVarNameAndType(line, colon, assignment);
                     auto typeAsEnum = stringTypeToEnum(nameAndType.second);
 
                     // Type MUST be string!
@@ -431,12 +1876,12 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
 
                     // Activate multiline mode
                     // starting from this line
-                    multi.isActive  = true;
-                    multi.startLine = lineNumber;
+                    multi.isActive    = true;
+                    multi.isContainer = false;
+                    multi.startLine   = lineNumber;
 
-                    // Save var name and type for later
+                    // Save var name for later
                     multi.varName = nameAndType.first;
-//                    multi.varType = nameAndType.second;
 
                     // Is there any value beyond the quotation mark? Take it!
                     auto something = line.substr(openQuotetionMark + 1);
@@ -454,13 +1899,14 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
                 // (no container, no string)
                 {
 
-                    auto nameAndType = this->getVarNameAndType(line, assignment);
+                    auto nameAndType = getVarNameAndType(line, colon, assignment);
                     auto typeAsEnum = stringTypeToEnum(nameAndType.second);
 
                     auto value = myoga::trimStr(line.substr(assignment + 1));
 
                     // Create the new variable
-                    currGroup->second.addVariable(nameAndType.first, value, typeAsEnum);
+                    if (isLoaded(nameAndType.first))
+                        currGroup->addVariable(nameAndType.first, value, typeAsEnum, options.lazy);
 
 //                    cout << '[' << lineNumber << "]: SingleLine variable -> name: \"" << nameAndType.first << "\", type: \"" << nameAndType.second << "\", value: \"" << value << "\"" << endl;
 
@@ -471,96 +1917,264 @@ void PeponFile::loadFromMemory(const std::vector<std::string>& lines)
 
         } // if (assignment)
 
+    } // for
 
-        else
-        // No assignment?
-        // Check for closing multiline variables
-        {
 
-            auto closeCurlyBracket  = line.find_last_of('}');
-            auto closeQuotetionMark = line.find_last_of('"');
+    // Unfinished multiline value?
+    if (multi.isActive)
+        throw SyntaxError("Syntax error: multiline value \'" + std::string(multi.varName) + "\' starting at line " +
+                          std::to_string(multi.startLine) + " is never closed");
 
-            // Closing a multiline container
-            if (closeCurlyBracket != STR_TOKEN_NOT_FOUND)
+    // Comments after the last variable belong to the next group
+    chunk.comments = std::move(comments);
+
+}
+
+
+// Moves the parsed groups of every chunk into one map
+auto PeponFile::mergeChunks(std::vector<Chunk>& chunks) -> t_groupNameToVars
+{
+
+    // Report the first error found in the text
+    for (auto& chunk : chunks)
+    {
+        if (chunk.error)
+            std::rethrow_exception(chunk.error);
+    }
+
+
+    t_groupNameToVars groups;
+
+    // Comments waiting for the next group
+    Group::t_commentsContainer comments;
+
+    for (auto& chunk : chunks)
+    {
+
+        for (auto& group : chunk.groups)
+        {
+
+            // Comments from the previous chunk?
+            if (!comments.empty())
             {
+                group.takeOwnershipOfComments(std::move(comments));
+                comments.clear();
+            }
 
-                // Disable multiline mode
-                multi.isActive = false;
+            // Try to create the new group in place
+            auto name = group.getName();
+            auto [itr, emplaced] = groups.try_emplace(name, std::move(group));
 
-                // Is there any value before the closing bracket? Take it!
-                auto something = myoga::trimStr(line.substr(0, closeCurlyBracket));
+            if (!emplaced)
+                throw SyntaxError("New group was not emplaced correctly");
 
-                if (!myoga::isEmptyStr(something))
-                    multi.buffer += something;
+        }
 
+        comments.insert(comments.end(), chunk.comments.begin(), chunk.comments.end());
 
-                // Get container and type
-                auto contAndType = this->getContainerAndType(multi.varType);
+    }
 
+    return groups;
 
-//                    throw SyntaxError("Syntax error on line " + std::to_string(multi.startLine) +
-//                                      "\nContainer variables must include its <type>" +
-//                                      "\nEx: vector<int>");
+}
 
 
+// Text and hash of every group of a text (that passes the filter)
+auto PeponFile::trackGroups(std::string_view text, const PeponFilter& filter) -> std::unordered_map<std::string, GroupText>
+{
 
-//                cout << '[' << lineNumber << "]: MultiLine container ENDS! -> name: \"" << multi.varName << "\", container: \"" << contAndType.first << "\", started at line " << multi.startLine << endl;
-//                cout << '\'' << multi.buffer << '\'' << endl;
+    GroupIndex index;
+    index.build(text);
 
-                currGroup->second.addContainer(multi.varName, contAndType.first, contAndType.second, multi.buffer);
+    std::unordered_map<std::string, GroupText> groups;
+    groups.reserve(index.getRanges().size());
 
-                // Clear the multiline buffer
-                multi.buffer.clear();
+    for (const auto& range : index.getRanges())
+    {
+        if (!filter.matchesGroup(range.name))
+            continue;
 
-            }
-            else
-            // Closing a multiline string
-            if (closeQuotetionMark != STR_TOKEN_NOT_FOUND)
-            {
+        const auto groupText = text.substr(range.offset, range.size);
+        groups.try_emplace(range.name, GroupText { groupText, hashBytes(groupText) });
+    }
 
-                // Disable multiline mode
-                multi.isActive = false;
+    return groups;
 
-                // Is there any value before the closing quotation mark? Take it!
-                auto something = line.substr(0, closeQuotetionMark);
-                multi.buffer += something;
+}
 
-//                cout << '[' << lineNumber << "]: MultiLine string ENDS! -> name: \"" << multi.varName << "\", started at line " << multi.startLine << endl;
+// Parse the text of one or more groups, owned by m_text
+auto PeponFile::parseGroups(std::string_view text, const PeponLoadOptions& options, unsigned threads) const -> Chunk
+{
 
-                currGroup->second.addVariable(multi.varName, multi.buffer, e_cppTypes::STRING_UTF8);
+    StructuralIndex index;
+    index.build(text);
 
-                // Clear the multiline buffer
-                multi.buffer.clear();
+    Chunk chunk;
+    chunk.firstLine = 0U;
+    chunk.lastLine  = index.getLines().size();
 
-            }
-            else
+    this->parseChunk(text, index.getLines(), options, threads, chunk);
 
-            // No multiline string/container closing
-            // Add this line to the multiline buffer
-            // (only if multiline mode is activated)
+    return chunk;
+
+}
+
+
+// What changed from "before" to "after". Decoded values are compared, not their text
+auto PeponFile::diffGroups(const t_groupNameToVars& before, const t_groupNameToVars& after) -> PeponChanges
+{
+
+    PeponChanges changes;
+
+    for (const auto& [groupName, group] : after)
+    {
+        const auto oldItr = before.find(groupName);
+        diffGroup(std::string(groupName), (oldItr != before.end()) ? &oldItr->second : nullptr, &group, changes);
+    }
+
+    for (const auto& [groupName, group] : before)
+    {
+        if (after.count(groupName) == 0U)
+            diffGroup(std::string(groupName), &group, nullptr, changes);
+    }
+
+    sortChanges(changes);
+
+    return changes;
+
+}
+
+// Queue the notifications of these changes
+void PeponFile::notify(const PeponChanges& changes)
+{
+
+    if (!m_subscriptions)
+        return;
+
+    std::vector<std::pair<t_changeCallback, PeponChanges>> batch;
+
+    {
+        std::lock_guard<std::mutex> lock(m_subscriptions->mutex);
+
+        for (const auto& subscription : m_subscriptions->list)
+        {
+            const std::string_view key = subscription.key;
+
+            // The group itself, or any of its variables
+            auto isGroup    = [key](const std::string& name) { return name == key; };
+            auto isVariable = [key](const std::string& name)
             {
+                return name == key || (name.size() > key.size() && name[key.size()] == '/' && name.compare(0U, key.size(), key) == 0);
+            };
 
-                if (multi.isActive)
-                {
-                    multi.buffer += line;
-                    multi.buffer += '\n';
+            PeponChanges own;
 
-//                    cout << "\tadding line to buffer... " << line << endl;
-                }
+            auto copyIf = [](const std::vector<std::string>& from, std::vector<std::string>& to, const auto& matches)
+            {
+                std::copy_if(from.begin(), from.end(), std::back_inserter(to), matches);
+            };
+
+            copyIf(changes.addedGroups,      own.addedGroups,      isGroup);
+            copyIf(changes.removedGroups,    own.removedGroups,    isGroup);
+            copyIf(changes.changedGroups,    own.changedGroups,    isGroup);
+            copyIf(changes.addedVariables,   own.addedVariables,   isVariable);
+            copyIf(changes.removedVariables, own.removedVariables, isVariable);
+            copyIf(changes.changedVariables, own.changedVariables, isVariable);
+
+            if (!own.isEmpty())
+                batch.emplace_back(subscription.callback, std::move(own));
+        }
+    }
+
+    if (batch.empty())
+        return;
 
+    // One task per load: its callbacks are called together
+    m_subscriptions->notifier.post([batch = std::move(batch)]()
+    {
+        for (const auto& [callback, own] : batch)
+        {
+            try
+            {
+                callback(own);
             }
+            catch (...)
+            {
+                // A callback cannot stop the others
+            }
+        }
+    });
+
+}
+
+
+// Loaded group, parsed first if the file is indexed. Returns nullptr if not found
+auto PeponFile::findGroup(std::string_view name) const -> const Group*
+{
+
+    if (!m_onDemand)
+    {
+        const auto cItr = m_groups.find(name);
+        return (cItr != m_groups.end()) ? &cItr->second : nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_onDemand->mutex);
+
+    if (const auto cItr = m_groups.find(name); cItr != m_groups.end())
+        return &cItr->second;
+
+    const auto* range = m_onDemand->index.find(name);
+
+    if (range == nullptr || !m_onDemand->options.filter.matchesGroup(name))
+        return nullptr;
+
+    return this->parseIndexedGroup(*range);
 
-        }  // no assignment
+}
+
+
+// Parse the range of a group of an indexed file into m_groups. The on demand mutex MUST be locked
+// Returns the group of that range (nullptr if it was already parsed)
+auto PeponFile::parseIndexedGroup(const GroupRange& range) const -> const Group*
+{
+
+    // Parse its range alone
+    auto chunk = this->parseGroups(m_onDemand->text.substr(range.offset, range.size), m_onDemand->options,
+                                   resolveThreadCount(m_onDemand->options.threads));
+
+    const Group* found = nullptr;
+
+    for (auto& group : chunk.groups)
+    {
+        auto groupName = group.getName();
+        auto [itr, emplaced] = m_groups.try_emplace(groupName, std::move(group));
 
+        if (emplaced && groupName == range.name)
+            found = &itr->second;
+    }
+
+    return found;
+
+}
 
 
-        // Advance to next line
-        ++lineNumber;
+// Parse the groups an indexed file has not parsed yet, and lock them:
+// getGroup() on other threads cannot add groups while they are read. Nothing to do (no lock) for other loads
+auto PeponFile::lockAllGroups() const -> std::unique_lock<std::mutex>
+{
+
+    if (!m_onDemand)
+        return {};
 
-    } // while
+    std::unique_lock<std::mutex> lock(m_onDemand->mutex);
 
+    for (const auto& range : m_onDemand->index.getRanges())
+    {
+        if (m_groups.find(range.name) == m_groups.end() && m_onDemand->options.filter.matchesGroup(range.name))
+            this->parseIndexedGroup(range);
+    }
 
-//    cout << endl;
+    return lock;
 
 }
 
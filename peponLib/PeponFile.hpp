@@ -1,7 +1,12 @@
 #ifndef PEPON_FILE_HPP
 #define PEPON_FILE_HPP
 
+#include <mutex>
+#include <future>
+#include <memory>
+#include <functional>
 #include <vector>
+#include <exception>
 #include <unordered_map>
 
 #include "Pepon.hpp"
@@ -11,11 +16,50 @@
     #include <filesystem>
 #endif
 
+#include "IO/GroupIndex.hpp"
+#include "IO/MappedFile.hpp"
+#include "Memory/TextArena.hpp"
+#include "Parser/StructuralIndex.hpp"
+#include "Utils/Notifier.hpp"
 #include "Variables/Group.hpp"
 
 namespace pepon
 {
 
+class BinaryView;
+
+// A "Group/variable" resolved once by PeponFile::resolve()
+// Reads through it are a pointer dereference: no hashing, no string work
+// Handles belong to the PeponFile that resolved them:
+// when it loads data again, or when variables are added to or removed from their group, they are resolved again on their next read
+class KeyHandle
+{
+
+    public:
+
+        // Its "Group/variable" key
+        auto getKey() const noexcept -> std::string_view { return m_key; }
+
+    private:
+
+        friend class PeponFile;
+
+        std::string m_key;
+
+        // PeponFile generation, and group revision, when it was resolved
+        std::uint64_t m_generation = 0U;
+        std::uint64_t m_revision = 0U;
+
+        // Valid while the generation is the same
+        const Group* m_group = nullptr;
+
+        // One of them is set
+        const IVariable* m_variable = nullptr;
+        const t_compactValue* m_value = nullptr;
+
+};
+
+
 // Pepon file reader/writer class
 class PeponFile
 {
@@ -28,22 +72,91 @@ class PeponFile
         using t_filePath = std::string_view;
     #endif
 
+        // Gets the changes of its key only
+        using t_changeCallback = std::function<void(const PeponChanges& changes)>;
+
     public:
 
         // Interface:
         // File load and save functions:
+        // Every load replaces the loaded data, only once it has succeeded: on errors, nothing changes
         // Load and parse an entire Pepon file from disk
-        void loadFile(t_filePath fileName);
+        // With a cache directory, its binary image is loaded instead when it is up to date (see PeponLoadOptions)
+        void loadFile(t_filePath fileName, PeponLoadOptions options = {});
+        // Same as loadFile(), on another thread. Do not use this PeponFile until the future is ready
+        // The file is read with several large reads in flight (io_uring on Linux, see IO/AsyncFileReader.hpp),
+        // and indexed while the rest is read. With a cache directory, the cache is used instead
+        auto loadFileAsync(t_filePath fileName, PeponLoadOptions options = {}) -> std::future<void>;
+        // Incremental reload of the file of the last loadFile(), with the same options
+        // Only the groups whose text changed are parsed again: the other Group objects, and references into them, are kept
+        // Nothing is read if the file size and modification time did not change
+        // The file is read, never mapped, and each parsed group owns a copy of its text, freed with the group
+        // The first reload parses every group again, then releases the loaded file: until then, memory mapped files
+        // must be replaced (write another file, then rename it), not rewritten in place. Or load them with useMemoryMap = false
+        // Throws SyntaxError if no file was loaded by loadFile(). On syntax errors, nothing changes
+        auto reload() -> PeponChanges;
+
         // Save Pepon data to a file on disk
-        void saveFile(t_filePath fileName);
+        // Large numeric vectors can be written as blob literals (see PeponSaveOptions)
+        void saveFile(t_filePath fileName, PeponSaveOptions options = {});
+
+        // Binary format: no parsing at load time (see IO/BinaryFormat.hpp)
+        // Load a binary Pepon file. Names, comments and strings are views into it
+        // Containers of numbers and bools (and of strings, when lazy) are left in it: getSpan() and copyTo() read them in place,
+        // get() copies them on first access. Compact groups copy every value
+        void loadBinary(t_filePath fileName, PeponLoadOptions options = {});
+        // Save Pepon data to a binary file on disk
+        void saveBinary(t_filePath fileName) const;
+
+        // Shared memory: the binary image in a segment that every process of the host attaches read-only (see IO/SharedSegment.hpp)
+        // Publish the data as a named POSIX shared memory segment ("/name")
+        void saveShared(std::string_view segmentName) const;
+        // Publish the data as a sealed memfd (Linux). Returns its descriptor (inherit it, or send it): the caller owns it
+        auto saveShared() const -> int;
+        // Attach a segment: like loadBinary(), nothing is parsed, and names, comments, strings and containers are left in the segment
+        // Every process reads the same pages: nothing is copied into it until get() asks for a container
+        void loadShared(std::string_view segmentName, PeponLoadOptions options = {});
+        void loadShared(int fileDescriptor, PeponLoadOptions options = {});
+
+        // Group index: byte range of every group, saved in a sidecar file (see IO/GroupIndex.hpp)
+        // Index a Pepon text file
+        static void saveIndex(t_filePath fileName, t_filePath indexFile);
+        // Map a Pepon text file without parsing it: every group is parsed on its first getGroup()/resolve()
+        // Those are thread safe. print(), saveFile(), saveBinary() and saveShared() parse every group left first
+        // Throws SyntaxError if the index was made for another version of the file
+        void loadIndexed(t_filePath fileName, t_filePath indexFile, PeponLoadOptions options = {});
 
         // Load and parse Pepon data from strings
-        void loadFromMemory(const std::vector<std::string>& lines);
+        void loadFromMemory(const std::vector<std::string>& lines, PeponLoadOptions options = {});
+        // Load and parse Pepon data from a single buffer
+        void loadFromMemory(std::string_view text, PeponLoadOptions options = {});
 
         // Getters:
         // Get group by reference/const reference
         auto getGroup(std::string_view name) -> Group&;
         auto getGroup(std::string_view name) const -> const Group&;
+        // Bytes of text owned: loaded files, and the text of every group
+        auto getTextSize() const -> std::size_t;
+
+        // Key handles:
+        // Resolve "Group/variable" once. Throws SyntaxError if it is not found
+        auto resolve(std::string_view key) const -> KeyHandle;
+        // Read through a handle. Throws SyntaxError if the variable is not a "Type"
+        // Handles resolved before the last load are resolved again
+        template <typename Type>
+        auto get(KeyHandle& handle) const -> const Type&;
+
+        // Change notifications:
+        // Call "callback" after every loadFile() or reload() that changed this group (any of its values or comments), or this "Group/variable"
+        // Changes are relative to the data loaded before (see PeponChanges)
+        // The callbacks of a load are called together, in order, on a notifier thread: they run while this thread goes on
+        // (read values through a SharedPeponFile snapshot, or synchronize with the loads). Their exceptions are ignored
+        // Returns an id for unsubscribe()
+        auto subscribe(std::string key, t_changeCallback callback) -> std::size_t;
+        // Notifications already queued are still delivered
+        void unsubscribe(std::size_t id);
+        // Wait until every queued notification has been delivered. Never call it from a callback
+        void waitForNotifications() const;
 
         // Setters:
         // Specify quotations use and style
@@ -55,42 +168,211 @@ class PeponFile
 
     private:
 
-        // Private functions:
-        // Gets variable name and type
-        // Returns the substring between ':' and '='
-        constexpr auto getVarNameAndType(std::string_view line, std::size_t assignment) const -> std::pair<std::string_view, std::string_view>;
-        // Separates the "container" and the "type" elements
-        auto getContainerAndType(std::string_view str) -> std::pair<std::string, e_cppTypes>;
-        // Helper to add a new single line container
-        void makeSingleLineContainer(std::string_view line, std::size_t assignment, std::size_t openCurlyBracket, std::size_t closeCurlyBracket, Group& group);
-
-
-    private:
+        // <Group name, data>
+        using t_groupNameToVars = std::unordered_map<std::string_view, Group>;
 
         // Private struct
         struct Multiline
         {
             bool isActive;
+            bool isContainer;
             std::size_t startLine;
 
             std::string buffer;
             std::string_view varName;
             std::string_view varType;
+            e_blobEncoding encoding;
+        };
+
+        // Lines [firstLine, lastLine) parsed into groups
+        struct Chunk
+        {
+            std::size_t firstLine;
+            std::size_t lastLine;
+
+            std::vector<Group> groups;
+
+            // Comments after the last variable: they belong to the next group
+            Group::t_commentsContainer comments;
+
+            // Parsing error, if any
+            std::exception_ptr error;
+        };
+
+        // Text and hash of a group, for reload()
+        struct GroupText
+        {
+            std::string_view text;
+            std::uint64_t hash;
         };
 
+        // File of the last loadFile(), for reload()
+        struct Source
+        {
+            std::string fileName;
+            PeponLoadOptions options;
+            FileStatus status;
+
+            // Whole text of the last full load (nothing when it was loaded from the parse cache)
+            // It is only split into groups by the first reload()
+            std::string_view text;
+
+            // <Group name, hash of its text>: groups with the same text are not parsed again
+            bool isTracked = false;
+            std::unordered_map<std::string, std::uint64_t> groups;
+
+            // Every group owns its text: the loaded file was released by the first reload()
+            bool isSplit = false;
+        };
+
+        // Change notifications
+        struct Subscription
+        {
+            std::size_t id;
+            std::string key;
+            t_changeCallback callback;
+        };
+
+        struct Subscriptions
+        {
+            std::mutex mutex;
+            std::vector<Subscription> list;
+            std::size_t lastId = 0U;
+
+            // Last member: it delivers the queued notifications before anything else is destroyed
+            Notifier notifier;
+        };
+
+        // Everything a load builds: it replaces the loaded data only once the load has succeeded
+        struct LoadedData
+        {
+            // Groups, names, comments and string values are views into it
+            TextArena text;
+            t_groupNameToVars groups;
+        };
+
+        // Indexed file: groups parsed on demand
+        struct OnDemand
+        {
+            GroupIndex index;
+            PeponLoadOptions options;
+
+            std::string_view text;
+            std::mutex mutex;
+        };
+
+        // Smallest chunk parsed in parallel
+        static constexpr std::size_t MIN_CHUNK_SIZE = 64U * 1024U;
+
 
     private:
 
-        // <Group name, data>
-        using t_groupNameToVars = std::unordered_map<std::string_view, Group>;
+        // Private functions:
+        // A new, never used, generation
+        static auto nextGeneration() noexcept -> std::uint64_t;
+
+        // Replaces the loaded data. Older key handles are resolved again
+        void commit(LoadedData data, std::unique_ptr<Source> source, std::unique_ptr<OnDemand> onDemand);
+
+        // loadFile(). Streamed: read by AsyncFileReader, indexed as it arrives (instead of memory mapped)
+        void loadSource(t_filePath fileName, PeponLoadOptions options, bool streamed);
+        // Read a file with AsyncFileReader, and index every line as soon as it is read, into "data". Returns the parsed text
+        auto loadStreamed(t_filePath fileName, const PeponLoadOptions& options, LoadedData& data) const -> std::string_view;
+
+        // loadFile() through the parse cache, into "data"
+        // Returns the parsed text (nothing if its binary image was loaded instead)
+        auto loadCached(t_filePath fileName, const FileStatus& status, const PeponLoadOptions& options, LoadedData& data) const -> std::string_view;
+
+        // Text and hash of every group of a text (that passes the filter)
+        static auto trackGroups(std::string_view text, const PeponFilter& filter) -> std::unordered_map<std::string, GroupText>;
+        // Parse the text of one or more groups, owned by m_text
+        // Its large containers are parsed by up to "threads" threads
+        auto parseGroups(std::string_view text, const PeponLoadOptions& options, unsigned threads) const -> Chunk;
 
-        t_groupNameToVars m_groups;
+        // Groups of a binary image. They are views into it
+        static auto loadBinaryImage(const BinaryView& image, const PeponLoadOptions& options) -> t_groupNameToVars;
+        // Binary image of these groups
+        static auto makeBinaryImage(const t_groupNameToVars& groups) -> std::string;
+
+        // Parse a buffer. Groups are views into it
+        auto parseBuffer(std::string_view text, const PeponLoadOptions& options) const -> t_groupNameToVars;
+        // Parse a buffer, already indexed
+        auto parseIndexed(std::string_view text, const StructuralIndex::t_lines& lines, const PeponLoadOptions& options) const -> t_groupNameToVars;
+        // Splits the text at group declarations, into chunks of about "chunkSize" bytes
+        auto splitAtGroups(std::string_view text, const StructuralIndex::t_lines& lines, std::size_t chunkSize) const -> std::vector<Chunk>;
+        // Skips the lines of a group that is not loaded, up to the next group
+        auto skipGroup(std::string_view text, const StructuralIndex::t_lines& lines, std::size_t firstLine, std::size_t lastLine,
+                       Group::t_commentsContainer& comments) const -> std::size_t;
+        // Parse the lines of a chunk. Its large containers are parsed by up to "threads" threads
+        // (1 when chunks are already parsed in parallel: the pool is not shared N x N)
+        void parseChunk(std::string_view text, const StructuralIndex::t_lines& lines, const PeponLoadOptions& options, unsigned threads, Chunk& chunk) const;
+        // Moves the parsed groups of every chunk into one map
+        static auto mergeChunks(std::vector<Chunk>& chunks) -> t_groupNameToVars;
+
+        // What changed from "before" to "after". Decoded values are compared, not their text
+        static auto diffGroups(const t_groupNameToVars& before, const t_groupNameToVars& after) -> PeponChanges;
+        // Queue the notifications of these changes
+        void notify(const PeponChanges& changes);
+
+        // Loaded group, parsed first if the file is indexed. Returns nullptr if not found
+        auto findGroup(std::string_view name) const -> const Group*;
+        // Parse the range of a group of an indexed file. The on demand mutex MUST be locked
+        auto parseIndexedGroup(const GroupRange& range) const -> const Group*;
+        // Parse every group an indexed file has not parsed yet, and keep them locked while m_groups is read
+        auto lockAllGroups() const -> std::unique_lock<std::mutex>;
+
+        // Helper to add a new single line container
+        void makeSingleLineContainer(std::string_view line, std::size_t colon, std::size_t assignment, std::size_t openCurlyBracket, std::size_t closeCurlyBracket, Group& group, bool lazy, unsigned threads) const;
+
+
+    private:
+
+        // Indexed files add groups to it on demand (see loadIndexed())
+        mutable t_groupNameToVars m_groups;
+
+        // Only set by loadIndexed()
+        std::unique_ptr<OnDemand> m_onDemand;
+
+        // Only set by loadFile()
+        std::unique_ptr<Source> m_source;
+
+        // Every parsed text is owned here (or by the groups)
+        // Groups, names, comments and string values are views into it
+        TextArena m_text;
 
         // Quotation config
         PeponQuotes m_quotes;
 
+        // Changed by every load: older key handles are resolved again
+        // Unique across every PeponFile, so handles never match another file
+        std::uint64_t m_generation = nextGeneration();
+
+        // Created by the first subscribe()
+        // Last member: callbacks still running can read everything else
+        std::unique_ptr<Subscriptions> m_subscriptions;
+
 };
 
+
+// Read through a handle. Throws SyntaxError if the variable is not a "Type"
+// Handles resolved before the last load, or before their group changed, are resolved again
+template <typename Type>
+auto PeponFile::get(KeyHandle& handle) const -> const Type&
+{
+
+    if (handle.m_generation != m_generation || handle.m_group == nullptr || handle.m_revision != handle.m_group->getRevision())
+        handle = this->resolve(handle.m_key);
+
+    const auto* value = (handle.m_value != nullptr) ? getIf<Type>(*handle.m_value)
+                                                    : std::any_cast<Type>(&handle.m_variable->getAny());
+
+    if (value == nullptr)
+        throw SyntaxError("Variable \'" + handle.m_key + "\' is not a " + std::string(getTypeName<Type>()));
+
+    return *value;
+
+}
+
 } // pepon
 
 
@@ -0,0 +1,399 @@
+#include <cstring>      // std::memmove
+#include <fstream>
+#include <algorithm>    // std::min
+
+#include "PeponReader.hpp"
+
+namespace pepon
+{
+
+// Syntax error at this line. Throws the error by default
+auto PeponHandler::onError(const SyntaxError& error, [[maybe_unused]] std::size_t lineNumber) -> bool
+{
+    throw error;
+}
+
+
+// ctor
+PeponReader::PeponReader(PeponHandler& handler, std::size_t windowSize)
+
+    : m_handler(handler),
+      m_windowSize(std::max<std::size_t>(windowSize, 1U))
+{
+}
+
+
+// Read the whole text, from a file
+auto PeponReader::readFile(t_filePath fileName) -> bool
+{
+
+    std::ifstream handle;
+
+#ifdef PEPON_USE_STL_PATH
+    handle.open(fileName, std::ios_base::binary);
+#else
+    handle.open(std::string(fileName), std::ios_base::binary);
+#endif
+
+    if (!handle)
+        throw SyntaxError("File cannot be opened!");
+
+    return this->readStream(handle);
+
+}
+
+// Read the whole text, from a stream
+auto PeponReader::readStream(std::istream& in) -> bool
+{
+
+    this->reset();
+
+    std::string window(m_windowSize, '\0');
+    std::size_t used = 0U;
+
+    while (true)
+    {
+
+        // A line longer than the window: make room for it
+        if (used == window.size())
+            window.resize(window.size() * 2U);
+
+        in.read(window.data() + used, static_cast<std::streamsize>(window.size() - used));
+        used += static_cast<std::size_t>(in.gcount());
+
+        if (in.bad())
+            throw SyntaxError("File cannot be read!");
+
+        const bool isLast = in.eof();
+        const std::string_view text(window.data(), used);
+
+        // Complete lines only, until the end
+        const auto lastNewLine = text.rfind('\n');
+
+        if (!isLast && lastNewLine == std::string_view::npos)
+            continue;
+
+        const auto consumed = isLast ? used : lastNewLine + 1U;
+
+        if (!this->parseWindow(text.substr(0U, consumed)))
+            return false;
+
+        // Keep the incomplete line for the next window
+        std::memmove(window.data(), window.data() + consumed, used - consumed);
+        used -= consumed;
+
+        if (isLast)
+            break;
+
+    }
+
+    return this->finish();
+
+}
+
+// Read the whole text, from memory
+auto PeponReader::readMemory(std::string_view text) -> bool
+{
+
+    this->reset();
+
+    while (!text.empty())
+    {
+
+        // Windows end after a new line
+        auto size = std::min(text.size(), m_windowSize);
+
+        if (size < text.size())
+        {
+            auto newLine = text.rfind('\n', size - 1U);
+
+            if (newLine == std::string_view::npos)
+                newLine = text.find('\n', size);
+
+            size = (newLine == std::string_view::npos) ? text.size() : newLine + 1U;
+        }
+
+        if (!this->parseWindow(text.substr(0U, size)))
+            return false;
+
+        text.remove_prefix(size);
+
+    }
+
+    return this->finish();
+
+}
+
+
+// Back to the first line
+void PeponReader::reset()
+{
+    m_lineNumber = 0U;
+    m_hasGroup   = false;
+
+    m_state     = e_state::LINES;
+    m_startLine = 0U;
+    m_name.clear();
+    m_string.clear();
+    m_encoding = e_blobEncoding::NONE;
+}
+
+
+// Parses every line of the window
+auto PeponReader::parseWindow(std::string_view text) -> bool
+{
+
+    // Same first stage as PeponFile: structural characters of every line
+    m_index.build(text);
+
+    for (const auto& lineInfo : m_index.getLines())
+    {
+
+        ++m_lineNumber;
+
+        try
+        {
+            this->parseLine(IndexedLine(text, lineInfo));
+        }
+        catch (const SyntaxError& error)
+        {
+            if (!m_handler.onError(error, m_lineNumber))
+                return false;
+        }
+
+    }
+
+    return true;
+
+}
+
+
+// Parses one line: the same rules as PeponFile::parseChunk()
+void PeponReader::parseLine(const IndexedLine& indexed)
+{
+
+    constexpr auto STR_TOKEN_NOT_FOUND = std::string_view::npos;
+
+    const auto& info = indexed.info;
+    const auto  line = indexed.line;
+
+
+    // Inside a multiline string, every line is part of it
+    if (m_state == e_state::MULTILINE_STRING)
+    {
+
+        auto closeQuotationMark = indexed.position(info.closeQuote);
+
+        if (closeQuotationMark != STR_TOKEN_NOT_FOUND)
+        {
+            m_state = e_state::LINES;
+
+            m_string += line.substr(0, closeQuotationMark);
+            m_handler.onScalar(m_name, e_cppTypes::STRING_UTF8, m_string);
+
+            m_string.clear();
+        }
+        else
+        {
+            m_string += line;
+            m_string += '\n';
+        }
+
+        return;
+
+    }
+
+
+    // Comments
+    std::string_view comment;
+
+    if (isComment(indexed, comment))
+    {
+        m_handler.onComment(comment);
+        return;
+    }
+
+
+    // Inside a multiline container, only its closing bracket is expected
+    if (m_state == e_state::MULTILINE_CONTAINER)
+    {
+
+        auto closeCurlyBracket = indexed.position(info.closeCurly);
+
+        if (closeCurlyBracket != STR_TOKEN_NOT_FOUND)
+        {
+            m_state = e_state::LINES;
+
+            this->emitElements(line.substr(0, closeCurlyBracket));
+            m_handler.onContainerEnd();
+        }
+        else
+            this->emitElements(line);
+
+        return;
+
+    }
+
+
+    // [Group] (it must be the first thing in the line)
+    auto openBracket = indexed.position(info.openBracket);
+
+    if (openBracket == 0U)
+    {
+
+        auto closeBracket = indexed.position(info.closeBracket);
+
+        if (closeBracket == STR_TOKEN_NOT_FOUND)
+            throw SyntaxError("Syntax error: expected \']\' after group name");
+
+        m_hasGroup = true;
+        m_handler.onGroupBegin(myoga::trimStr(line.substr(1, closeBracket - 1)));
+
+        return;
+
+    }
+
+
+    // Variables
+    auto assignment = indexed.position(info.assignment);
+    auto colon      = indexed.position(info.colon);
+
+    if (assignment == STR_TOKEN_NOT_FOUND)
+        return;
+
+    if (!m_hasGroup)
+        throw SyntaxError("You cannot create variables without defining a [Group] first");
+
+    auto openCurlyBracket  = indexed.position(info.openCurly);
+    auto closeCurlyBracket = indexed.position(info.closeCurly);
+
+    bool hasOpenCurlyBracket   = (openCurlyBracket  != STR_TOKEN_NOT_FOUND);
+    bool hasClosedCurlyBracket = (closeCurlyBracket != STR_TOKEN_NOT_FOUND);
+
+
+    // Containers
+    if (hasOpenCurlyBracket)
+    {
+
+        auto nameAndType = getVarNameAndType(line, colon, assignment);
+        auto contAndType = getContainerAndType(nameAndType.second);
+
+        m_encoding = getBlobEncoding(line, assignment, openCurlyBracket);
+        m_handler.onContainerBegin(nameAndType.first, contAndType.first, contAndType.second, m_encoding);
+
+        // Single line container
+        if (hasClosedCurlyBracket)
+        {
+            this->emitElements(line.substr(openCurlyBracket + 1, closeCurlyBracket - openCurlyBracket - 1));
+            m_handler.onContainerEnd();
+        }
+        // Multiline container
+        else
+        {
+            m_state     = e_state::MULTILINE_CONTAINER;
+            m_startLine = m_lineNumber;
+            m_name      = nameAndType.first;
+
+            this->emitElements(line.substr(openCurlyBracket + 1));
+        }
+
+        return;
+
+    }
+
+    if (hasClosedCurlyBracket)
+        throw SyntaxError("Assignment. No open curly bracket, but closing. Did you mean to use '{' ?");
+
+
+    // Single values
+    auto nameAndType = getVarNameAndType(line, colon, assignment);
+    auto typeAsEnum  = stringTypeToEnum(nameAndType.second);
+
+    auto openQuotationMark  = indexed.position(info.openQuote);
+    auto closeQuotationMark = indexed.position(info.closeQuote);
+
+    bool hasOpeningQuotation = (openQuotationMark   != STR_TOKEN_NOT_FOUND);
+    bool hasClosingQuotation = ((closeQuotationMark != STR_TOKEN_NOT_FOUND) &&
+                                (closeQuotationMark > openQuotationMark));
+
+    if (hasOpeningQuotation && typeAsEnum != e_cppTypes::STRING_UTF8)
+        throw SyntaxError("Quotation marks should be used only for strings!");
+
+    // Single line string
+    if (hasOpeningQuotation && hasClosingQuotation)
+    {
+        m_handler.onScalar(nameAndType.first, typeAsEnum, line.substr(openQuotationMark + 1, closeQuotationMark - openQuotationMark - 1));
+    }
+    else
+    // Multiline string
+    if (hasOpeningQuotation)
+    {
+        m_state     = e_state::MULTILINE_STRING;
+        m_startLine = m_lineNumber;
+        m_name      = nameAndType.first;
+
+        m_string  = line.substr(openQuotationMark + 1);
+        m_string += '\n';
+    }
+    // Anything else
+    else
+    {
+        if (typeAsEnum == e_cppTypes::UNKNOWN)
+            throw SyntaxError("Unknown variable type for \'" + std::string(nameAndType.first) + '\'');
+
+        m_handler.onScalar(nameAndType.first, typeAsEnum, myoga::trimStr(line.substr(assignment + 1)));
+    }
+
+}
+
+
+// Container values (or a piece of a blob literal)
+void PeponReader::emitElements(std::string_view values)
+{
+
+    // Encoded text has no commas: the whole piece at once
+    if (m_encoding != e_blobEncoding::NONE)
+    {
+        values = myoga::trimStr(values);
+
+        if (!values.empty())
+            m_handler.onContainerElement(values);
+
+        return;
+    }
+
+    while (!values.empty())
+    {
+        const auto comma = values.find(',');
+        const auto value = myoga::trimStr(values.substr(0, comma));
+
+        // Skip empty values (ex: trailing commas)
+        if (!value.empty())
+            m_handler.onContainerElement(value);
+
+        if (comma == std::string_view::npos)
+            break;
+
+        values.remove_prefix(comma + 1);
+    }
+
+}
+
+
+// Unfinished multiline value?
+auto PeponReader::finish() -> bool
+{
+
+    if (m_state == e_state::LINES)
+        return true;
+
+    m_state = e_state::LINES;
+
+    const SyntaxError error("Syntax error: multiline value \'" + m_name + "\' starting at line " +
+                            std::to_string(m_startLine) + " is never closed");
+
+    return m_handler.onError(error, m_lineNumber);
+
+}
+
+} // pepon
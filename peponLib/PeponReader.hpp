@@ -0,0 +1,137 @@
+#ifndef PEPON_READER_HPP
+#define PEPON_READER_HPP
+
+#include <string>
+#include <istream>
+#include <string_view>
+
+#include "Pepon.hpp"
+#include "PeponConfig.hpp"
+#include "Parser/BlobCodec.hpp"
+#include "Parser/LineTokens.hpp"
+#include "Parser/StructuralIndex.hpp"
+
+// Library configuration
+#ifdef PEPON_USE_STL_PATH
+#include <filesystem>
+#endif
+
+namespace pepon
+{
+
+// Receives the events of a PeponReader, in file order
+// Every view is only valid during the call
+class PeponHandler
+{
+
+    public:
+
+        // dtor
+        virtual ~PeponHandler() = default;
+
+        // Comment line, without its comment characters
+        virtual void onComment([[maybe_unused]] std::string_view comment) {}
+
+        // [Group] declaration
+        virtual void onGroupBegin([[maybe_unused]] std::string_view name) {}
+
+        // Single value, not decoded (strings without their quotation marks)
+        virtual void onScalar([[maybe_unused]] std::string_view name, [[maybe_unused]] e_cppTypes type, [[maybe_unused]] std::string_view rawValue) {}
+
+        // Containers: begin, every element (trimmed text, not decoded), end
+        // Blob literals ("b64{...}", "hex{...}"): every element is a piece of the encoded text
+        virtual void onContainerBegin([[maybe_unused]] std::string_view name, [[maybe_unused]] std::string_view container,
+                                      [[maybe_unused]] e_cppTypes type, [[maybe_unused]] e_blobEncoding encoding) {}
+        virtual void onContainerElement([[maybe_unused]] std::string_view rawValue) {}
+        virtual void onContainerEnd() {}
+
+        // Syntax error at this line (the first line is 1)
+        // Return true to skip the line and go on, false to stop reading
+        // Throws the error by default
+        virtual auto onError(const SyntaxError& error, std::size_t lineNumber) -> bool;
+
+};
+
+
+// Streaming (SAX style) Pepon parser: calls a PeponHandler for every element of the text,
+// without building any Group or IVariable
+// Text is read and indexed by windows of about "windowSize" bytes, so memory use does not depend on the file size
+// (a window grows only to fit a line longer than itself, and multiline strings are kept until they end)
+class PeponReader
+{
+
+    public:
+
+    #ifdef PEPON_USE_STL_PATH
+        using t_filePath = std::filesystem::path;
+    #else
+        using t_filePath = std::string_view;
+    #endif
+
+        static constexpr std::size_t DEFAULT_WINDOW_SIZE = 1024U * 1024U;
+
+    public:
+
+        // ctor
+        explicit PeponReader(PeponHandler& handler, std::size_t windowSize = DEFAULT_WINDOW_SIZE);
+
+
+        // Read the whole text. Returns false if the handler stopped it (see PeponHandler::onError)
+        auto readFile(t_filePath fileName) -> bool;
+        auto readStream(std::istream& in) -> bool;
+        auto readMemory(std::string_view text) -> bool;
+
+
+    private:
+
+        enum class e_state
+        {
+            LINES,                  // Regular lines
+            MULTILINE_STRING,       // Inside a multiline string
+            MULTILINE_CONTAINER,    // Inside a multiline container
+        };
+
+    private:
+
+        // Back to the first line
+        void reset();
+
+        // Parses every line of the window (complete lines only)
+        // Returns false if the handler stopped reading
+        auto parseWindow(std::string_view text) -> bool;
+
+        // Parses one line. Throws SyntaxError
+        void parseLine(const IndexedLine& indexed);
+
+        // Container values (or a piece of a blob literal)
+        void emitElements(std::string_view values);
+
+        // Unfinished multiline value?
+        auto finish() -> bool;
+
+
+    private:
+
+        PeponHandler& m_handler;
+        std::size_t m_windowSize;
+
+        // Current line (the first line is 1)
+        std::size_t m_lineNumber = 0U;
+        bool m_hasGroup = false;
+
+        // Multiline values. The window moves: the name is copied
+        e_state m_state = e_state::LINES;
+        std::size_t m_startLine = 0U;
+        std::string m_name;
+        std::string m_string;
+        e_blobEncoding m_encoding = e_blobEncoding::NONE;
+
+        // Kept between windows, to reuse its memory
+        StructuralIndex m_index;
+
+};
+
+} // pepon
+
+
+#endif // PEPON_READER_HPP
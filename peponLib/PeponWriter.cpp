@@ -0,0 +1,104 @@
+#include "PeponWriter.hpp"
+
+namespace pepon
+{
+
+// ctor
+PeponWriter::PeponWriter(std::ostream& out, PeponSaveOptions options)
+    : m_out(out),
+      m_options(options)
+{
+}
+
+PeponWriter::PeponWriter(int fileDescriptor, PeponSaveOptions options)
+    : m_out(fileDescriptor),
+      m_options(options)
+{
+}
+
+PeponWriter::PeponWriter(std::string& memory, PeponSaveOptions options)
+    : m_out(memory),
+      m_options(options)
+{
+}
+
+
+// Same as PeponFile::useQuotation()
+void PeponWriter::useQuotation(PeponQuotes quotes)
+{
+    m_quotes = quotes;
+}
+
+
+// Comment line. Comments belong to the next group
+void PeponWriter::comment(std::string_view text, Group::e_commentStyle style)
+{
+
+    if (m_separate)
+    {
+        m_out.append('\n');
+        m_separate = false;
+    }
+
+    switch(style)
+    {
+        case Group::e_commentStyle::CPP:
+            m_out.append("// ");
+            break;
+        case Group::e_commentStyle::LUA:
+            m_out.append("-- ");
+            break;
+        case Group::e_commentStyle::PYTHON:
+            m_out.append("# ");
+            break;
+    };
+
+    m_out.append(text);
+    m_out.append('\n');
+
+}
+
+
+// [Group]. A group still open is ended first
+void PeponWriter::beginGroup(std::string_view name)
+{
+
+    if (m_inGroup)
+        this->endGroup();
+
+    if (m_separate)
+    {
+        m_out.append('\n');
+        m_separate = false;
+    }
+
+    m_out.append('[');
+    m_out.append(name);
+    m_out.append("]\n");
+
+    m_inGroup = true;
+
+}
+
+void PeponWriter::endGroup()
+{
+    m_inGroup  = false;
+    m_separate = true;
+}
+
+
+// Writes the buffered text to the sink
+void PeponWriter::flush()
+{
+    m_out.flush();
+}
+
+
+// Values can only be written inside a group
+void PeponWriter::checkGroup(std::string_view name) const
+{
+    if (!m_inGroup)
+        throw SyntaxError("Variable \'" + std::string(name) + "\' must be written inside a group");
+}
+
+} // pepon
@@ -0,0 +1,174 @@
+#ifndef PEPON_WRITER_HPP
+#define PEPON_WRITER_HPP
+
+#include <list>
+#include <deque>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <iterator>     // std::begin
+#include <string_view>
+#include <type_traits>
+
+#include "Pepon.hpp"
+#include "IO/OutputBuffer.hpp"
+#include "IO/ValueWriter.hpp"
+#include "Parser/BlobCodec.hpp"
+#include "Variables/Group.hpp"
+
+namespace pepon
+{
+
+namespace detail
+{
+
+// Types of Pepon values
+template <typename Type>
+constexpr bool IsPeponValue = std::is_same_v<Type, int> || std::is_same_v<Type, uint> || std::is_same_v<Type, bool> ||
+                              std::is_same_v<Type, float> || std::is_same_v<Type, double> ||
+                              std::is_same_v<Type, std::string> || std::is_same_v<Type, std::string_view>;
+
+} // detail
+
+
+// Writes Pepon text straight into a buffered sink (std::ostream, file descriptor or std::string),
+// without building any Group or PeponFile
+// Same format as PeponFile::saveFile()
+// Ex: writer.beginGroup("G"); writer.write("a", 1); writer.write("v", values); writer.endGroup();
+class PeponWriter
+{
+
+    public:
+
+        // ctor
+        explicit PeponWriter(std::ostream& out, PeponSaveOptions options = {});
+        // The descriptor is not closed
+        explicit PeponWriter(int fileDescriptor, PeponSaveOptions options = {});
+        // Text is appended to "memory"
+        explicit PeponWriter(std::string& memory, PeponSaveOptions options = {});
+
+
+        // Same as PeponFile::useQuotation()
+        void useQuotation(PeponQuotes quotes);
+
+        // Comment line. Comments belong to the next group
+        void comment(std::string_view text, Group::e_commentStyle style = Group::e_commentStyle::CPP);
+
+        // [Group]. A group still open is ended first
+        void beginGroup(std::string_view name);
+        void endGroup();
+
+        // Single value (int, uint, bool, float, double, strings)
+        // or any range of them: std::deque and std::list are written as such, anything else as a vector
+        // Throws SyntaxError outside of a group
+        template <typename Type>
+        void write(std::string_view name, const Type& value);
+
+        // Writes the buffered text to the sink
+        // Throws SyntaxError if the sink fails
+        void flush();
+
+
+    private:
+
+        // Text format name of a range
+        template <typename Range>
+        static constexpr auto getContainerName() noexcept -> std::string_view;
+
+        // Values can only be written inside a group
+        void checkGroup(std::string_view name) const;
+
+        // Container values
+        template <typename Range>
+        void writeRange(std::string_view name, const Range& values);
+
+
+    private:
+
+        OutputBuffer m_out;
+
+        PeponSaveOptions m_options;
+        PeponQuotes m_quotes;
+
+        bool m_inGroup  = false;
+        // Groups are separated by an empty line
+        bool m_separate = false;
+
+};
+
+
+// Template functions implementation:
+// Single value, or any range of them
+template <typename Type>
+void PeponWriter::write(std::string_view name, const Type& value)
+{
+
+    this->checkGroup(name);
+
+    if constexpr (std::is_convertible_v<const Type&, std::string_view>)
+    {
+        writeSingleValue(name, std::string_view(value), m_quotes, m_out);
+    }
+    else
+    if constexpr (std::is_arithmetic_v<Type>)
+    {
+        static_assert(detail::IsPeponValue<Type>, "Pepon values are int, uint, bool, float, double or strings");
+
+        writeSingleValue(name, value, m_quotes, m_out);
+    }
+    else
+    {
+        this->writeRange(name, value);
+    }
+
+}
+
+
+// Text format name of a range
+template <typename Range>
+constexpr auto PeponWriter::getContainerName() noexcept -> std::string_view
+{
+    using t_element = std::decay_t<decltype(*std::begin(std::declval<const Range&>()))>;
+
+    if constexpr (std::is_same_v<Range, std::deque<t_element>>)
+        return "deque";
+    else
+    if constexpr (std::is_same_v<Range, std::list<t_element>>)
+        return "list";
+    else
+        return "vector";
+}
+
+
+// Container values
+template <typename Range>
+void PeponWriter::writeRange(std::string_view name, const Range& values)
+{
+
+    using t_element = std::decay_t<decltype(*std::begin(values))>;
+
+    static_assert(detail::IsPeponValue<t_element>, "Pepon containers hold int, uint, bool, float, double or strings");
+
+
+    // Large contiguous numeric ranges: raw bytes, base64 encoded
+    constexpr bool isContiguous = std::is_same_v<Range, std::vector<t_element>> ||
+                                  std::is_same_v<Range, Span<t_element>> ||
+                                  std::is_same_v<Range, Span<const t_element>>;
+
+    if constexpr (isContiguous && isBlobType<t_element>)
+    {
+        if (m_options.binaryLiteralsFrom > 0U && values.size() >= m_options.binaryLiteralsFrom)
+        {
+            writeBlobLiteral<t_element>(name, { values.data(), values.size() }, m_out);
+            return;
+        }
+    }
+
+    writeContainerValues(name, getContainerName<Range>(), values, m_quotes, m_out);
+
+}
+
+} // pepon
+
+
+#endif // PEPON_WRITER_HPP
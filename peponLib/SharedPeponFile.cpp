@@ -0,0 +1,104 @@
+#include <thread>
+
+#include "SharedPeponFile.hpp"
+
+namespace pepon
+{
+
+// ctor
+// Starts with an empty snapshot
+SharedPeponFile::SharedPeponFile()
+    : m_current(new t_snapshot(std::make_shared<const PeponFile>()))
+{
+}
+
+// dtor
+SharedPeponFile::~SharedPeponFile()
+{
+    delete m_current.load();
+}
+
+
+// Current snapshot
+// Wait-free: the snapshot it copies is not released until this reader is counted out
+auto SharedPeponFile::get() const noexcept -> t_snapshot
+{
+
+    auto& readers = m_readers[m_epoch.load() % 2U];
+
+    readers.count.fetch_add(1U);
+    auto snapshot = *m_current.load();
+    readers.count.fetch_sub(1U);
+
+    return snapshot;
+
+}
+
+
+// Build a new snapshot, and publish it
+void SharedPeponFile::loadFile(PeponFile::t_filePath fileName, PeponLoadOptions options)
+{
+    auto file = std::make_shared<PeponFile>();
+    file->loadFile(fileName, options);
+
+    this->publish(std::move(file));
+}
+
+void SharedPeponFile::loadBinary(PeponFile::t_filePath fileName, PeponLoadOptions options)
+{
+    auto file = std::make_shared<PeponFile>();
+    file->loadBinary(fileName, options);
+
+    this->publish(std::move(file));
+}
+
+void SharedPeponFile::loadFromMemory(std::string_view text, PeponLoadOptions options)
+{
+    auto file = std::make_shared<PeponFile>();
+    file->loadFromMemory(text, options);
+
+    this->publish(std::move(file));
+}
+
+
+// Same as loadFile(), from another thread
+auto SharedPeponFile::reloadAsync(PeponFile::t_filePath fileName, PeponLoadOptions options) -> std::future<void>
+{
+
+    // The caller may not keep the name alive
+#ifdef PEPON_USE_STL_PATH
+    std::filesystem::path path(fileName);
+#else
+    std::string path(fileName);
+#endif
+
+    return std::async(std::launch::async, [this, path = std::move(path), options]()
+    {
+        this->loadFile(path, options);
+    });
+
+}
+
+
+// Publish a snapshot built by the caller
+// The previous one is released by its last reader
+void SharedPeponFile::publish(std::shared_ptr<PeponFile> file)
+{
+
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+
+    std::unique_ptr<const t_snapshot> previous(m_current.exchange(new t_snapshot(std::move(file))));
+
+    // A reader that loaded "previous" was counted (in either counter) before the exchange, and until it has copied it
+    // Each counter is drained after new readers moved to the other one, so readers cannot keep it from draining
+    for (int flip = 0; flip < 2; ++flip)
+    {
+        const auto& readers = m_readers[m_epoch.fetch_add(1U) % 2U];
+
+        while (readers.count.load() != 0U)
+            std::this_thread::yield();
+    }
+
+}
+
+} // pepon
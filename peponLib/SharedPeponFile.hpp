@@ -0,0 +1,80 @@
+#ifndef SHARED_PEPON_FILE_HPP
+#define SHARED_PEPON_FILE_HPP
+
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <cstdint>
+
+#include "PeponFile.hpp"
+
+namespace pepon
+{
+
+// Publishes immutable PeponFile snapshots to concurrent readers
+// A load builds a new snapshot aside, then swaps it in:
+// readers never wait for a load, and keep their snapshot alive as long as they use it
+// get() is wait-free: it takes no lock, only counts itself as a reader of the current epoch while it copies the snapshot
+// A publish waits for the readers that may still copy the previous snapshot (never for the ones that keep it), then releases it
+class SharedPeponFile
+{
+
+    public:
+
+        using t_snapshot = std::shared_ptr<const PeponFile>;
+
+    public:
+
+        // ctor
+        // Starts with an empty snapshot
+        SharedPeponFile();
+
+        // dtor
+        ~SharedPeponFile();
+
+        SharedPeponFile(const SharedPeponFile&) = delete;
+        auto operator=(const SharedPeponFile&) -> SharedPeponFile& = delete;
+
+
+        // Current snapshot
+        auto get() const noexcept -> t_snapshot;
+
+        // Build a new snapshot, and publish it
+        // If loading fails, the current snapshot stays
+        void loadFile(PeponFile::t_filePath fileName, PeponLoadOptions options = {});
+        void loadBinary(PeponFile::t_filePath fileName, PeponLoadOptions options = {});
+        void loadFromMemory(std::string_view text, PeponLoadOptions options = {});
+
+        // Same as loadFile(), from another thread
+        // The future reports when the new snapshot is published, or why loading failed
+        auto reloadAsync(PeponFile::t_filePath fileName, PeponLoadOptions options = {}) -> std::future<void>;
+
+        // Publish a snapshot built by the caller
+        void publish(std::shared_ptr<PeponFile> file);
+
+
+    private:
+
+        // Counter of the readers in get(), on its own cache line
+        struct alignas(64) ReaderCount
+        {
+            std::atomic<std::size_t> count { 0U };
+        };
+
+        // Readers copy the snapshot it points to: it is replaced, never modified
+        std::atomic<const t_snapshot*> m_current;
+
+        // Readers count themselves in m_readers[m_epoch % 2]. A publish moves new readers to the other counter
+        std::atomic<std::uint64_t> m_epoch { 0U };
+        mutable ReaderCount m_readers[2];
+
+        // One publish at a time
+        std::mutex m_publishMutex;
+
+};
+
+} // pepon
+
+
+#endif // SHARED_PEPON_FILE_HPP
@@ -0,0 +1,101 @@
+#include <bitset>
+
+#include "BitVector.hpp"
+
+namespace pepon
+{
+
+// "size" bits, set to "value"
+BitVector::BitVector(std::size_t size, bool value)
+    : m_words(wordCount(size), value ? ~t_word(0U) : t_word(0U)),
+      m_size(size)
+{
+    // Keep unused bits to 0
+    if (value && size % WORD_BITS != 0U)
+        m_words.back() &= (t_word(1U) << (size % WORD_BITS)) - 1U;
+}
+
+
+// The first "size" bits of these words
+BitVector::BitVector(std::vector<t_word> words, std::size_t size)
+    : m_words(std::move(words)),
+      m_size(size)
+{
+    m_words.resize(wordCount(size), 0U);
+
+    // Keep unused bits to 0
+    if (size % WORD_BITS != 0U)
+        m_words.back() &= (t_word(1U) << (size % WORD_BITS)) - 1U;
+}
+
+
+// Number of true bits
+auto BitVector::count() const noexcept -> std::size_t
+{
+
+    std::size_t result = 0U;
+
+    for (const auto word : m_words)
+        result += std::bitset<WORD_BITS>(word).count();
+
+    return result;
+
+}
+
+
+// Bulk access: (size() + 63) / 64 words
+auto BitVector::getWords() const noexcept -> Span<const t_word>
+{
+    return { m_words.data(), m_words.size() };
+}
+
+
+void BitVector::set(std::size_t index, bool value) noexcept
+{
+
+    const auto mask = t_word(1U) << (index % WORD_BITS);
+
+    if (value)
+        m_words[index / WORD_BITS] |= mask;
+    else
+        m_words[index / WORD_BITS] &= ~mask;
+
+}
+
+
+void BitVector::push_back(bool value)
+{
+
+    if (m_size % WORD_BITS == 0U)
+        m_words.push_back(0U);
+
+    m_words.back() |= t_word(value) << (m_size % WORD_BITS);
+    ++m_size;
+
+}
+
+
+void BitVector::reserve(std::size_t size)
+{
+    m_words.reserve(wordCount(size));
+}
+
+
+void BitVector::clear() noexcept
+{
+    m_words.clear();
+    m_size = 0U;
+}
+
+
+auto BitVector::operator==(const BitVector& other) const noexcept -> bool
+{
+    return m_size == other.m_size && m_words == other.m_words;
+}
+
+auto BitVector::operator!=(const BitVector& other) const noexcept -> bool
+{
+    return !(*this == other);
+}
+
+} // pepon
@@ -0,0 +1,115 @@
+#ifndef BIT_VECTOR_UTILS_HPP
+#define BIT_VECTOR_UTILS_HPP
+
+#include <vector>
+#include <cstdint>
+#include <iterator>
+
+#include "Span.hpp"
+
+namespace pepon
+{
+
+// Bit packed booleans, 64 per word (bit i is bit i % 64 of word i / 64)
+// Stores Pepon vector<bool> values
+// Unused bits of the last word are always 0
+class BitVector
+{
+
+    public:
+
+        using value_type = bool;
+        using t_word     = std::uint64_t;
+
+        static constexpr std::size_t WORD_BITS = 64U;
+
+        // Words holding "bits" bits. Never overflows, whatever "bits" is
+        static constexpr auto wordCount(std::uint64_t bits) noexcept -> std::uint64_t { return bits / WORD_BITS + (bits % WORD_BITS != 0U); }
+
+
+        // Reads bits in order
+        class const_iterator
+        {
+
+            public:
+
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = bool;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = void;
+                using reference         = bool;
+
+                const_iterator() noexcept = default;
+                const_iterator(const BitVector* bits, std::size_t index) noexcept
+                    : m_bits(bits),
+                      m_index(index)
+                {
+                }
+
+                auto operator*() const noexcept -> bool                      { return (*m_bits)[m_index]; }
+                auto operator++() noexcept -> const_iterator&                { ++m_index; return *this; }
+                auto operator++(int) noexcept -> const_iterator              { auto copy = *this; ++m_index; return copy; }
+
+                auto operator==(const const_iterator& other) const noexcept -> bool { return m_index == other.m_index; }
+                auto operator!=(const const_iterator& other) const noexcept -> bool { return m_index != other.m_index; }
+
+            private:
+
+                const BitVector* m_bits = nullptr;
+                std::size_t m_index = 0U;
+
+        };
+
+        using iterator = const_iterator;
+
+    public:
+
+        // ctor
+        BitVector() = default;
+        // "size" bits, set to "value"
+        explicit BitVector(std::size_t size, bool value = false);
+        // The first "size" bits of these words
+        BitVector(std::vector<t_word> words, std::size_t size);
+
+
+        // Getters:
+        auto size() const noexcept -> std::size_t   { return m_size; }
+        auto empty() const noexcept -> bool         { return m_size == 0U; }
+
+        auto operator[](std::size_t index) const noexcept -> bool
+        {
+            return (m_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1U;
+        }
+
+        // Number of true bits
+        auto count() const noexcept -> std::size_t;
+
+        // Bulk access: (size() + 63) / 64 words
+        auto getWords() const noexcept -> Span<const t_word>;
+
+        auto begin() const noexcept -> const_iterator  { return { this, 0U }; }
+        auto end() const noexcept -> const_iterator    { return { this, m_size }; }
+
+
+        // Setters:
+        void set(std::size_t index, bool value) noexcept;
+        void push_back(bool value);
+        void reserve(std::size_t size);
+        void clear() noexcept;
+
+
+        auto operator==(const BitVector& other) const noexcept -> bool;
+        auto operator!=(const BitVector& other) const noexcept -> bool;
+
+
+    private:
+
+        std::vector<t_word> m_words;
+        std::size_t m_size = 0U;
+
+};
+
+} // pepon
+
+
+#endif // BIT_VECTOR_UTILS_HPP
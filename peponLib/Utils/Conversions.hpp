@@ -0,0 +1,56 @@
+#ifndef CONVERSIONS_UTILS_HPP
+#define CONVERSIONS_UTILS_HPP
+
+#include <limits>
+#include <algorithm>    // std::copy_n, std::min
+#include <iterator>     // std::next
+#include <type_traits>
+
+namespace pepon
+{
+
+// Is every "From" value exactly representable as a "To"?
+// Ex: int -> long, uint -> long, float -> double, int -> double
+template <typename From, typename To>
+constexpr bool isWidening = []
+{
+    if constexpr (std::is_same_v<From, To>)
+        return true;
+    else
+    if constexpr (std::is_same_v<From, bool> || std::is_same_v<To, bool> || !std::is_arithmetic_v<From> || !std::is_arithmetic_v<To>)
+        return false;
+    else
+    if constexpr (std::is_floating_point_v<From>)
+        return std::is_floating_point_v<To> && std::numeric_limits<To>::digits >= std::numeric_limits<From>::digits;
+    else
+    if constexpr (std::is_floating_point_v<To>)
+        return std::numeric_limits<To>::digits >= std::numeric_limits<From>::digits;
+    else
+    if constexpr (std::is_signed_v<From>)
+        return std::is_signed_v<To> && std::numeric_limits<To>::digits >= std::numeric_limits<From>::digits;
+    else
+        return std::numeric_limits<To>::digits >= std::numeric_limits<From>::digits;
+}();
+
+
+// Copies up to "count" values into "dest", converted to "To"
+// Returns the number of values copied
+template <typename Container, typename To>
+auto copyValues(const Container& values, To* dest, std::size_t count) -> std::size_t
+{
+
+    static_assert(isWidening<typename Container::value_type, To>, "Values would not be copied exactly");
+
+    const auto copied = std::min(count, static_cast<std::size_t>(values.size()));
+
+    // Vectors and deques are copied in blocks (same type: memmove)
+    std::copy_n(values.begin(), copied, dest);
+
+    return copied;
+
+}
+
+} // pepon
+
+
+#endif // CONVERSIONS_UTILS_HPP
@@ -0,0 +1,39 @@
+#ifndef ENDIAN_UTILS_HPP
+#define ENDIAN_UTILS_HPP
+
+#include <cstdint>
+#include <cstring>      // std::memcpy
+#include <algorithm>    // std::reverse
+
+namespace pepon
+{
+
+// Raw values (binary images, blob literals) are stored little endian
+inline auto isLittleEndian() noexcept -> bool
+{
+    const std::uint32_t value = 1U;
+
+    unsigned char first;
+    std::memcpy(&first, &value, 1U);
+
+    return first == 1U;
+}
+
+// Reverse the bytes of every value, in place
+template <typename Type>
+void byteSwap(Type* values, std::size_t count) noexcept
+{
+    for (std::size_t i = 0U; i < count; ++i)
+    {
+        unsigned char bytes[sizeof(Type)];
+
+        std::memcpy(bytes, &values[i], sizeof(Type));
+        std::reverse(bytes, bytes + sizeof(Type));
+        std::memcpy(&values[i], bytes, sizeof(Type));
+    }
+}
+
+} // pepon
+
+
+#endif // ENDIAN_UTILS_HPP
@@ -0,0 +1,96 @@
+#ifndef HASH_UTILS_HPP
+#define HASH_UTILS_HPP
+
+#include <cstdint>
+#include <cstring>      // std::memcpy
+#include <string_view>
+
+namespace pepon
+{
+
+namespace detail
+{
+
+constexpr std::uint64_t HASH_PRIME_1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t HASH_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t HASH_PRIME_3 = 0x165667B19E3779F9ULL;
+
+constexpr auto rotateLeft(std::uint64_t value, unsigned bits) noexcept -> std::uint64_t
+{
+    return (value << bits) | (value >> (64U - bits));
+}
+
+// One 8 bytes word into a lane
+constexpr auto hashRound(std::uint64_t lane, std::uint64_t word) noexcept -> std::uint64_t
+{
+    return rotateLeft(lane + word * HASH_PRIME_2, 31U) * HASH_PRIME_1;
+}
+
+inline auto loadWord(const char* data) noexcept -> std::uint64_t
+{
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+
+    return word;
+}
+
+} // detail
+
+
+// Fast, non cryptographic, 64 bits hash of a whole buffer (file contents)
+// Four independent lanes of 8 bytes words, so it runs at memory speed
+// Not stable across hosts of different endianness: only use it for local caches
+inline auto hashBytes(std::string_view bytes, std::uint64_t seed = 0U) noexcept -> std::uint64_t
+{
+
+    using namespace detail;
+
+    const char* data = bytes.data();
+    std::size_t size = bytes.size();
+
+    std::uint64_t hash;
+
+    if (size >= 32U)
+    {
+        std::uint64_t lanes[4] = { seed + HASH_PRIME_1 + HASH_PRIME_2, seed + HASH_PRIME_2, seed, seed - HASH_PRIME_1 };
+
+        for (; size >= 32U; data += 32U, size -= 32U)
+        {
+            lanes[0] = hashRound(lanes[0], loadWord(data));
+            lanes[1] = hashRound(lanes[1], loadWord(data + 8U));
+            lanes[2] = hashRound(lanes[2], loadWord(data + 16U));
+            lanes[3] = hashRound(lanes[3], loadWord(data + 24U));
+        }
+
+        hash = rotateLeft(lanes[0], 1U) + rotateLeft(lanes[1], 7U) + rotateLeft(lanes[2], 12U) + rotateLeft(lanes[3], 18U);
+
+        for (auto lane : lanes)
+            hash = (hash ^ hashRound(0U, lane)) * HASH_PRIME_1 + HASH_PRIME_3;
+    }
+    else
+        hash = seed + HASH_PRIME_3;
+
+    hash += static_cast<std::uint64_t>(bytes.size());
+
+    // Tail: words, then bytes
+    for (; size >= 8U; data += 8U, size -= 8U)
+        hash = rotateLeft(hash ^ hashRound(0U, loadWord(data)), 27U) * HASH_PRIME_1 + HASH_PRIME_3;
+
+    for (; size > 0U; ++data, --size)
+        hash = rotateLeft(hash ^ (static_cast<unsigned char>(*data) * HASH_PRIME_3), 11U) * HASH_PRIME_1;
+
+    // Final mix
+    hash ^= hash >> 33U;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29U;
+    hash *= HASH_PRIME_3;
+    hash ^= hash >> 32U;
+
+    return hash;
+
+}
+
+} // pepon
+
+
+#endif // HASH_UTILS_HPP
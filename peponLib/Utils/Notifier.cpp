@@ -0,0 +1,91 @@
+#include "Notifier.hpp"
+
+namespace pepon
+{
+
+// ctor. Starts its thread
+Notifier::Notifier()
+
+    : m_thread([this]() { this->run(); })
+{
+}
+
+
+// dtor. Runs the pending tasks, then joins its thread
+Notifier::~Notifier()
+{
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_wake.notify_one();
+    m_thread.join();
+
+}
+
+
+// Queue a task
+void Notifier::post(t_task task)
+{
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+
+    m_wake.notify_one();
+
+}
+
+// Wait until every task posted so far has run
+void Notifier::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_idle.wait(lock, [this]() { return m_tasks.empty() && !m_busy; });
+}
+
+
+// Thread loop
+void Notifier::run()
+{
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+
+        m_wake.wait(lock, [this]() { return !m_tasks.empty() || m_stop; });
+
+        // Stop only when everything has run
+        if (m_tasks.empty())
+            break;
+
+        auto task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+
+        m_busy = true;
+        lock.unlock();
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            // A task cannot stop the others
+        }
+
+        lock.lock();
+        m_busy = false;
+
+        if (m_tasks.empty())
+            m_idle.notify_all();
+
+    }
+
+}
+
+} // pepon
@@ -0,0 +1,65 @@
+#ifndef NOTIFIER_UTILS_HPP
+#define NOTIFIER_UTILS_HPP
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+namespace pepon
+{
+
+// Runs tasks in order, on its own thread, so the thread posting them never waits for them
+// Exceptions thrown by tasks are ignored
+class Notifier
+{
+
+    public:
+
+        using t_task = std::function<void()>;
+
+    public:
+
+        // ctor. Starts its thread
+        Notifier();
+
+        // dtor. Runs the pending tasks, then joins its thread
+        ~Notifier();
+
+        Notifier(const Notifier&) = delete;
+        auto operator=(const Notifier&) = delete;
+
+
+        // Queue a task
+        void post(t_task task);
+
+        // Wait until every task posted so far has run
+        // Never call it from a task
+        void wait();
+
+
+    private:
+
+        // Thread loop
+        void run();
+
+
+    private:
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+
+        std::deque<t_task> m_tasks;
+        bool m_busy = false;
+        bool m_stop = false;
+
+        std::thread m_thread;
+
+};
+
+} // pepon
+
+
+#endif // NOTIFIER_UTILS_HPP
@@ -0,0 +1,149 @@
+#ifndef PARALLEL_UTILS_HPP
+#define PARALLEL_UTILS_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+#include "ThreadPool.hpp"
+
+namespace pepon
+{
+
+// Number of threads to use. 0 means "one per hardware thread"
+inline auto resolveThreadCount(unsigned requested) noexcept -> unsigned
+{
+    if (requested != 0U)
+        return requested;
+
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+
+namespace detail
+{
+
+// One parallelFor() call, shared with the pool threads that help it
+struct ParallelJob
+{
+    std::mutex mutex;
+    std::condition_variable done;
+
+    // Closed when the caller has finished: helpers that start later do nothing
+    bool isClosed = false;
+
+    // Helpers running "work"
+    unsigned active = 0U;
+
+    std::function<void()> work;
+};
+
+} // detail
+
+
+// Runs task(index) for every index in [0, count), using up to "threads" threads of the ThreadPool
+// The calling thread works too, so nested calls never wait for a free pool thread.
+// The first exception thrown by a task is rethrown here, after every helper has finished
+template <typename Task>
+void parallelFor(std::size_t count, unsigned threads, Task&& task)
+{
+
+    // Not worth it
+    if (threads <= 1U || count <= 1U)
+    {
+        for (std::size_t index = 0U; index < count; ++index)
+            task(index);
+
+        return;
+    }
+
+
+    std::atomic<std::size_t> next { 0U };
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto worker = [&]()
+    {
+        for (std::size_t index = next++; index < count; index = next++)
+        {
+            try
+            {
+                task(index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+
+                if (!error)
+                    error = std::current_exception();
+
+                // Stop everyone
+                next = count;
+            }
+        }
+    };
+
+
+    auto job = std::make_shared<detail::ParallelJob>();
+    job->work = worker;
+
+    auto& pool = ThreadPool::getInstance();
+    const auto helpers = std::min<std::size_t>({ threads - 1U, count - 1U, pool.size() });
+
+    for (std::size_t i = 0U; i < helpers; ++i)
+    {
+        try
+        {
+            pool.post([job]()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(job->mutex);
+
+                    if (job->isClosed)
+                        return;
+
+                    ++job->active;
+                }
+
+                job->work();
+
+                {
+                    std::lock_guard<std::mutex> lock(job->mutex);
+                    --job->active;
+                }
+
+                job->done.notify_all();
+            });
+        }
+        catch (...)
+        {
+            // Out of memory: fewer helpers
+            break;
+        }
+    }
+
+    worker();
+
+    // Wait for the helpers still running: the others will not start
+    {
+        std::unique_lock<std::mutex> lock(job->mutex);
+
+        job->isClosed = true;
+        job->done.wait(lock, [&job]() { return job->active == 0U; });
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+}
+
+} // pepon
+
+
+#endif // PARALLEL_UTILS_HPP
@@ -0,0 +1,52 @@
+#ifndef SPAN_UTILS_HPP
+#define SPAN_UTILS_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace pepon
+{
+
+// Non owning view of contiguous elements (std::span is C++20)
+template <typename Type>
+class Span
+{
+
+    public:
+
+        using element_type = Type;
+        using value_type   = std::remove_cv_t<Type>;
+        using iterator     = Type*;
+
+    public:
+
+        // ctor
+        constexpr Span() noexcept = default;
+        constexpr Span(Type* data, std::size_t size) noexcept
+            : m_data(data),
+              m_size(size)
+        {
+        }
+
+        // Getters:
+        constexpr auto data() const noexcept -> Type*         { return m_data; }
+        constexpr auto size() const noexcept -> std::size_t   { return m_size; }
+        constexpr auto empty() const noexcept -> bool         { return m_size == 0U; }
+
+        constexpr auto operator[](std::size_t index) const noexcept -> Type& { return m_data[index]; }
+
+        constexpr auto begin() const noexcept -> iterator     { return m_data; }
+        constexpr auto end() const noexcept -> iterator       { return m_data + m_size; }
+
+
+    private:
+
+        Type* m_data = nullptr;
+        std::size_t m_size = 0U;
+
+};
+
+} // pepon
+
+
+#endif // SPAN_UTILS_HPP
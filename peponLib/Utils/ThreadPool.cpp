@@ -0,0 +1,112 @@
+#include <system_error>
+
+#include "ThreadPool.hpp"
+
+namespace pepon
+{
+
+// Shared by the whole process: one thread per hardware thread, but the caller's
+auto ThreadPool::getInstance() -> ThreadPool&
+{
+    static ThreadPool pool(std::thread::hardware_concurrency() > 1U ? std::thread::hardware_concurrency() - 1U : 1U);
+
+    return pool;
+}
+
+
+// ctor. Starts up to "threads" threads
+ThreadPool::ThreadPool(unsigned threads)
+{
+
+    m_threads.reserve(threads);
+
+    for (unsigned i = 0U; i < threads; ++i)
+    {
+        try
+        {
+            m_threads.emplace_back([this]() { this->run(); });
+        }
+        catch (const std::system_error&)
+        {
+            // Out of threads: the ones already started do the work
+            break;
+        }
+    }
+
+}
+
+
+// dtor. Runs the pending tasks, then joins every thread
+ThreadPool::~ThreadPool()
+{
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_wake.notify_all();
+
+    for (auto& thread : m_threads)
+        thread.join();
+
+}
+
+
+// Number of threads. 0 if none could be started
+auto ThreadPool::size() const noexcept -> unsigned
+{
+    return static_cast<unsigned>(m_threads.size());
+}
+
+
+// Queue a task
+void ThreadPool::post(t_task task)
+{
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+
+    m_wake.notify_one();
+
+}
+
+
+// Thread loop
+void ThreadPool::run()
+{
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+
+        m_wake.wait(lock, [this]() { return !m_tasks.empty() || m_stop; });
+
+        // Stop only when everything has run
+        if (m_tasks.empty())
+            break;
+
+        auto task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+
+        lock.unlock();
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            // A task cannot stop the pool
+        }
+
+        lock.lock();
+
+    }
+
+}
+
+} // pepon
@@ -0,0 +1,66 @@
+#ifndef THREAD_POOL_UTILS_HPP
+#define THREAD_POOL_UTILS_HPP
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+namespace pepon
+{
+
+// Worker threads, created once and reused by every parallelFor() (see Utils/Parallel.hpp)
+// Tasks run in any order. Exceptions thrown by tasks are ignored: tasks report their own errors
+class ThreadPool
+{
+
+    public:
+
+        using t_task = std::function<void()>;
+
+    public:
+
+        // Shared by the whole process: one thread per hardware thread, but the caller's
+        static auto getInstance() -> ThreadPool&;
+
+        // ctor. Starts up to "threads" threads: if the system cannot start one, the pool works with fewer
+        explicit ThreadPool(unsigned threads);
+
+        // dtor. Runs the pending tasks, then joins every thread
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        auto operator=(const ThreadPool&) = delete;
+
+
+        // Number of threads. 0 if none could be started
+        auto size() const noexcept -> unsigned;
+
+        // Queue a task
+        void post(t_task task);
+
+
+    private:
+
+        // Thread loop
+        void run();
+
+
+    private:
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+
+        std::deque<t_task> m_tasks;
+        bool m_stop = false;
+
+        std::vector<std::thread> m_threads;
+
+};
+
+} // pepon
+
+
+#endif // THREAD_POOL_UTILS_HPP
@@ -0,0 +1,119 @@
+#include "CompactValue.hpp"
+#include "../Parser/BlobCodec.hpp"
+
+namespace pepon
+{
+
+namespace
+{
+
+// print() formats one value at a time
+constexpr std::size_t PRINT_BUFFER_CAPACITY = 4096U;
+
+
+template <typename Type>
+struct IsVector : std::false_type {};
+
+template <typename Type>
+struct IsVector<std::vector<Type>> : std::true_type {};
+
+
+template <typename Type>
+constexpr bool isSingleValue = std::is_arithmetic_v<Type> || std::is_same_v<Type, std::string_view>;
+
+
+// Text of a value: the same helpers as IVariable::write()
+void writeValue(const CompactVariable& variable, const PeponQuotes& quotes, OutputBuffer& out)
+{
+    visitValue(variable.value, [&variable, &quotes, &out](const auto& value)
+    {
+        using t_value = std::decay_t<decltype(value)>;
+
+        if constexpr (isSingleValue<t_value>)
+        {
+            writeSingleValue(variable.name, value, quotes, out);
+        }
+        else
+        {
+            switch (ValueTraits<t_value>::getVarType())
+            {
+                case IVariable::e_varType::DEQUE:
+                    writeContainerValues(variable.name, "deque", value, quotes, out);
+                    break;
+
+                case IVariable::e_varType::LIST:
+                    writeContainerValues(variable.name, "list", value, quotes, out);
+                    break;
+
+                default:
+                    writeContainerValues(variable.name, "vector", value, quotes, out);
+                    break;
+            }
+        }
+    });
+}
+
+} // anonymous namespace
+
+
+// Kind of value
+auto getVarType(const t_compactValue& value) noexcept -> IVariable::e_varType
+{
+    return visitValue(value, [](const auto& typed)
+    {
+        return ValueTraits<std::decay_t<decltype(typed)>>::getVarType();
+    });
+}
+
+auto getCppType(const t_compactValue& value) noexcept -> e_cppTypes
+{
+    return visitValue(value, [](const auto& typed)
+    {
+        return ValueTraits<std::decay_t<decltype(typed)>>::getCppType();
+    });
+}
+
+
+// Same format as IVariable::write()
+void print(const CompactVariable& variable, const PeponQuotes& quotes, std::ostream& out)
+{
+    OutputBuffer buffer(out, PRINT_BUFFER_CAPACITY);
+
+    writeValue(variable, quotes, buffer);
+    buffer.flush();
+}
+
+void write(const CompactVariable& variable, const PeponQuotes& quotes, const PeponSaveOptions& options, OutputBuffer& out)
+{
+
+    // Large numeric vectors: raw bytes, base64 encoded
+    if (options.binaryLiteralsFrom > 0U)
+    {
+        const bool isBlob = std::visit([&variable, &options, &out](const auto& value)
+        {
+            using t_value = std::decay_t<decltype(value)>;
+
+            if constexpr (IsVector<t_value>::value)
+            {
+                if constexpr (isBlobType<typename t_value::value_type>)
+                {
+                    if (value.size() >= options.binaryLiteralsFrom)
+                    {
+                        writeBlobLiteral<typename t_value::value_type>(variable.name, { value.data(), value.size() }, out);
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }, variable.value);
+
+        if (isBlob)
+            return;
+    }
+
+    writeValue(variable, quotes, out);
+
+}
+
+} // pepon
@@ -0,0 +1,166 @@
+#ifndef COMPACT_VALUE_HPP
+#define COMPACT_VALUE_HPP
+
+#include <list>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <variant>
+#include <type_traits>
+
+#include "IVariable.hpp"
+
+namespace pepon
+{
+
+// Deques and BitVectors are bigger than any other value: they live on the heap,
+// so every compact value fits in 32 bytes
+template <typename Type>
+using t_boxedDeque = std::unique_ptr<std::deque<Type>>;
+
+using t_boxedBits = std::unique_ptr<BitVector>;
+
+
+// Every supported value, stored inline
+using t_compactValue = std::variant<int, uint, bool, float, double, std::string_view,
+                                    std::vector<int>, std::vector<uint>, t_boxedBits, std::vector<float>, std::vector<double>, std::vector<std::string>,
+                                    t_boxedDeque<int>, t_boxedDeque<uint>, t_boxedDeque<bool>, t_boxedDeque<float>, t_boxedDeque<double>, t_boxedDeque<std::string>,
+                                    std::list<int>, std::list<uint>, std::list<bool>, std::list<float>, std::list<double>, std::list<std::string>>;
+
+static_assert(sizeof(t_compactValue) <= 32U, "Compact values must fit in 32 bytes: box the bigger alternatives");
+
+
+// Variable of a compact group: no IVariable, no std::any, no allocation for single values
+// The name is not copied: it MUST outlive this variable
+struct CompactVariable
+{
+    std::string_view name;
+    t_compactValue value;
+};
+
+
+// Kind of value of every C++ type
+template <typename Type>
+struct ValueTraits
+{
+    static auto getVarType() noexcept -> IVariable::e_varType { return IVariable::e_varType::SINGLE_VALUE; }
+    static auto getCppType() noexcept -> e_cppTypes           { return getTypeEnum<Type>(); }
+};
+
+template <typename Type>
+struct ValueTraits<std::vector<Type>>
+{
+    static auto getVarType() noexcept -> IVariable::e_varType { return IVariable::e_varType::VECTOR; }
+    static auto getCppType() noexcept -> e_cppTypes           { return getTypeEnum<Type>(); }
+};
+
+template <>
+struct ValueTraits<BitVector>
+{
+    static auto getVarType() noexcept -> IVariable::e_varType { return IVariable::e_varType::VECTOR; }
+    static auto getCppType() noexcept -> e_cppTypes           { return e_cppTypes::BOOL; }
+};
+
+template <typename Type>
+struct ValueTraits<std::deque<Type>>
+{
+    static auto getVarType() noexcept -> IVariable::e_varType { return IVariable::e_varType::DEQUE; }
+    static auto getCppType() noexcept -> e_cppTypes           { return getTypeEnum<Type>(); }
+};
+
+template <typename Type>
+struct ValueTraits<std::list<Type>>
+{
+    static auto getVarType() noexcept -> IVariable::e_varType { return IVariable::e_varType::LIST; }
+    static auto getCppType() noexcept -> e_cppTypes           { return getTypeEnum<Type>(); }
+};
+
+
+namespace detail
+{
+
+template <typename Type, typename Variant>
+struct IsAlternative : std::false_type {};
+
+template <typename Type, typename... Types>
+struct IsAlternative<Type, std::variant<Types...>> : std::disjunction<std::is_same<Type, Types>...> {};
+
+template <typename Type>
+struct IsDeque : std::false_type {};
+
+template <typename Type>
+struct IsDeque<std::deque<Type>> : std::true_type {};
+
+// Values stored on the heap
+template <typename Type>
+struct NeedsBox : IsDeque<Type> {};
+
+template <>
+struct NeedsBox<BitVector> : std::true_type {};
+
+template <typename Type>
+struct IsBoxed : std::false_type {};
+
+template <typename Type>
+struct IsBoxed<std::unique_ptr<Type>> : std::true_type {};
+
+} // detail
+
+
+// Makes a compact value from a typed value
+template <typename Type>
+auto makeCompactValue(Type value) -> t_compactValue
+{
+    if constexpr (detail::NeedsBox<Type>::value)
+        return std::make_unique<Type>(std::move(value));
+    else
+        return value;
+}
+
+
+// Calls visitor(value) with the typed value:
+// const Type& for single values, const std::vector<Type>& (or deque, list) for containers
+// vector<bool> values are a const BitVector&
+template <typename Visitor>
+decltype(auto) visitValue(const t_compactValue& value, Visitor&& visitor)
+{
+    return std::visit([&visitor](const auto& alternative) -> decltype(auto)
+    {
+        if constexpr (detail::IsBoxed<std::decay_t<decltype(alternative)>>::value)
+            return visitor(*alternative);
+        else
+            return visitor(alternative);
+    }, value);
+}
+
+
+// Pointer to the value if it is a "Type", or nullptr
+template <typename Type>
+auto getIf(const t_compactValue& value) noexcept -> const Type*
+{
+    if constexpr (detail::NeedsBox<Type>::value)
+    {
+        const auto* boxed = std::get_if<std::unique_ptr<Type>>(&value);
+        return (boxed != nullptr) ? boxed->get() : nullptr;
+    }
+    else
+    if constexpr (detail::IsAlternative<Type, t_compactValue>::value)
+        return std::get_if<Type>(&value);
+    else
+        return nullptr;
+}
+
+
+// Kind of value
+auto getVarType(const t_compactValue& value) noexcept -> IVariable::e_varType;
+auto getCppType(const t_compactValue& value) noexcept -> e_cppTypes;
+
+// Same format as IVariable::write() (print() writes to "out" through an OutputBuffer)
+void print(const CompactVariable& variable, const PeponQuotes& quotes, std::ostream& out = std::cout);
+void write(const CompactVariable& variable, const PeponQuotes& quotes, const PeponSaveOptions& options, OutputBuffer& out);
+
+} // pepon
+
+
+#endif // COMPACT_VALUE_HPP
@@ -4,6 +4,8 @@
 #include <deque>
 
 #include "IVariable.hpp"
+#include "../Parser/ValueDecoder.hpp"
+#include "../Utils/Conversions.hpp"
 
 namespace pepon
 {
@@ -14,15 +16,23 @@ class DequeValue final : public IVariable
     public:
 
         // ctor
-        DequeValue(std::string name, std::deque<Type> container);
+        DequeValue(Name name, std::deque<Type> container);
+        // Lazy value, decoded on first access
+        // Values of a binary image have their own decoder
+        DequeValue(Name name, RawValue raw, t_decoder decoder = &decodeAny<std::deque<Type>>);
 
         // Virtual functions override
-        void print(const PeponQuotes& quotes, std::ostream& out = std::cout) const override;
+        void write(const PeponQuotes& quotes, const PeponSaveOptions& options, OutputBuffer& out) const override;
 
 
         // Getters:
-        auto get() noexcept -> std::deque<Type>&;
-        auto get() const noexcept -> const std::deque<Type>&;
+        auto get() -> std::deque<Type>&;
+        auto get() const -> const std::deque<Type>&;
+
+        // Copies up to "count" values into "dest", converted to "To" (only exact conversions)
+        // Returns the number of values copied
+        template <typename To>
+        auto copyTo(To* dest, std::size_t count) const -> std::size_t;
 
 };
 
@@ -30,7 +40,7 @@ class DequeValue final : public IVariable
 // Template functions implementation:
 // ctor
 template <typename Type>
-DequeValue<Type>::DequeValue(std::string name, std::deque<Type> container)
+DequeValue<Type>::DequeValue(Name name, std::deque<Type> container)
 
     : IVariable(std::move(name),
                 IVariable::e_varType::DEQUE,
@@ -39,51 +49,53 @@ DequeValue<Type>::DequeValue(std::string name, std::deque<Type> container)
 {
 }
 
-
 template <typename Type>
-void DequeValue<Type>::print(const PeponQuotes& quotes, std::ostream& out) const
-{
-    out << m_name << " : deque<"
-        << getTypeName<Type>()
-        << "> = { ";
-
-    const auto& container = std::any_cast<const std::deque<Type>&>(m_value);
-    std::size_t shown = 0U;
-
-    for (const auto& elem : container)
-    {
-        if (quotes.useQuotes)
-            out << quotes.quotesChar;
-
-        if (m_cppType == e_cppTypes::BOOL)
-            out << std::boolalpha << elem;
-        else
-            out << elem;
+DequeValue<Type>::DequeValue(Name name, RawValue raw, t_decoder decoder)
 
-        if (quotes.useQuotes)
-            out << quotes.quotesChar;
+    : IVariable(std::move(name),
+                IVariable::e_varType::DEQUE,
+                getTypeEnum<Type>(),
+                raw,
+                decoder)
+{
+}
 
-        if (shown < container.size() - 1)
-            out << ", ";
 
-        shown++;
-    }
-
-    out << " }" << std::endl;
+template <typename Type>
+void DequeValue<Type>::write(const PeponQuotes& quotes, [[maybe_unused]] const PeponSaveOptions& options, OutputBuffer& out) const
+{
+    this->template writeContainer<std::deque<Type>>(quotes, out, "deque");
 }
 
 
 // Getters:
 template <typename Type>
-auto DequeValue<Type>::get() noexcept -> std::deque<Type>&
+auto DequeValue<Type>::get() -> std::deque<Type>&
+{
+    return std::any_cast<std::deque<Type>&>(this->getAny());
+}
+
+template <typename Type>
+auto DequeValue<Type>::get() const -> const std::deque<Type>&
 {
-    return m_value;
+    return std::any_cast<const std::deque<Type>&>(this->getAny());
 }
 
+// Copies up to "count" values into "dest", converted to "To" (only exact conversions)
 template <typename Type>
-auto DequeValue<Type>::get() const noexcept -> const std::deque<Type>&
+template <typename To>
+auto DequeValue<Type>::copyTo(To* dest, std::size_t count) const -> std::size_t
 {
-    return m_value;
+
+    // Numbers of a binary image are read in place
+    if constexpr (std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>)
+    {
+        if (const auto values = this->template getImageArray<Type>())
+            return copyValues(*values, dest, count);
+    }
+
+    return copyValues(this->get(), dest, count);
+
 }
 
 } // pepon
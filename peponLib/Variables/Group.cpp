@@ -1,9 +1,8 @@
-#include <charconv>     // std::from_chars
-
 #include <myoga-utils/Utils/StringUtils.hpp>
 #include <myoga-utils/Utils/TemplateUtils.hpp>
 
 #include "Group.hpp"
+#include "../Parser/ValueDecoder.hpp"
 
 #include "SingleValue.hpp"
 #include "VectorValue.hpp"
@@ -13,9 +12,32 @@
 namespace pepon
 {
 
+namespace
+{
+
+// IVariable class of every value type
+template <typename Type>
+struct VariableOf { using type = SingleValue<Type>; };
+
+template <typename Type>
+struct VariableOf<std::vector<Type>> { using type = VectorValue<Type>; };
+
+template <>
+struct VariableOf<BitVector> { using type = VectorValue<bool>; };
+
+template <typename Type>
+struct VariableOf<std::deque<Type>> { using type = DequeValue<Type>; };
+
+template <typename Type>
+struct VariableOf<std::list<Type>> { using type = ListValue<Type>; };
+
+} // anonymous namespace
+
+
 // ctor
-Group::Group(std::string_view name)
-    : m_name(name)
+Group::Group(std::string_view name, e_storage storage)
+    : m_name(name),
+      m_storage(storage)
 {
 }
 
@@ -26,9 +48,15 @@ auto Group::getName() const noexcept -> std::string_view
     return m_name;
 }
 
-auto Group::getVars() noexcept -> t_variablesContainer&
+auto Group::getStorage() const noexcept -> e_storage
 {
-    return m_vars;
+    return m_storage;
+}
+
+// Number of variables
+auto Group::size() const noexcept -> std::size_t
+{
+    return (m_storage == e_storage::COMPACT) ? m_values.size() : m_vars.size();
 }
 
 auto Group::getVars() const noexcept -> const t_variablesContainer&
@@ -36,6 +64,12 @@ auto Group::getVars() const noexcept -> const t_variablesContainer&
     return m_vars;
 }
 
+// Values of compact groups
+auto Group::getValues() const noexcept -> const t_valuesContainer&
+{
+    return m_values;
+}
+
 auto Group::getComments() const noexcept -> const t_commentsContainer&
 {
     return m_comments;
@@ -61,69 +95,154 @@ void Group::print(const PeponQuotes& quotes, std::ostream& out, e_commentStyle s
                 break;
         };
 
-        out << comment << std::endl;
+        out << comment << '\n';
     }
 
 
     // Write group name
-    out << '[' << m_name << ']' << std::endl;
+    out << '[' << m_name << ']' << '\n';
 
     // Write every value
     for (auto& varPtr : m_vars)
         varPtr->print(quotes, out);
 
+    for (auto& variable : m_values)
+        pepon::print(variable, quotes, out);
+
+}
+
+
+// Variable by name, or nullptr
+auto Group::find(std::string_view name) noexcept -> IVariable*
+{
+    const auto index = this->indexOf(name);
+
+    return (index < m_vars.size()) ? m_vars[index].get() : nullptr;
+}
+
+auto Group::find(std::string_view name) const noexcept -> const IVariable*
+{
+    const auto index = this->indexOf(name);
+
+    return (index < m_vars.size()) ? m_vars[index].get() : nullptr;
+}
+
+
+// Value of a compact group by name, or nullptr
+auto Group::findValue(std::string_view name) const noexcept -> const t_compactValue*
+{
+
+    if (m_storage != e_storage::COMPACT)
+        return nullptr;
+
+    const auto index = this->indexOf(name);
+
+    return (index < m_values.size()) ? &m_values[index].value : nullptr;
+
+}
+
+
+// Changes every time a variable is added or removed
+auto Group::getRevision() const noexcept -> std::uint64_t
+{
+    return m_revision;
+}
+
+
+// Serialize the group (same format as print)
+void Group::write(const PeponQuotes& quotes, const PeponSaveOptions& options, OutputBuffer& out, e_commentStyle style) const
+{
+
+    // Write comments
+    for (auto& comment : m_comments)
+    {
+        switch(style)
+        {
+            case e_commentStyle::CPP:
+                out.append("// ");
+                break;
+            case e_commentStyle::LUA:
+                out.append("-- ");
+                break;
+            case e_commentStyle::PYTHON:
+                out.append("# ");
+                break;
+        };
+
+        out.append(comment);
+        out.append('\n');
+    }
+
+
+    // Write group name
+    out.append('[');
+    out.append(m_name);
+    out.append("]\n");
+
+    // Write every value
+    for (auto& varPtr : m_vars)
+        varPtr->write(quotes, options, out);
+
+    for (auto& variable : m_values)
+        pepon::write(variable, quotes, options, out);
+
+}
+
+
+// Copy text into the group, for values that are not views into the file
+auto Group::storeText(std::string_view text) -> std::string_view
+{
+    return m_text.store(text);
+}
+
+// Takes the text this group was parsed from: its names, comments and values may be views into it
+void Group::adoptText(TextArena text)
+{
+    m_text.merge(std::move(text));
+}
+
+// Bytes of text owned by the group
+auto Group::getTextSize() const noexcept -> std::size_t
+{
+    return m_text.size();
 }
 
 
 // Adds a single value
-void Group::addVariable(std::string_view name, std::string_view value, e_cppTypes typeAsEnum)
+void Group::addVariable(std::string_view name, std::string_view value, e_cppTypes typeAsEnum, bool lazy)
 {
 
-    // Unlike other parsing functions in C++ and C libraries, std::from_chars is locale-independent, non-allocating, and non-throwing
+    // Numbers are parsed by std::from_chars (or equivalent):
+    // locale-independent, non-allocating, and non-throwing
     // https://en.cppreference.com/w/cpp/utility/from_chars
     switch(typeAsEnum)
     {
         case e_cppTypes::INT:
-        {
-            int result = 0;
-            std::from_chars(value.data(), value.data() + value.size(), result);
-            m_vars.emplace_back(std::make_unique<SingleValue<int>>(std::string(name), result));
-        }
+            this->addText<SingleValue<int>, int>(name, value, lazy);
             break;
 
         case e_cppTypes::UINT:
-        {
-            uint result = 0U;
-            std::from_chars(value.data(), value.data() + value.size(), result);
-            m_vars.emplace_back(std::make_unique<SingleValue<uint>>(std::string(name), result));
-        }
+            this->addText<SingleValue<uint>, uint>(name, value, lazy);
             break;
 
         case e_cppTypes::BOOL:
-            m_vars.emplace_back(std::make_unique<SingleValue<bool>>(std::string(name), myoga::boolFromStr(value)));
+            this->addText<SingleValue<bool>, bool>(name, value, lazy);
             break;
 
         case e_cppTypes::FLOAT:
-        {
-            //float result = 0.0f;
-            // DOESN'T WORK IN GCC!
-            //std::from_chars(varValue.data(), varValue.data() + varValue.size(), result);
-            //std::istringstream(varValue.data()) >> result;
-            // Why stoX only works with string ???
-            float result = std::stof(std::string(value));
-            m_vars.emplace_back(std::make_unique<SingleValue<float>>(std::string(name), result));
-        }
+            this->addText<SingleValue<float>, float>(name, value, lazy);
             break;
 
         case e_cppTypes::DOUBLE:
-        {
-            double result = std::stod(std::string(value));
-            m_vars.emplace_back(std::make_unique<SingleValue<double>>(std::string(name), result));
-        }
+            this->addText<SingleValue<double>, double>(name, value, lazy);
             break;
 
+        // Nothing to decode: always a view
         case e_cppTypes::STRING_UTF8:
-            m_vars.emplace_back(std::make_unique<SingleValue<std::string>>(std::string(name), std::string(value)));
+            if (m_storage == e_storage::COMPACT)
+                this->insertValue(name, value);
+            else
+                this->insert(std::make_unique<SingleValue<std::string_view>>(IVariable::NameView { name }, value));
             break;
 
         case e_cppTypes::UNKNOWN:
@@ -134,10 +253,102 @@ void Group::addVariable(std::string_view name, std::string_view value, e_cppType
 }
 
 
+// Adds an already built variable
+void Group::addVariable(t_varSmartPtr variable)
+{
+
+    if (m_storage == e_storage::VARIABLES)
+    {
+        this->insert(std::move(variable));
+        return;
+    }
+
+    // Compact groups keep a copy of its name and value: the variable is destroyed
+    const auto name = this->storeText(variable->getName());
+
+    visitVariable(*variable, [this, name](const auto& value)
+    {
+        using t_value = std::decay_t<decltype(value)>;
+
+        if constexpr (std::is_same_v<t_value, std::string>)
+            this->insertValue(name, this->storeText(value));
+        else
+            this->insertValue(name, makeCompactValue(value));
+    });
+
+}
+
+
+// Adds a decoded value
+void Group::addValue(std::string_view name, t_compactValue value)
+{
+
+    if (m_storage == e_storage::COMPACT)
+    {
+        this->insertValue(name, std::move(value));
+        return;
+    }
+
+    std::visit([this, name](auto&& alternative)
+    {
+        using t_value = std::decay_t<decltype(alternative)>;
+
+        if constexpr (detail::IsBoxed<t_value>::value)
+        {
+            using t_deque = typename t_value::element_type;
+            this->insert(std::make_unique<typename VariableOf<t_deque>::type>(IVariable::NameView { name }, std::move(*alternative)));
+        }
+        else
+            this->insert(std::make_unique<typename VariableOf<t_value>::type>(IVariable::NameView { name }, std::move(alternative)));
+    }, std::move(value));
+
+}
+
+
 // Adds a container of values
-void Group::addContainer(std::string_view name, std::string_view containerType, e_cppTypes typeAsEnum, std::string_view values)
+void Group::addContainer(std::string_view name, std::string_view containerType, e_cppTypes typeAsEnum, std::string_view values, bool lazy,
+                         e_blobEncoding encoding, unsigned threads)
 {
 
+    // ---------------------------------
+    // BLOB LITERAL:
+    // ---------------------------------
+    if (encoding != e_blobEncoding::NONE)
+    {
+
+        if (containerType != "vector")
+            throw SyntaxError("Blob literal for '" + std::string(name) + "': only vectors can be encoded");
+
+        switch(typeAsEnum)
+        {
+            case e_cppTypes::INT:
+                this->addBlob<int>(name, values, encoding, lazy);
+                break;
+
+            case e_cppTypes::UINT:
+                this->addBlob<uint>(name, values, encoding, lazy);
+                break;
+
+            case e_cppTypes::FLOAT:
+                this->addBlob<float>(name, values, encoding, lazy);
+                break;
+
+            case e_cppTypes::DOUBLE:
+                this->addBlob<double>(name, values, encoding, lazy);
+                break;
+
+            case e_cppTypes::BOOL:
+            case e_cppTypes::STRING_UTF8:
+            case e_cppTypes::UNKNOWN:
+                throw SyntaxError("Blob literal for '" + std::string(name) + "': only int, uint, float and double values can be encoded");
+                break;
+        }
+
+        return;
+
+    }
+
+
     // ---------------------------------
     // VECTOR:
     // ---------------------------------
@@ -148,27 +359,27 @@ void Group::addContainer(std::string_view name, std::string_view containerType,
         switch(typeAsEnum)
         {
             case e_cppTypes::INT:
-                m_vars.emplace_back(std::make_unique<VectorValue<int>>(std::string(name), myoga::parseCSV<std::vector<int>>(values)));
+                this->addText<VectorValue<int>, std::vector<int>>(name, values, lazy, threads);
                 break;
 
             case e_cppTypes::UINT:
-                m_vars.emplace_back(std::make_unique<VectorValue<uint>>(std::string(name), myoga::parseCSV<std::vector<uint>>(values)));
+                this->addText<VectorValue<uint>, std::vector<uint>>(name, values, lazy, threads);
                 break;
 
             case e_cppTypes::BOOL:
-                throw SyntaxError("vector<bool> is not supported/not implemented");
+                this->addText<VectorValue<bool>, BitVector>(name, values, lazy);
                 break;
 
             case e_cppTypes::FLOAT:
-                m_vars.emplace_back(std::make_unique<VectorValue<float>>(std::string(name), myoga::parseCSV<std::vector<float>>(values)));
+                this->addText<VectorValue<float>, std::vector<float>>(name, values, lazy, threads);
                 break;
 
             case e_cppTypes::DOUBLE:
-                m_vars.emplace_back(std::make_unique<VectorValue<double>>(std::string(name), myoga::parseCSV<std::vector<double>>(values)));
+                this->addText<VectorValue<double>, std::vector<double>>(name, values, lazy, threads);
                 break;
 
             case e_cppTypes::STRING_UTF8:
-                m_vars.emplace_back(std::make_unique<VectorValue<std::string>>(std::string(name), myoga::parseCSStrings<std::vector<std::string>>(std::string(values))));
+                this->addText<VectorValue<std::string>, std::vector<std::string>>(name, values, lazy);
                 break;
 
             case e_cppTypes::UNKNOWN:
@@ -189,28 +400,27 @@ void Group::addContainer(std::string_view name, std::string_view containerType,
         switch(typeAsEnum)
         {
             case e_cppTypes::INT:
-                m_vars.emplace_back(std::make_unique<DequeValue<int>>(std::string(name), myoga::parseCSV<std::deque<int>>(values)));
+                this->addText<DequeValue<int>, std::deque<int>>(name, values, lazy);
                 break;
 
             case e_cppTypes::UINT:
-                m_vars.emplace_back(std::make_unique<DequeValue<uint>>(std::string(name), myoga::parseCSV<std::deque<uint>>(values)));
+                this->addText<DequeValue<uint>, std::deque<uint>>(name, values, lazy);
                 break;
 
             case e_cppTypes::BOOL:
-
-                m_vars.emplace_back(std::make_unique<DequeValue<bool>>(std::string(name), myoga::parseCSV<std::deque<bool>>(values)));
+                this->addText<DequeValue<bool>, std::deque<bool>>(name, values, lazy);
                 break;
 
             case e_cppTypes::FLOAT:
-                m_vars.emplace_back(std::make_unique<DequeValue<float>>(std::string(name), myoga::parseCSV<std::deque<float>>(values)));
+                this->addText<DequeValue<float>, std::deque<float>>(name, values, lazy);
                 break;
 
             case e_cppTypes::DOUBLE:
-                m_vars.emplace_back(std::make_unique<DequeValue<double>>(std::string(name), myoga::parseCSV<std::deque<double>>(values)));
+                this->addText<DequeValue<double>, std::deque<double>>(name, values, lazy);
                 break;
 
             case e_cppTypes::STRING_UTF8:
-                m_vars.emplace_back(std::make_unique<DequeValue<std::string>>(std::string(name), myoga::parseCSStrings<std::deque<std::string>>(std::string(values))));
+                this->addText<DequeValue<std::string>, std::deque<std::string>>(name, values, lazy);
                 break;
 
             case e_cppTypes::UNKNOWN:
@@ -231,28 +441,27 @@ void Group::addContainer(std::string_view name, std::string_view containerType,
         switch(typeAsEnum)
         {
             case e_cppTypes::INT:
-                m_vars.emplace_back(std::make_unique<ListValue<int>>(std::string(name), myoga::parseCSV<std::list<int>>(values)));
+                this->addText<ListValue<int>, std::list<int>>(name, values, lazy);
                 break;
 
             case e_cppTypes::UINT:
-                m_vars.emplace_back(std::make_unique<ListValue<uint>>(std::string(name), myoga::parseCSV<std::list<uint>>(values)));
+                this->addText<ListValue<uint>, std::list<uint>>(name, values, lazy);
                 break;
 
             case e_cppTypes::BOOL:
-
-                m_vars.emplace_back(std::make_unique<ListValue<bool>>(std::string(name), myoga::parseCSV<std::list<bool>>(values)));
+                this->addText<ListValue<bool>, std::list<bool>>(name, values, lazy);
                 break;
 
             case e_cppTypes::FLOAT:
-                m_vars.emplace_back(std::make_unique<ListValue<float>>(std::string(name), myoga::parseCSV<std::list<float>>(values)));
+                this->addText<ListValue<float>, std::list<float>>(name, values, lazy);
                 break;
 
             case e_cppTypes::DOUBLE:
-                m_vars.emplace_back(std::make_unique<ListValue<double>>(std::string(name), myoga::parseCSV<std::list<double>>(values)));
+                this->addText<ListValue<double>, std::list<double>>(name, values, lazy);
                 break;
 
             case e_cppTypes::STRING_UTF8:
-                m_vars.emplace_back(std::make_unique<ListValue<std::string>>(std::string(name), myoga::parseCSStrings<std::list<std::string>>(std::string(values))));
+                this->addText<ListValue<std::string>, std::list<std::string>>(name, values, lazy);
                 break;
 
             case e_cppTypes::UNKNOWN:
@@ -265,10 +474,126 @@ void Group::addContainer(std::string_view name, std::string_view containerType,
 }
 
 
+// Adds a new variable to m_vars and m_index
+// Throws SyntaxError if its name is already used
+void Group::insert(t_varSmartPtr variable)
+{
+
+    const auto name = variable->getName();
+
+    if (!m_index.try_emplace(name, m_vars.size()).second)
+        throw SyntaxError("Variable \'" + std::string(name) + "\' is already defined in group [" + std::string(m_name) + ']');
+
+    m_vars.emplace_back(std::move(variable));
+    ++m_revision;
+
+}
+
+
+// Adds a new value to m_values and m_index
+// Throws SyntaxError if its name is already used
+void Group::insertValue(std::string_view name, t_compactValue value)
+{
+
+    if (!m_index.try_emplace(name, m_values.size()).second)
+        throw SyntaxError("Variable \'" + std::string(name) + "\' is already defined in group [" + std::string(m_name) + ']');
+
+    m_values.push_back({ name, std::move(value) });
+    ++m_revision;
+
+}
+
+
+// Adds a value from its text, decoded now or on first access (lazy)
+// Compact values are always decoded now
+template <typename Variable, typename Value>
+void Group::addText(std::string_view name, std::string_view text, bool lazy, unsigned threads)
+{
+
+    if (m_storage == e_storage::COMPACT)
+        this->insertValue(name, makeCompactValue(decodeValue<Value>(text, threads)));
+    else
+    if (lazy)
+        this->insert(std::make_unique<Variable>(IVariable::NameView { name }, IVariable::RawValue { text }));
+    else
+        this->insert(std::make_unique<Variable>(IVariable::NameView { name }, decodeValue<Value>(text, threads)));
+
+}
+
+
+// Adds a vector<Type> from a blob literal, decoded now or on first access (lazy)
+template <typename Type>
+void Group::addBlob(std::string_view name, std::string_view text, e_blobEncoding encoding, bool lazy)
+{
+
+    if (m_storage == e_storage::VARIABLES && lazy)
+    {
+        const auto decoder = (encoding == e_blobEncoding::BASE64) ? &decodeBlobAny<Type, e_blobEncoding::BASE64>
+                                                                  : &decodeBlobAny<Type, e_blobEncoding::HEX>;
+
+        this->insert(std::make_unique<VectorValue<Type>>(IVariable::NameView { name }, IVariable::RawValue { text }, decoder));
+    }
+    else
+    {
+        this->addValue(name, decodeBlobValues<Type>(text, encoding));
+    }
+
+}
+
+
+// Name of the variable at this index
+auto Group::getNameAt(std::size_t index) const noexcept -> std::string_view
+{
+    return (m_storage == e_storage::COMPACT) ? m_values[index].name : m_vars[index]->getName();
+}
+
+
+// Builds m_index again, from this index on, after a variable was removed
+void Group::reindex(std::size_t from)
+{
+    for (std::size_t i = from; i < this->size(); ++i)
+        m_index.insert_or_assign(this->getNameAt(i), i);
+}
+
+
+// Index in m_vars (or m_values), or size() if not found
+auto Group::indexOf(std::string_view name) const noexcept -> std::size_t
+{
+    const auto itr = m_index.find(name);
+
+    return (itr != m_index.end()) ? itr->second : this->size();
+}
+
+
 // Comments are mine
 void Group::takeOwnershipOfComments(t_commentsContainer comments)
 {
     m_comments = std::move(comments);
 }
 
+
+// Removes a variable (or value) by name. Returns false if it is not found
+auto Group::removeVariable(std::string_view name) -> bool
+{
+
+    const auto index = this->indexOf(name);
+
+    if (index == this->size())
+        return false;
+
+    m_index.erase(name);
+
+    if (m_storage == e_storage::COMPACT)
+        m_values.erase(m_values.begin() + static_cast<std::ptrdiff_t>(index));
+    else
+        m_vars.erase(m_vars.begin() + static_cast<std::ptrdiff_t>(index));
+
+    // Variables after it moved back by one
+    this->reindex(index);
+    ++m_revision;
+
+    return true;
+
+}
+
 } // pepon
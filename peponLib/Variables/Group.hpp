@@ -2,8 +2,14 @@
 #define GROUP_OF_VARIABLES_HPP
 
 #include <vector>
+#include <unordered_map>
 
 #include "IVariable.hpp"
+#include "CompactValue.hpp"
+#include "VariableVisitor.hpp"
+#include "../Parser/BlobCodec.hpp"
+#include "../Utils/Conversions.hpp"
+#include "../Memory/TextArena.hpp"
 
 namespace pepon
 {
@@ -15,50 +21,285 @@ class Group
     public:
 
         using t_variablesContainer = std::vector<t_varSmartPtr>;
-        using t_commentsContainer  = std::vector<std::string>;
+        using t_commentsContainer  = std::vector<std::string_view>;
+        using t_valuesContainer    = std::vector<CompactVariable>;
 
         enum class e_commentStyle { CPP, LUA, PYTHON };
 
+        // VARIABLES: every variable is an IVariable (getVars())
+        // COMPACT:   values are stored inline (getValues()), and are always decoded
+        enum class e_storage { VARIABLES, COMPACT };
+
     public:
 
         // ctor
-        Group(std::string_view name);
+        // The name is not copied: it MUST outlive this group
+        Group(std::string_view name, e_storage storage = e_storage::VARIABLES);
 
 
         // Get a view of the name
         auto getName() const noexcept -> std::string_view;
 
-        // Users can read and modify values
-        auto getVars() noexcept -> t_variablesContainer&;
+        auto getStorage() const noexcept -> e_storage;
+
+        // Number of variables
+        auto size() const noexcept -> std::size_t;
+
+        // Users can read and modify values. Variables are added and removed through the group only
+        // Empty for compact groups
         auto getVars() const noexcept -> const t_variablesContainer&;
 
+        // Values of compact groups
+        auto getValues() const noexcept -> const t_valuesContainer&;
+
+        // Calls visitor(name, value) for every variable, whatever the storage
+        // See visitVariable() and visitValue()
+        template <typename Visitor>
+        void forEach(Visitor&& visitor) const;
+
         // Comments can only be read
         auto getComments() const noexcept -> const t_commentsContainer&;
 
+        // Variable by name, or nullptr (always nullptr for compact groups)
+        auto find(std::string_view name) noexcept -> IVariable*;
+        auto find(std::string_view name) const noexcept -> const IVariable*;
+        // Value of a compact group by name, or nullptr
+        auto findValue(std::string_view name) const noexcept -> const t_compactValue*;
+
+        // Changes every time a variable is added or removed: pointers to variables and values may have changed
+        auto getRevision() const noexcept -> std::uint64_t;
+
+        // Value by name. Throws SyntaxError if the variable is not found, or if it is not a "Type"
+        // Ex: get<int>("a"), get<std::vector<double>>("b")
+        // Strings are views into the file: get<std::string_view>("c")
+        template <typename Type>
+        auto get(std::string_view name) const -> const Type&;
+
+        // Contiguous view of a vector<Type> value, by name (not for vector<bool>)
+        // Values left in a binary image are read in place, without decoding them
+        template <typename Type>
+        auto getSpan(std::string_view name) const -> Span<const Type>;
+
+        // Copies up to "count" values of any container into "dest", converted to "To"
+        // Only exact conversions are done (ex: float -> double, int -> long): others throw SyntaxError
+        // Numbers left in a binary image are copied from it, without decoding them
+        // Returns the number of values copied
+        template <typename To>
+        auto copyTo(std::string_view name, To* dest, std::size_t count) const -> std::size_t;
+
         // Utility
         void print(const PeponQuotes& quotes, std::ostream& out = std::cout, e_commentStyle style = e_commentStyle::CPP) const;
+        // Serialize the group (same format as print)
+        void write(const PeponQuotes& quotes, const PeponSaveOptions& options, OutputBuffer& out, e_commentStyle style = e_commentStyle::CPP) const;
+
+        // Copy text into the group, for values that are not views into the file
+        // (ex: multiline strings)
+        auto storeText(std::string_view text) -> std::string_view;
+        // Takes the text this group was parsed from: its names, comments and values may be views into it
+        void adoptText(TextArena text);
+        // Bytes of text owned by the group
+        auto getTextSize() const noexcept -> std::size_t;
 
+        // Names and string values are not copied: they MUST outlive this group
+        // Lazy values are not copied either: they are decoded on first access
         // Adds a single value
-        void addVariable(std::string_view name, std::string_view value, e_cppTypes typeAsEnum);
+        void addVariable(std::string_view name, std::string_view value, e_cppTypes typeAsEnum, bool lazy = false);
         // Adds a container of values
-        void addContainer(std::string_view name, std::string_view containerType, e_cppTypes typeAsEnum, std::string_view values);
+        // Blob literals ("b64{...}", "hex{...}") are vectors of int, uint, float or double only
+        // Large numeric vectors are parsed by up to "threads" threads (not lazy ones)
+        void addContainer(std::string_view name, std::string_view containerType, e_cppTypes typeAsEnum, std::string_view values, bool lazy = false,
+                          e_blobEncoding encoding = e_blobEncoding::NONE, unsigned threads = 1U);
+        // Adds an already built variable (compact groups copy its name and value)
+        void addVariable(t_varSmartPtr variable);
+        // Adds a decoded value
+        void addValue(std::string_view name, t_compactValue value);
         // Comments are mine
         void takeOwnershipOfComments(t_commentsContainer comments);
 
+        // Removes a variable (or value) by name. Returns false if it is not found
+        auto removeVariable(std::string_view name) -> bool;
+
+
+    private:
+
+        // Adds a new variable to m_vars and m_index
+        // Throws SyntaxError if its name is already used
+        void insert(t_varSmartPtr variable);
+
+        // Adds a new value to m_values and m_index
+        // Throws SyntaxError if its name is already used
+        void insertValue(std::string_view name, t_compactValue value);
+
+        // Adds a value from its text, decoded now or on first access (lazy)
+        template <typename Variable, typename Value>
+        void addText(std::string_view name, std::string_view text, bool lazy, unsigned threads = 1U);
+
+        // Adds a vector<Type> from a blob literal, decoded now or on first access (lazy)
+        template <typename Type>
+        void addBlob(std::string_view name, std::string_view text, e_blobEncoding encoding, bool lazy);
+
+        // Calls visitor(value) with the typed value of the variable at this index
+        template <typename Visitor>
+        void visitAt(std::size_t index, Visitor&& visitor) const;
+
+        // Name of the variable at this index
+        auto getNameAt(std::size_t index) const noexcept -> std::string_view;
+
+        // Builds m_index again, from this index on, after a variable was removed
+        void reindex(std::size_t from);
+
+        // Index in m_vars (or m_values), or size() if not found
+        auto indexOf(std::string_view name) const noexcept -> std::size_t;
+
 
     private:
 
         // Group name
-        std::string m_name;
+        std::string_view m_name;
+
+        e_storage m_storage;
 
         // Variables
         t_variablesContainer m_vars;
+        // Compact values
+        t_valuesContainer m_values;
+
+        // <Variable name, index in m_vars (or m_values)>
+        std::unordered_map<std::string_view, std::size_t> m_index;
+
+        // See getRevision()
+        std::uint64_t m_revision = 0U;
 
         // Comments
         t_commentsContainer m_comments;
 
+        // Text built while parsing
+        TextArena m_text;
+
 };
 
+
+// Calls visitor(name, value) for every variable, whatever the storage
+template <typename Visitor>
+void Group::forEach(Visitor&& visitor) const
+{
+
+    if (m_storage == e_storage::COMPACT)
+    {
+        for (const auto& variable : m_values)
+        {
+            visitValue(variable.value, [&visitor, &variable](const auto& value)
+            {
+                visitor(variable.name, value);
+            });
+        }
+    }
+    else
+    {
+        for (const auto& varPtr : m_vars)
+        {
+            visitVariable(*varPtr, [&visitor, &varPtr](const auto& value)
+            {
+                visitor(varPtr->getName(), value);
+            });
+        }
+    }
+
+}
+
+
+// Value by name. Throws SyntaxError if the variable is not found, or if it is not a "Type"
+template <typename Type>
+auto Group::get(std::string_view name) const -> const Type&
+{
+
+    const auto index = this->indexOf(name);
+
+    if (index == this->size())
+        throw SyntaxError("Variable \'" + std::string(name) + "\' not found in group [" + std::string(m_name) + ']');
+
+    const auto* value = (m_storage == e_storage::COMPACT) ? getIf<Type>(m_values[index].value)
+                                                          : std::any_cast<Type>(&m_vars[index]->getAny());
+
+    if (value == nullptr)
+        throw SyntaxError("Variable \'" + std::string(name) + "\' is not a " + std::string(getTypeName<Type>()));
+
+    return *value;
+
+}
+
+
+// Contiguous view of a vector<Type> value, by name (not for vector<bool>)
+template <typename Type>
+auto Group::getSpan(std::string_view name) const -> Span<const Type>
+{
+
+    static_assert(!std::is_same_v<Type, bool>, "vector<bool> values are bit packed: use get<BitVector>().getWords()");
+
+    // Numbers of a binary image are read in place
+    if (const auto* variable = this->find(name); variable != nullptr && variable->getVarType() == IVariable::e_varType::VECTOR)
+    {
+        if (const auto values = variable->getImageArray<Type>())
+            return *values;
+    }
+
+    const auto& values = this->get<std::vector<Type>>(name);
+
+    return { values.data(), values.size() };
+
+}
+
+
+// Copies up to "count" values of any container into "dest", converted to "To"
+// Returns the number of values copied
+template <typename To>
+auto Group::copyTo(std::string_view name, To* dest, std::size_t count) const -> std::size_t
+{
+
+    const auto index = this->indexOf(name);
+
+    if (index == this->size())
+        throw SyntaxError("Variable \'" + std::string(name) + "\' not found in group [" + std::string(m_name) + ']');
+
+    std::size_t copied = 0U;
+
+    auto copy = [&](const auto& value)
+    {
+        using t_value = std::decay_t<decltype(value)>;
+
+        if constexpr (!std::is_arithmetic_v<t_value> && !std::is_same_v<t_value, std::string> && !std::is_same_v<t_value, std::string_view>)
+        {
+            if constexpr (isWidening<typename t_value::value_type, To>)
+            {
+                copied = copyValues(value, dest, count);
+                return;
+            }
+        }
+
+        throw SyntaxError("Variable \'" + std::string(name) + "\' cannot be copied exactly as " + std::string(getTypeName<To>()));
+    };
+
+    // Numbers of a binary image are read in place
+    if (m_storage == e_storage::VARIABLES && visitImageArray(*m_vars[index], copy))
+        return copied;
+
+    this->visitAt(index, copy);
+
+    return copied;
+
+}
+
+
+// Calls visitor(value) with the typed value of the variable at this index
+template <typename Visitor>
+void Group::visitAt(std::size_t index, Visitor&& visitor) const
+{
+    if (m_storage == e_storage::COMPACT)
+        visitValue(m_values[index].value, visitor);
+    else
+        visitVariable(*m_vars[index], visitor);
+}
+
 } // pepon
 
 
@@ -3,15 +3,54 @@
 namespace pepon
 {
 
+namespace
+{
+
+// print() formats one value at a time
+constexpr std::size_t PRINT_BUFFER_CAPACITY = 4096U;
+
+// Copy of the name, if it is not a view
+auto copyName(std::string& name, bool isView) -> std::unique_ptr<const std::string>
+{
+    return isView ? nullptr : std::make_unique<const std::string>(std::move(name));
+}
+
+} // anonymous namespace
+
+
 // ctor
-IVariable::IVariable(std::string name, e_varType varType, e_cppTypes cppType, std::any&& value)
-    : m_name(std::move(name)),
+IVariable::IVariable(Name name, e_varType varType, e_cppTypes cppType, std::any&& value)
+    : m_nameCopy(copyName(name.m_copy, name.m_isView)),
+      m_name(m_nameCopy ? std::string_view(*m_nameCopy) : name.m_view),
       m_varType(varType),
       m_cppType(cppType),
       m_value(std::move(value))
 {
 }
 
+// Lazy value
+IVariable::IVariable(Name name, e_varType varType, e_cppTypes cppType, RawValue raw, t_decoder decoder)
+    : m_nameCopy(copyName(name.m_copy, name.m_isView)),
+      m_name(m_nameCopy ? std::string_view(*m_nameCopy) : name.m_view),
+      m_varType(varType),
+      m_cppType(cppType),
+      m_raw(raw.text),
+      m_decoder(decoder),
+      m_inImage(raw.inImage),
+      m_decoded(false)
+{
+}
+
+
+// Print value: write() through an OutputBuffer, so both have the same format
+void IVariable::print(const PeponQuotes& quotes, std::ostream& out) const
+{
+    OutputBuffer buffer(out, PRINT_BUFFER_CAPACITY);
+
+    this->write(quotes, PeponSaveOptions(), buffer);
+    buffer.flush();
+}
+
 
 // Getters:
 auto IVariable::getName() const noexcept -> std::string_view
@@ -29,14 +68,66 @@ auto IVariable::getCppType() const noexcept -> e_cppTypes
     return m_cppType;
 }
 
+// Lazy values are decoded here (once, thread safe)
 auto IVariable::getAny() -> std::any&
 {
+    this->materialize();
     return m_value;
 }
 
 auto IVariable::getAny() const -> const std::any&
 {
+    this->materialize();
     return m_value;
 }
 
+// Was the value loaded lazily (decoded yet or not)?
+auto IVariable::isLazy() const noexcept -> bool
+{
+    return m_decoder != nullptr;
+}
+
+// Lazy values: has the value been decoded yet?
+auto IVariable::isDecoded() const noexcept -> bool
+{
+    return m_decoded.load(std::memory_order_acquire);
+}
+
+// Lazy values: the value decoded from its text, without keeping it
+auto IVariable::decodeCopy() const -> std::any
+{
+    return m_decoder(m_raw);
+}
+
+// Lazy values: text of the value
+auto IVariable::getRawValue() const noexcept -> std::string_view
+{
+    return m_raw;
+}
+
+
+// Lazy values of a binary image
+auto IVariable::isInImage() const noexcept -> bool
+{
+    return m_inImage;
+}
+
+
+// Decodes lazy values
+void IVariable::materialize() const
+{
+
+    // Fast path: already decoded (or not lazy at all)
+    if (m_decoded.load(std::memory_order_acquire))
+        return;
+
+    // If decoding throws, the next access will try again
+    std::call_once(m_decodeOnce, [this]()
+    {
+        m_value = m_decoder(m_raw);
+        m_decoded.store(true, std::memory_order_release);
+    });
+
+}
+
 } // pepon
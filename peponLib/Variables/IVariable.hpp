@@ -2,11 +2,18 @@
 #define VARIABLES_INTERFACE_HPP
 
 #include <any>
+#include <mutex>
+#include <atomic>
 #include <string>
 #include <memory>
+#include <optional>
 #include <iostream>
 
 #include "../Pepon.hpp"
+#include "../IO/BinaryFormat.hpp"
+#include "../IO/OutputBuffer.hpp"
+#include "../IO/ValueWriter.hpp"
+#include "../Utils/Span.hpp"
 
 namespace pepon
 {
@@ -29,44 +36,142 @@ class IVariable
             //FORWARD_LIST      // seriously, who designed that thing?
         };
 
+        // Lazy values: the text is kept as is, and decoded on first access
+        // Values of a binary image are left in it instead: "text" is then [image begin, end of their entry) (see getRawEntry())
+        struct RawValue
+        {
+            std::string_view text;
+            bool inImage = false;
+        };
+
+        using t_decoder = std::any (*)(std::string_view text);
+
+        // Names of parsed variables: views into the text of their file or group, not copied (it MUST outlive them)
+        struct NameView
+        {
+            std::string_view text;
+        };
+
+        // Name of a new variable: a copy of a string, or a NameView
+        class Name
+        {
+            public:
+
+                Name(std::string name) : m_copy(std::move(name)) {}
+                Name(const char* name) : m_copy(name) {}
+                Name(NameView name) noexcept : m_view(name.text), m_isView(true) {}
+
+            private:
+
+                friend class IVariable;
+
+                std::string m_copy;
+                std::string_view m_view;
+                bool m_isView = false;
+        };
+
     public:
 
         // ctor
-        IVariable(std::string name, e_varType varType, e_cppTypes cppType, std::any&& value);
+        IVariable(Name name, e_varType varType, e_cppTypes cppType, std::any&& value);
+        // Lazy value. The text is not copied
+        IVariable(Name name, e_varType varType, e_cppTypes cppType, RawValue raw, t_decoder decoder);
 
         // dtor
         virtual ~IVariable() = default;
 
 
         // Virtual functions:
-        // Print value
-        virtual void print(const PeponQuotes& quotes, std::ostream& out = std::cout) const = 0;
+        // Print value: write() through an OutputBuffer, so both have the same format
+        virtual void print(const PeponQuotes& quotes, std::ostream& out = std::cout) const;
+        // Serialize value (same format as print)
+        virtual void write(const PeponQuotes& quotes, const PeponSaveOptions& options, OutputBuffer& out) const = 0;
 
         // Getters:
         auto getName() const noexcept -> std::string_view;
         auto getVarType() const noexcept -> e_varType;
         auto getCppType() const noexcept -> e_cppTypes;
 
+        // Lazy values are decoded here (once, thread safe)
         auto getAny() -> std::any&;
         auto getAny() const -> const std::any&;
 
+        // Was the value loaded lazily (decoded yet or not)?
+        auto isLazy() const noexcept -> bool;
+        // Lazy values: has the value been decoded yet?
+        auto isDecoded() const noexcept -> bool;
+        // Lazy values: the value decoded from its text, without keeping it (the variable stays lazy)
+        // Throws SyntaxError like getAny()
+        auto decodeCopy() const -> std::any;
+        // Lazy values: text of the value
+        auto getRawValue() const noexcept -> std::string_view;
+        // Lazy values of a binary image (see RawValue)
+        auto isInImage() const noexcept -> bool;
+
+        // Containers of numbers of a binary image: the numbers, read in place (nothing is decoded or copied)
+        // std::nullopt for other values, or if they are not "Type"
+        template <typename Type>
+        auto getImageArray() const noexcept -> std::optional<Span<const Type>>;
+
 
     protected:
 
+        // Decodes lazy values
+        void materialize() const;
 
-        // Variable name
-        std::string m_name;
+        // Serialize a container: "name : container<type> = { values }"
+        template <typename Container>
+        void writeContainer(const PeponQuotes& quotes, OutputBuffer& out, std::string_view containerName) const;
+
+
+
+        // Variable name: view into the file/group text, or into m_nameCopy
+        std::unique_ptr<const std::string> m_nameCopy;
+        std::string_view m_name;
         // Variable type:
         // single value or container?
         e_varType m_varType;
         // C++ type (enum)
         e_cppTypes m_cppType;
         // Value
-        std::any m_value;
+        mutable std::any m_value;
+
+        // Lazy values
+        std::string_view m_raw;
+        t_decoder m_decoder = nullptr;
+        bool m_inImage = false;
+
+        mutable std::once_flag m_decodeOnce;
+        mutable std::atomic<bool> m_decoded { true };
 
 };
 
 
+// Serialize a container: "name : container<type> = { values }"
+template <typename Container>
+void IVariable::writeContainer(const PeponQuotes& quotes, OutputBuffer& out, std::string_view containerName) const
+{
+    writeContainerValues(m_name, containerName, std::any_cast<const Container&>(this->getAny()), quotes, out);
+}
+
+
+// Containers of numbers of a binary image: the numbers, read in place
+template <typename Type>
+auto IVariable::getImageArray() const noexcept -> std::optional<Span<const Type>>
+{
+
+    static_assert(std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>, "Only numbers can be read in place");
+
+    if (!m_inImage || m_varType == e_varType::SINGLE_VALUE || m_cppType != getTypeEnum<Type>())
+        return std::nullopt;
+
+    const auto& entry = getRawEntry(m_raw);
+
+    return Span<const Type>(reinterpret_cast<const Type*>(m_raw.data() + entry.data), static_cast<std::size_t>(entry.count));
+
+}
+
+
 // Define smart pointer to it
 using t_varSmartPtr = std::unique_ptr<IVariable>;
 
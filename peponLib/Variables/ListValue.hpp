@@ -4,6 +4,8 @@
 #include <list>
 
 #include "IVariable.hpp"
+#include "../Parser/ValueDecoder.hpp"
+#include "../Utils/Conversions.hpp"
 
 namespace pepon
 {
@@ -14,15 +16,23 @@ class ListValue final : public IVariable
     public:
 
         // ctor
-        ListValue(std::string name, std::list<Type> container);
+        ListValue(Name name, std::list<Type> container);
+        // Lazy value, decoded on first access
+        // Values of a binary image have their own decoder
+        ListValue(Name name, RawValue raw, t_decoder decoder = &decodeAny<std::list<Type>>);
 
         // Virtual functions override
-        void print(const PeponQuotes& quotes, std::ostream& out = std::cout) const override;
+        void write(const PeponQuotes& quotes, const PeponSaveOptions& options, OutputBuffer& out) const override;
 
 
         // Getters:
-        auto get() noexcept -> std::list<Type>&;
-        auto get() const noexcept -> const std::list<Type>&;
+        auto get() -> std::list<Type>&;
+        auto get() const -> const std::list<Type>&;
+
+        // Copies up to "count" values into "dest", converted to "To" (only exact conversions)
+        // Returns the number of values copied
+        template <typename To>
+        auto copyTo(To* dest, std::size_t count) const -> std::size_t;
 
 };
 
@@ -30,7 +40,7 @@ class ListValue final : public IVariable
 // Template functions implementation:
 // ctor
 template <typename Type>
-ListValue<Type>::ListValue(std::string name, std::list<Type> container)
+ListValue<Type>::ListValue(Name name, std::list<Type> container)
 
     : IVariable(std::move(name),
                 IVariable::e_varType::LIST,
@@ -40,48 +50,50 @@ ListValue<Type>::ListValue(std::string name, std::list<Type> container)
 }
 
 template <typename Type>
-void ListValue<Type>::print(const PeponQuotes& quotes, std::ostream& out) const
-{
-    out << m_name << " : list<"
-        << getTypeName<Type>()
-        << "> = { ";
-
-    const auto& container = std::any_cast<const std::list<Type>&>(m_value);
-    std::size_t shown = 0U;
-
-    for (const auto& elem : container)
-    {
-        if (quotes.useQuotes)
-            out << quotes.quotesChar;
-
-        if (m_cppType == e_cppTypes::BOOL)
-            out << std::boolalpha << elem;
-        else
-            out << elem;
-
-        if (quotes.useQuotes)
-            out << quotes.quotesChar;
+ListValue<Type>::ListValue(Name name, RawValue raw, t_decoder decoder)
 
-        if (shown < container.size() - 1)
-            out << ", ";
-
-        shown++;
-    }
+    : IVariable(std::move(name),
+                IVariable::e_varType::LIST,
+                getTypeEnum<Type>(),
+                raw,
+                decoder)
+{
+}
 
-    out << " }" << std::endl;
+template <typename Type>
+void ListValue<Type>::write(const PeponQuotes& quotes, [[maybe_unused]] const PeponSaveOptions& options, OutputBuffer& out) const
+{
+    this->template writeContainer<std::list<Type>>(quotes, out, "list");
 }
 
 // Getters:
 template <typename Type>
-auto ListValue<Type>::get() noexcept -> std::list<Type>&
+auto ListValue<Type>::get() -> std::list<Type>&
+{
+    return std::any_cast<std::list<Type>&>(this->getAny());
+}
+
+template <typename Type>
+auto ListValue<Type>::get() const -> const std::list<Type>&
 {
-    return m_value;
+    return std::any_cast<const std::list<Type>&>(this->getAny());
 }
 
+// Copies up to "count" values into "dest", converted to "To" (only exact conversions)
 template <typename Type>
-auto ListValue<Type>::get() const noexcept -> const std::list<Type>&
+template <typename To>
+auto ListValue<Type>::copyTo(To* dest, std::size_t count) const -> std::size_t
 {
-    return m_value;
+
+    // Numbers of a binary image are read in place
+    if constexpr (std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>)
+    {
+        if (const auto values = this->template getImageArray<Type>())
+            return copyValues(*values, dest, count);
+    }
+
+    return copyValues(this->get(), dest, count);
+
 }
 
 } // pepon
@@ -4,45 +4,35 @@ namespace pepon
 {
 
 template <>
-void SingleValue<bool>::print(const PeponQuotes& quotes, std::ostream& out) const
+void SingleValue<std::string>::write(const PeponQuotes& quotes, [[maybe_unused]] const PeponSaveOptions& options, OutputBuffer& out) const
 {
-    out << m_name << " : bool = ";
+    const auto& value = this->getAny();
 
-    if (!m_value.has_value())
+    if (!value.has_value())
     {
-        out << "UNINITIALIZED!" << '\n';
+        out.append(m_name);
+        out.append(" : string = UNINITIALIZED!\n");
         return;
     }
 
-    if (quotes.useQuotes)
-        out << quotes.quotesChar;
-
-    out << std::boolalpha << std::any_cast<bool>(m_value);
-
-    if (quotes.useQuotes)
-        out << quotes.quotesChar;
-
-    out << std::endl;
+    writeSingleValue(m_name, std::any_cast<const std::string&>(value), quotes, out);
 
 }
 
 
 template <>
-void SingleValue<std::string>::print([[maybe_unused]] const PeponQuotes& quotes, std::ostream& out) const
+void SingleValue<std::string_view>::write(const PeponQuotes& quotes, [[maybe_unused]] const PeponSaveOptions& options, OutputBuffer& out) const
 {
-    out << m_name << " : string = ";
+    const auto& value = this->getAny();
 
-    if (!m_value.has_value())
+    if (!value.has_value())
     {
-        out << "UNINITIALIZED!" << '\n';
+        out.append(m_name);
+        out.append(" : string = UNINITIALIZED!\n");
         return;
     }
 
-    out << "\"";
-
-    out << std::any_cast<const std::string&>(m_value);
-
-    out << "\"" << std::endl;
+    writeSingleValue(m_name, std::any_cast<std::string_view>(value), quotes, out);
 
 }
 
@@ -2,6 +2,7 @@
 #define SINGLE_VALUE_VARIABLE_HPP
 
 #include "IVariable.hpp"
+#include "../Parser/ValueDecoder.hpp"
 
 namespace pepon
 {
@@ -13,10 +14,12 @@ class SingleValue final : public IVariable
     public:
 
         // ctor
-        SingleValue(std::string name, Type value);
+        SingleValue(Name name, Type value);
+        // Lazy value, decoded on first access
+        SingleValue(Name name, RawValue raw);
 
         // Virtual functions override
-        void print(const PeponQuotes& quotes, std::ostream& out = std::cout) const override;
+        void write(const PeponQuotes& quotes, const PeponSaveOptions& options, OutputBuffer& out) const override;
 
 
         // Get reference
@@ -33,7 +36,7 @@ class SingleValue final : public IVariable
 // Template functions implementation:
 // ctor
 template <typename Type>
-SingleValue<Type>::SingleValue(std::string name, Type value)
+SingleValue<Type>::SingleValue(Name name, Type value)
 
     : IVariable(std::move(name),
                 IVariable::e_varType::SINGLE_VALUE,
@@ -42,49 +45,54 @@ SingleValue<Type>::SingleValue(std::string name, Type value)
 {
 }
 
+template <typename Type>
+SingleValue<Type>::SingleValue(Name name, RawValue raw)
+
+    : IVariable(std::move(name),
+                IVariable::e_varType::SINGLE_VALUE,
+                getTypeEnum<Type>(),
+                raw,
+                &decodeAny<Type>)
+{
+}
+
 
 template <typename Type>
-void SingleValue<Type>::print(const PeponQuotes& quotes, std::ostream& out) const
+void SingleValue<Type>::write(const PeponQuotes& quotes, [[maybe_unused]] const PeponSaveOptions& options, OutputBuffer& out) const
 {
-    out << m_name << " : ";
-    out << getTypeName<Type>() << " = ";
+    const auto& value = this->getAny();
 
-    if (!m_value.has_value())
+    if (!value.has_value())
     {
-        out << "UNINITIALIZED!" << '\n';
+        out.append(m_name);
+        out.append(" : ");
+        out.append(getTypeName<Type>());
+        out.append(" = UNINITIALIZED!\n");
         return;
     }
 
-    if (quotes.useQuotes)
-        out << quotes.quotesChar;
-
-    out << std::any_cast<Type>(m_value);
-
-    if (quotes.useQuotes)
-        out << quotes.quotesChar;
-
-    out << std::endl;
+    writeSingleValue(m_name, std::any_cast<const Type&>(value), quotes, out);
 
 }
 
 
 template <>
-void SingleValue<bool>::print(const PeponQuotes& quotes, std::ostream& out) const;
+void SingleValue<std::string>::write(const PeponQuotes& quotes, [[maybe_unused]] const PeponSaveOptions& options, OutputBuffer& out) const;
 
 template <>
-void SingleValue<std::string>::print(const PeponQuotes& quotes, std::ostream& out) const;
+void SingleValue<std::string_view>::write(const PeponQuotes& quotes, [[maybe_unused]] const PeponSaveOptions& options, OutputBuffer& out) const;
 
 
 template <typename Type>
 auto SingleValue<Type>::getValue() -> Type
 {
-    return std::any_cast<Type>(m_value);
+    return std::any_cast<Type>(this->getAny());
 }
 
 template <typename Type>
 auto SingleValue<Type>::getValue() const -> const Type&
 {
-    return std::any_cast<const Type&>(m_value);
+    return std::any_cast<const Type&>(this->getAny());
 }
 
 } // pepon
@@ -0,0 +1,172 @@
+#ifndef VARIABLE_VISITOR_HPP
+#define VARIABLE_VISITOR_HPP
+
+#include <list>
+#include <deque>
+#include <vector>
+#include <string>
+#include <utility>        // std::forward
+#include <typeinfo>
+
+#include "IVariable.hpp"
+
+namespace pepon
+{
+
+namespace detail
+{
+
+// Container<Type> for every supported type
+template <template <typename...> class Container, typename Visitor>
+void visitContainer(const IVariable& variable, const std::any& value, Visitor& visitor)
+{
+    switch (variable.getCppType())
+    {
+        case e_cppTypes::INT:
+            visitor(std::any_cast<const Container<int>&>(value));
+            break;
+
+        case e_cppTypes::UINT:
+            visitor(std::any_cast<const Container<uint>&>(value));
+            break;
+
+        case e_cppTypes::BOOL:
+            // vector<bool> values are bit packed
+            if constexpr (std::is_same_v<Container<bool>, std::vector<bool>>)
+                visitor(std::any_cast<const BitVector&>(value));
+            else
+                visitor(std::any_cast<const Container<bool>&>(value));
+            break;
+
+        case e_cppTypes::FLOAT:
+            visitor(std::any_cast<const Container<float>&>(value));
+            break;
+
+        case e_cppTypes::DOUBLE:
+            visitor(std::any_cast<const Container<double>&>(value));
+            break;
+
+        case e_cppTypes::STRING_UTF8:
+            visitor(std::any_cast<const Container<std::string>&>(value));
+            break;
+
+        case e_cppTypes::UNKNOWN:
+            throw SyntaxError("Unknown variable type for " + std::string(variable.getName()));
+    }
+}
+
+} // detail
+
+
+// Calls visitor(value) with "value", of the type of "variable" (ex: IVariable::decodeCopy())
+template <typename Visitor>
+void visitVariable(const IVariable& variable, const std::any& value, Visitor&& visitor)
+{
+
+    switch (variable.getVarType())
+    {
+        case IVariable::e_varType::SINGLE_VALUE:
+        {
+            switch (variable.getCppType())
+            {
+                case e_cppTypes::INT:
+                    visitor(std::any_cast<const int&>(value));
+                    break;
+
+                case e_cppTypes::UINT:
+                    visitor(std::any_cast<const uint&>(value));
+                    break;
+
+                case e_cppTypes::BOOL:
+                    visitor(std::any_cast<const bool&>(value));
+                    break;
+
+                case e_cppTypes::FLOAT:
+                    visitor(std::any_cast<const float&>(value));
+                    break;
+
+                case e_cppTypes::DOUBLE:
+                    visitor(std::any_cast<const double&>(value));
+                    break;
+
+                case e_cppTypes::STRING_UTF8:
+                    if (value.type() == typeid(std::string))
+                        visitor(std::any_cast<const std::string&>(value));
+                    else
+                        visitor(std::any_cast<const std::string_view&>(value));
+                    break;
+
+                case e_cppTypes::UNKNOWN:
+                    throw SyntaxError("Unknown variable type for " + std::string(variable.getName()));
+            }
+        }
+            break;
+
+        case IVariable::e_varType::VECTOR:
+            detail::visitContainer<std::vector>(variable, value, visitor);
+            break;
+
+        case IVariable::e_varType::DEQUE:
+            detail::visitContainer<std::deque>(variable, value, visitor);
+            break;
+
+        case IVariable::e_varType::LIST:
+            detail::visitContainer<std::list>(variable, value, visitor);
+            break;
+    }
+
+}
+
+
+// Calls visitor(value) with the typed value of a variable:
+// const Type& for single values, const std::vector<Type>& (or deque, list) for containers
+// vector<bool> values are a const BitVector&
+// Single string values can be std::string or std::string_view
+template <typename Visitor>
+void visitVariable(const IVariable& variable, Visitor&& visitor)
+{
+    visitVariable(variable, variable.getAny(), std::forward<Visitor>(visitor));
+}
+
+
+// Containers of numbers of a binary image: calls visitor(Span<const Type>) with the numbers, read in place
+// (nothing is decoded, see IVariable::getImageArray()). Returns false, without calling it, for other values
+template <typename Visitor>
+auto visitImageArray(const IVariable& variable, Visitor&& visitor) -> bool
+{
+
+    if (!variable.isInImage() || variable.getVarType() == IVariable::e_varType::SINGLE_VALUE)
+        return false;
+
+    switch (variable.getCppType())
+    {
+        case e_cppTypes::INT:
+            visitor(*variable.getImageArray<int>());
+            return true;
+
+        case e_cppTypes::UINT:
+            visitor(*variable.getImageArray<uint>());
+            return true;
+
+        case e_cppTypes::FLOAT:
+            visitor(*variable.getImageArray<float>());
+            return true;
+
+        case e_cppTypes::DOUBLE:
+            visitor(*variable.getImageArray<double>());
+            return true;
+
+        case e_cppTypes::BOOL:
+        case e_cppTypes::STRING_UTF8:
+        case e_cppTypes::UNKNOWN:
+            break;
+    }
+
+    return false;
+
+}
+
+} // pepon
+
+
+#endif // VARIABLE_VISITOR_HPP
@@ -4,25 +4,40 @@
 #include <vector>
 
 #include "IVariable.hpp"
+#include "../Parser/ValueDecoder.hpp"
+#include "../Parser/BlobCodec.hpp"
+#include "../Utils/Conversions.hpp"
 
 namespace pepon
 {
 
+// vector<bool> values are bit packed (BitVector)
 template <typename Type>
 class VectorValue final : public IVariable
 {
     public:
 
         // ctor
-        VectorValue(std::string name, std::vector<Type> container);
+        VectorValue(Name name, t_peponVector<Type> container);
+        // Lazy value, decoded on first access
+        // Blob literals and values of a binary image have their own decoder
+        VectorValue(Name name, RawValue raw, t_decoder decoder = &decodeAny<t_peponVector<Type>>);
 
         // Virtual functions override
-        void print(const PeponQuotes& quotes, std::ostream& out = std::cout) const override;
+        void write(const PeponQuotes& quotes, const PeponSaveOptions& options, OutputBuffer& out) const override;
 
 
         // Getters:
-        auto get() noexcept -> std::vector<Type>&;
-        auto get() const noexcept -> const std::vector<Type>&;
+        auto get() -> t_peponVector<Type>&;
+        auto get() const -> const t_peponVector<Type>&;
+
+        // Contiguous view of the values (not for vector<bool>)
+        auto getSpan() const -> Span<const Type>;
+
+        // Copies up to "count" values into "dest", converted to "To" (only exact conversions)
+        // Returns the number of values copied
+        template <typename To>
+        auto copyTo(To* dest, std::size_t count) const -> std::size_t;
 
 };
 
@@ -30,7 +45,7 @@ class VectorValue final : public IVariable
 // Template functions implementation:
 // ctor
 template <typename Type>
-VectorValue<Type>::VectorValue(std::string name, std::vector<Type> container)
+VectorValue<Type>::VectorValue(Name name, t_peponVector<Type> container)
 
     : IVariable(std::move(name),
                 IVariable::e_varType::VECTOR,
@@ -40,48 +55,79 @@ VectorValue<Type>::VectorValue(std::string name, std::vector<Type> container)
 }
 
 template <typename Type>
-void VectorValue<Type>::print(const PeponQuotes& quotes, std::ostream& out) const
+VectorValue<Type>::VectorValue(Name name, RawValue raw, t_decoder decoder)
+
+    : IVariable(std::move(name),
+                IVariable::e_varType::VECTOR,
+                getTypeEnum<Type>(),
+                raw,
+                decoder)
 {
-    out << m_name << " : vector<"
-        << getTypeName<Type>()
-        << "> = { ";
+}
 
-    const auto& container = std::any_cast<const std::vector<Type>&>(m_value);
-    std::size_t shown = 0U;
+template <typename Type>
+void VectorValue<Type>::write(const PeponQuotes& quotes, [[maybe_unused]] const PeponSaveOptions& options, OutputBuffer& out) const
+{
 
-    for (const auto& elem : container)
+    // Large numeric vectors: raw bytes, base64 encoded
+    if constexpr (isBlobType<Type>)
     {
-        if (quotes.useQuotes)
-            out << quotes.quotesChar;
+        const auto& values = this->get();
 
-        if (m_cppType == e_cppTypes::BOOL)
-            out << std::boolalpha << elem;
-        else
-            out << elem;
+        if (options.binaryLiteralsFrom > 0U && values.size() >= options.binaryLiteralsFrom)
+        {
+            writeBlobLiteral<Type>(m_name, { values.data(), values.size() }, out);
+            return;
+        }
+    }
 
-        if (quotes.useQuotes)
-            out << quotes.quotesChar;
+    this->template writeContainer<t_peponVector<Type>>(quotes, out, "vector");
 
-        if (shown < container.size() - 1)
-            out << ", ";
+}
 
-        shown++;
-    }
+// Getters:
+template <typename Type>
+auto VectorValue<Type>::get() -> t_peponVector<Type>&
+{
+    return std::any_cast<t_peponVector<Type>&>(this->getAny());
+}
 
-    out << " }" << std::endl;
+template <typename Type>
+auto VectorValue<Type>::get() const -> const t_peponVector<Type>&
+{
+    return std::any_cast<const t_peponVector<Type>&>(this->getAny());
 }
 
-// Getters:
+// Contiguous view of the values (not for vector<bool>)
 template <typename Type>
-auto VectorValue<Type>::get() noexcept -> std::vector<Type>&
+auto VectorValue<Type>::getSpan() const -> Span<const Type>
 {
-    return m_value;
+    static_assert(!std::is_same_v<Type, bool>, "vector<bool> values are bit packed: use get().getWords()");
+
+    // Numbers of a binary image are read in place
+    if (const auto values = this->template getImageArray<Type>())
+        return *values;
+
+    const auto& values = this->get();
+
+    return { values.data(), values.size() };
 }
 
+// Copies up to "count" values into "dest", converted to "To" (only exact conversions)
 template <typename Type>
-auto VectorValue<Type>::get() const noexcept -> const std::vector<Type>&
+template <typename To>
+auto VectorValue<Type>::copyTo(To* dest, std::size_t count) const -> std::size_t
 {
-    return m_value;
+
+    // Numbers of a binary image are read in place
+    if constexpr (std::is_arithmetic_v<Type> && !std::is_same_v<Type, bool>)
+    {
+        if (const auto values = this->template getImageArray<Type>())
+            return copyValues(*values, dest, count);
+    }
+
+    return copyValues(this->get(), dest, count);
+
 }
 
 } // pepon
@@ -1,20 +1,2037 @@
 #include <iostream>
+#include <fstream>
+#include <atomic>
+#include <iterator>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <algorithm>
+#include <filesystem>
+#include <chrono>
+#include <deque>
+#include <list>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <utility>
+#include <cstring>
+#include <limits>
+#include <cmath>
+#include <stdexcept>
 
 // Pepon
 #include "PeponConfig.hpp"
 
 #include <peponLib/Pepon.hpp>
 #include <peponLib/PeponFile.hpp>
+#include <peponLib/SharedPeponFile.hpp>
+#include <peponLib/PeponReader.hpp>
+#include <peponLib/PeponWriter.hpp>
+
+#include <peponLib/IO/AsyncFileReader.hpp>
+#include <peponLib/IO/BinaryFormat.hpp>
+#include <peponLib/IO/BinaryView.hpp>
+#include <peponLib/IO/SharedSegment.hpp>
+#include <peponLib/Memory/TextArena.hpp>
+#include <peponLib/Parser/NumberParser.hpp>
+#include <peponLib/Parser/StructuralIndex.hpp>
+
+#include <peponLib/Utils/Parallel.hpp>
 
 #include <peponLib/Variables/SingleValue.hpp>
 #include <peponLib/Variables/ListValue.hpp>
 
 
-// Shortcuts
-using std::cout;
-using std::endl;
+// Shortcuts
+using std::cout;
+using std::endl;
+
+
+// Test helpers
+namespace
+{
+
+// Number of failed checks
+int failures = 0;
+
+// Report a failed check, and go on
+void check(bool condition, std::string_view what)
+{
+    if (condition)
+        return;
+
+    ++failures;
+    cout << "FAILED: " << what << endl;
+}
+
+// Does "test" throw a pepon::SyntaxError?
+template <typename Test>
+auto throwsSyntaxError(Test&& test) -> bool
+{
+    try
+    {
+        test();
+    }
+    catch (const pepon::SyntaxError&)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+// Run a test. Unexpected exceptions are failures too
+template <typename Test>
+void run(std::string_view name, Test&& test)
+{
+    try
+    {
+        test();
+    }
+    catch (const std::exception& error)
+    {
+        ++failures;
+        cout << "FAILED: " << name << " threw: " << error.what() << endl;
+    }
+}
+
+// Path of a file in the test folder
+auto makePath(std::string_view name) -> std::string
+{
+    const auto folder = std::filesystem::temp_directory_path() / "pepon_test";
+    std::filesystem::create_directories(folder);
+
+    return (folder / name).string();
+}
+
+// Write (or rewrite in place, truncating it) a whole file
+void writeFile(const std::string& fileName, std::string_view text)
+{
+    std::ofstream handle(fileName, std::ios_base::binary | std::ios_base::trunc);
+    handle.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+// Read a whole file
+auto readFile(const std::string& fileName) -> std::string
+{
+    std::ifstream handle(fileName, std::ios_base::binary);
+    return std::string(std::istreambuf_iterator<char>(handle), std::istreambuf_iterator<char>());
+}
+
+// Many groups, with every kind of value, and a numeric vector large enough to be parsed in parts
+auto makeLargeText() -> std::string
+{
+    std::string text;
+
+    for (int i = 0; i < 400; ++i)
+    {
+        const auto number = std::to_string(i);
+
+        text += "// Group " + number + "\n";
+        text += "[Group " + number + "]\n";
+        text += "count : int = " + number + "\n";
+        text += "ratio : double = " + number + ".25\n";
+        text += "name : string = \"name " + number + "\"\n";
+        text += "flags : vector<bool> = { true, false, " + std::string((i % 2 == 0) ? "true" : "false") + " }\n";
+        text += "values : vector<float> = { 1.5, " + number + ", -2.25 }\n\n";
+    }
+
+    text += "[Large]\nweights : vector<double> = {";
+
+    for (int i = 0; i < 120000; ++i)
+        text += " " + std::to_string(i) + ".5,";
+
+    text += " 0 }\n";
+
+    return text;
+}
+
+// Text written by saveFile(), with its groups sorted: files write them in any order
+auto savedText(pepon::PeponFile& pf, std::string_view name) -> std::string
+{
+    const auto fileName = makePath(name);
+    pf.saveFile(fileName);
+
+    const auto text = readFile(fileName);
+
+    // Groups end with an empty line
+    std::vector<std::string> groups;
+
+    for (std::size_t begin = 0U; begin < text.size(); )
+    {
+        auto end = text.find("\n\n", begin);
+        end = (end == std::string::npos) ? text.size() : end + 2U;
+
+        // The last one may not
+        auto group = text.substr(begin, end - begin);
+
+        while (!group.empty() && group.back() == '\n')
+            group.pop_back();
+
+        groups.push_back(group + "\n\n");
+        begin = end;
+    }
+
+    std::sort(groups.begin(), groups.end());
+
+    std::string sorted;
+
+    for (const auto& group : groups)
+        sorted += group;
+
+    return sorted;
+}
+
+
+// Files are read by default: rewriting them in place cannot change (or crash) what was loaded
+void testMemoryMap()
+{
+
+    const auto fileName = makePath("rewrite.pep");
+    writeFile(fileName, "// Settings\n[Rewritten group]\nname : string = \"first value\"\nvalues : vector<int> = { 1, 2, 3 }\n");
+
+    pepon::PeponFile copied;
+    copied.loadFile(fileName);
+
+    pepon::PeponLoadOptions options;
+    options.useMemoryMap = true;
+
+    pepon::PeponFile mapped;
+    mapped.loadFile(fileName, options);
+
+    check(mapped.getGroup("Rewritten group").get<std::string_view>("name") == "first value", "memory mapped load");
+
+    // Same inode: truncated, then rewritten shorter
+    writeFile(fileName, "");
+    writeFile(fileName, "[X]\n");
+
+    const auto& group = copied.getGroup("Rewritten group");
+
+    check(group.getName() == "Rewritten group", "group name after an in place rewrite");
+    check(group.get<std::string_view>("name") == "first value", "string value after an in place rewrite");
+    check(group.get<std::vector<int>>("values") == std::vector<int> { 1, 2, 3 }, "vector after an in place rewrite");
+    check(group.getComments().size() == 1U && group.getComments().front() == "Settings", "comment after an in place rewrite");
+
+}
+
+
+// The PeponFile owns every parsed text: the caller's buffers can go away
+void testTextArena()
+{
+
+    pepon::PeponFile pf;
+
+    {
+        std::string text = "// Owned\n[Arena]\nname : string = \"kept\"\nvalues : list<string> = { x, y }\n";
+        pf.loadFromMemory(text);
+
+        text.assign(text.size(), '#');
+    }
+
+    const auto& group = pf.getGroup("Arena");
+
+    check(group.get<std::string_view>("name") == "kept", "string value outlives the caller's text");
+    check(group.get<std::list<std::string>>("values") == std::list<std::string> { "x", "y" }, "list outlives the caller's text");
+    check(group.getComments().front() == "Owned", "comment outlives the caller's text");
+
+
+    // Views never move, whatever is stored after them
+    pepon::TextArena arena;
+
+    const auto small = arena.store("small text");
+    const auto large = arena.store(std::string(100000U, 'L'));
+
+    std::vector<std::string_view> many;
+
+    for (int i = 0; i < 1000; ++i)
+        many.push_back(arena.store(std::to_string(i)));
+
+    check(small == "small text" && large == std::string(100000U, 'L'), "arena views stay valid");
+    check(many[999] == "999" && many[0] == "0", "arena views of many small texts");
+    check(arena.size() >= small.size() + large.size(), "arena size counts every text");
+    check(arena.store("").empty(), "empty texts take no room");
+
+}
+
+
+// The SIMD index finds what std::string_view::find() finds, whatever the block boundaries
+void testStructuralIndex()
+{
+
+    // Lines of every length, full of structural characters
+    const std::string_view alphabet = "ab [ ] : = { } \" , x/-#";
+
+    std::string text;
+    std::uint32_t seed = 12345U;
+
+    for (int line = 0; line < 600; ++line)
+    {
+        seed = seed * 1103515245U + 12345U;
+        const auto size = (seed >> 16U) % 150U;
+
+        for (std::size_t i = 0U; i < size; ++i)
+        {
+            seed = seed * 1103515245U + 12345U;
+            text += alphabet[(seed >> 16U) % alphabet.size()];
+        }
+
+        text += (line % 7 == 0) ? "\r\n" : "\n";
+    }
+
+    text += "[last] = { \"no end of line\" }";
+
+
+    pepon::StructuralIndex index;
+    index.build(text);
+
+    // Same lines, indexed as they arrive
+    pepon::StructuralIndex appended;
+
+    for (std::size_t begin = 0U; begin < text.size(); )
+    {
+        auto end = text.find('\n', std::min(text.size(), begin + 3000U));
+        end = (end == std::string::npos) ? text.size() : end + 1U;
+
+        appended.append(std::string_view(text).substr(begin, end - begin), begin);
+        begin = end;
+    }
+
+    const auto& lines = index.getLines();
+
+    check(lines.size() == 601U, "structural index line count");
+    check(appended.getLines().size() == lines.size(), "appended index line count");
+
+    // Position as the index reports it
+    auto position = [](std::size_t found) { return (found == std::string_view::npos) ? pepon::StructuralIndex::NOT_FOUND
+                                                                                     : static_cast<std::uint32_t>(found); };
+
+    bool same = true;
+    bool sameAppended = true;
+
+    for (std::size_t i = 0U; i < lines.size(); ++i)
+    {
+        const auto& info = lines[i];
+        const auto& other = appended.getLines()[std::min(i, appended.getLines().size() - 1U)];
+
+        auto line = std::string_view(text).substr(info.begin);
+        line = line.substr(0U, line.find('\n'));
+
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1U);
+
+        const auto openBracket = line.find('[');
+        const auto assignment  = line.find('=');
+        const auto comment     = std::min({ line.find("//"), line.find("--"), line.find('#') });
+
+        same = same && info.size == line.size() &&
+               info.openBracket  == position(openBracket) &&
+               info.closeBracket == position(openBracket == std::string_view::npos ? openBracket : line.find(']', openBracket + 1U)) &&
+               info.colon        == position(line.find(':')) &&
+               info.assignment   == position(assignment) &&
+               info.openCurly    == position(assignment == std::string_view::npos ? assignment : line.find('{', assignment + 1U)) &&
+               info.closeCurly   == position(line.rfind('}')) &&
+               info.openQuote    == position(assignment == std::string_view::npos ? assignment : line.find('"', assignment + 1U)) &&
+               info.closeQuote   == position(line.rfind('"')) &&
+               info.comment      == position(comment) &&
+               info.commas       == static_cast<std::uint32_t>(std::count(line.begin(), line.end(), ','));
+
+        sameAppended = sameAppended && other.begin == info.begin && other.size == info.size && other.openBracket == info.openBracket &&
+                       other.closeCurly == info.closeCurly && other.closeQuote == info.closeQuote && other.comment == info.comment && other.commas == info.commas;
+    }
+
+    check(same, std::string("structural index (") + std::string(pepon::StructuralIndex::getImplementationName()) + ") matches find()");
+    check(sameAppended, "appended index matches one build()");
+
+}
+
+
+
+// Pool threads give the same result as one thread, and report the errors of their tasks
+void testParallel()
+{
+
+    const auto text = makeLargeText();
+
+    pepon::PeponFile serial;
+    serial.loadFromMemory(text);
+
+    const auto expected = savedText(serial, "serial.pep");
+
+    for (const unsigned threads : { 0U, 4U })
+    {
+        pepon::PeponLoadOptions options;
+        options.threads = threads;
+
+        pepon::PeponFile threaded;
+        threaded.loadFromMemory(text, options);
+
+        check(savedText(threaded, "threaded.pep") == expected, "threaded parse == serial parse (" + std::to_string(threads) + " threads)");
+    }
+
+    check(serial.getGroup("Large").get<std::vector<double>>("weights").size() == 120001U, "large vector size");
+
+
+    // Nested calls do not wait for each other
+    std::atomic<std::size_t> sum { 0U };
+
+    pepon::parallelFor(16U, 8U, [&sum](std::size_t outer)
+    {
+        pepon::parallelFor(16U, 8U, [&sum, outer](std::size_t inner) { sum += outer * 16U + inner; });
+    });
+
+    check(sum == 255U * 256U / 2U, "nested parallelFor");
+
+
+    // The first error is rethrown, after every task has stopped
+    bool rethrown = false;
+
+    try
+    {
+        pepon::parallelFor(64U, 8U, [](std::size_t index)
+        {
+            if (index == 10U)
+                throw pepon::SyntaxError("task error");
+        });
+    }
+    catch (const pepon::SyntaxError&)
+    {
+        rethrown = true;
+    }
+
+    check(rethrown, "parallelFor rethrows task errors");
+
+}
+
+
+
+// Floating point values are the whole text, rounded once
+// parseFloat()/parseDouble() and the portable parsers (no std::from_chars) accept the same texts
+void testNumbers()
+{
+
+    struct Parsers
+    {
+        std::string_view name;
+        float  (*parseFloat)(std::string_view);
+        double (*parseDouble)(std::string_view);
+    };
+
+    for (const auto& parsers : { Parsers { "", pepon::parseFloat, pepon::parseDouble },
+                                 Parsers { " (portable)", pepon::parseFloatPortable, pepon::parseDoublePortable } })
+    {
+        const auto what = std::string(parsers.name);
+        const auto parseFloat  = parsers.parseFloat;
+        const auto parseDouble = parsers.parseDouble;
+
+        check(parseDouble("1.5") == 1.5 && parseDouble("-2.5e3") == -2500.0 && parseDouble("+7") == 7.0, "usual doubles" + what);
+        check(parseDouble(".5") == 0.5 && parseDouble("+.5") == 0.5 && parseDouble("5.") == 5.0, "doubles without integer or fraction digits" + what);
+        check(parseFloat("0.1") == 0.1f && parseFloat("3.4028234e38") == 3.4028234e38f, "usual floats" + what);
+        check(parseDouble("4e-320") == 4e-320 && parseDouble("0e999999") == 0.0 && std::signbit(parseDouble("-0")), "subnormal and zero doubles" + what);
+
+        // Half way between two floats as a double: rounding it again gives 1
+        check(parseFloat("1.00000005960464477550") == std::nextafter(1.0f, 2.0f), "floats are not rounded twice" + what);
+
+        // More digits than any stack buffer: 0.1 with 200 trailing zeros
+        const auto longText = "0.1" + std::string(200U, '0');
+        check(parseDouble(longText) == 0.1 && parseFloat(longText) == 0.1f, "long numbers" + what);
+
+        for (const auto* text : { "1.5abc", "0x1p3", "1e", "1.5e+", "", "abc", "1.2.3", "1e400", "+-1", "-+1", "++1", "+", "-", ".",
+                                  "inf", "-inf", "+inf", "infinity", "nan", "-nan", "NAN", "1e-400" })
+        {
+            check(throwsSyntaxError([&]() { parseDouble(text); }), std::string("invalid double '") + text + '\'' + what);
+            check(throwsSyntaxError([&]() { parseFloat(text); }), std::string("invalid float '") + text + '\'' + what);
+        }
+
+        check(throwsSyntaxError([&]() { parseFloat("1e39"); }), "float overflow" + what);
+        check(throwsSyntaxError([&]() { parseFloat("1e-50"); }), "float underflow" + what);
+    }
+
+    pepon::PeponFile pf;
+    check(throwsSyntaxError([&pf]() { pf.loadFromMemory("[Numbers]\nx : float = 1.5abc\n"); }), "trailing characters of a value");
+    check(throwsSyntaxError([&pf]() { pf.loadFromMemory("[Numbers]\nx : vector<double> = { 1, 0x1p3 }\n"); }), "hexadecimal vector element");
+
+}
+
+
+
+// Lazy values are decoded on first access, once, into the values an eager load gives
+void testLazy()
+{
+
+    const auto text = makeLargeText();
+
+    pepon::PeponFile eager;
+    eager.loadFromMemory(text);
+
+    pepon::PeponLoadOptions options;
+    options.lazy = true;
+
+    pepon::PeponFile lazy;
+    lazy.loadFromMemory(text, options);
+
+    const auto& group = lazy.getGroup("Group 7");
+    const auto& values = group.get<std::vector<float>>("values");
+
+    check(values == std::vector<float> { 1.5f, 7.0f, -2.25f }, "lazy vector");
+    check(&group.get<std::vector<float>>("values") == &values, "lazy values are decoded once");
+    check(group.get<std::string_view>("name") == "name 7" && group.get<int>("count") == 7, "lazy scalars");
+
+    check(savedText(lazy, "lazy.pep") == savedText(eager, "eager.pep"), "lazy load == eager load");
+
+
+    // Errors show up on access
+    lazy.loadFromMemory("[Bad]\nx : double = 1.5abc\n", options);
+    check(throwsSyntaxError([&lazy]() { lazy.getGroup("Bad").get<double>("x"); }), "lazy decoding error");
+
+}
+
+
+
+// Binary images load back into the same data, and broken images are rejected
+void testBinary()
+{
+
+    const auto text = makeLargeText();
+
+    pepon::PeponFile original;
+    original.loadFromMemory(text);
+
+    const auto expected = savedText(original, "original.pep");
+    const auto fileName = makePath("image.bin");
+
+    original.saveBinary(fileName);
+
+    for (const bool useMemoryMap : { false, true })
+    {
+        pepon::PeponLoadOptions options;
+        options.useMemoryMap = useMemoryMap;
+
+        pepon::PeponFile loaded;
+        loaded.loadBinary(fileName, options);
+
+        check(savedText(loaded, "loaded.pep") == expected, useMemoryMap ? "mapped binary round trip" : "binary round trip");
+        check(loaded.getGroup("Group 3").get<pepon::BitVector>("flags").size() == 3U, "binary vector<bool>");
+    }
+
+
+    // Failed saves throw, and leave nothing half written behind
+    const auto folder = makePath("image folder");
+    std::filesystem::create_directories(folder + "/inside");
+
+    check(throwsSyntaxError([&]() { original.saveBinary(folder); }), "binary image cannot replace a folder");
+    check(!std::filesystem::exists(folder + ".tmp"), "failed binary save removes its temporary file");
+    check(throwsSyntaxError([&]() { original.saveBinary(makePath("missing folder") + "/image.bin"); }), "binary image in a missing folder");
+
+
+    // Every kind of container, left in the image or copied (compact)
+    // Containers of strings are only left in it by lazy loads
+    pepon::PeponFile containers;
+    containers.loadFromMemory("[Containers]\n"
+                              "vi : vector<int> = { 1, -2 }\nvb : vector<bool> = { true, false, true }\nvs : vector<string> = { \"a\", \"b\" }\n"
+                              "du : deque<uint> = { 3, 4 }\ndb : deque<bool> = { false, true }\nds : deque<string> = { \"c\" }\n"
+                              "lf : list<float> = { 1.5 }\nlb : list<bool> = { true }\nls : list<string> = { \"d\", \"e\" }\n");
+
+    const auto containersImage = makePath("containers.bin");
+    containers.saveBinary(containersImage);
+
+    const auto containersText = savedText(containers, "containers.pep");
+
+    for (const bool lazy : { false, true })
+    {
+        for (const bool compact : { false, true })
+        {
+            pepon::PeponLoadOptions options;
+            options.lazy    = lazy;
+            options.compact = compact;
+
+            pepon::PeponFile loaded;
+            loaded.loadBinary(containersImage, options);
+
+            const auto& group = loaded.getGroup("Containers");
+            const auto what = std::string(lazy ? " (lazy" : " (not lazy") + (compact ? ", compact)" : ")");
+
+            if (!compact)
+            {
+                check(group.find("vi")->isInImage() && group.find("db")->isInImage() && !group.find("lf")->isDecoded(), "containers of numbers and bools left in the image" + what);
+                check(group.find("ls")->isInImage() == lazy && group.find("vs")->isDecoded() != lazy, "containers of strings left in the image when lazy" + what);
+            }
+
+            check(group.getSpan<int>("vi")[1] == -2 && group.get<std::list<std::string>>("ls").back() == "e", "values of every container" + what);
+            check(savedText(loaded, "containers loaded.pep") == containersText, "containers round trip" + what);
+        }
+    }
+
+
+    // Rejects the image once "patch" has changed it
+    const auto image = readFile(fileName);
+
+    auto rejects = [&image](std::string_view what, auto patch)
+    {
+        auto broken = image;
+        patch(broken);
+
+        const auto brokenFile = makePath("broken.bin");
+        writeFile(brokenFile, broken);
+
+        pepon::PeponFile pf;
+        check(throwsSyntaxError([&]() { pf.loadBinary(brokenFile); }), std::string("corrupt image rejected: ") + std::string(what));
+    };
+
+    // Entry of a variable of the first group
+    auto findVariable = [](std::string& broken, std::string_view name) -> pepon::BinaryVariable*
+    {
+        pepon::BinaryHeader header;
+        std::memcpy(&header, broken.data(), sizeof(header));
+
+        auto* variables = reinterpret_cast<pepon::BinaryVariable*>(broken.data() + header.variableTable);
+
+        for (std::size_t i = 0U; i < header.variableCount; ++i)
+            if (broken.compare(variables[i].name.offset, variables[i].name.size, name) == 0)
+                return &variables[i];
+
+        return nullptr;
+    };
+
+    rejects("magic", [](std::string& broken) { broken[0] = 'X'; });
+    rejects("truncated", [](std::string& broken) { broken.resize(broken.size() - 8U); });
+    rejects("group table", [](std::string& broken) { reinterpret_cast<pepon::BinaryHeader*>(broken.data())->groupTable = broken.size(); });
+    rejects("string offset", [&](std::string& broken) { findVariable(broken, "name")->data = broken.size() + 8U; });
+    rejects("type", [&](std::string& broken) { findVariable(broken, "count")->cppType = 200U; });
+
+    // (count + 63) / 64 would wrap to 0 words
+    rejects("vector<bool> size", [&](std::string& broken) { findVariable(broken, "flags")->count = std::numeric_limits<std::uint64_t>::max(); });
+    rejects("vector<float> size", [&](std::string& broken) { findVariable(broken, "values")->count = std::numeric_limits<std::uint64_t>::max() / 2U; });
+
+}
+
+
+
+// Saved files load back into the same values: floating point values are written in their shortest exact form
+void testSaveFile()
+{
+
+    const auto text = makeLargeText() +
+                      "[Precision]\n"
+                      "third : double = 0.3333333333333333\n"
+                      "sum : vector<double> = { 0.30000000000000004, 1e-300, -1.7976931348623157e308 }\n"
+                      "small : vector<float> = { 1e-7, 0.1, 3.4028235e38 }\n"
+                      "text : list<string> = { a, b c }\n";
+
+    pepon::PeponQuotes quotes;
+    quotes.useQuotes = false;
+
+    for (const std::size_t binaryLiteralsFrom : { std::size_t(0U), std::size_t(3U) })
+    {
+        pepon::PeponFile original;
+        original.loadFromMemory(text);
+        original.useQuotation(quotes);
+
+        pepon::PeponSaveOptions options;
+        options.binaryLiteralsFrom = binaryLiteralsFrom;
+
+        const auto fileName = makePath("saved.pep");
+        original.saveFile(fileName, options);
+
+        pepon::PeponFile loaded;
+        loaded.loadFile(fileName);
+        loaded.useQuotation(quotes);
+
+        const auto what = std::string(binaryLiteralsFrom == 0U ? "text" : "blob literals");
+
+        check(savedText(loaded, "loaded.pep") == savedText(original, "original.pep"), "saveFile round trip (" + what + ")");
+
+        const auto& group = loaded.getGroup("Precision");
+
+        check(group.get<double>("third") == 0.3333333333333333, "shortest double (" + what + ")");
+        check(group.get<std::vector<double>>("sum") == std::vector<double> { 0.1 + 0.2, 1e-300, -1.7976931348623157e308 }, "double vector (" + what + ")");
+        check(group.get<std::vector<float>>("small") == std::vector<float> { 1e-7f, 0.1f, 3.4028235e38f }, "float vector (" + what + ")");
+    }
+
+}
+
+
+
+// Variables are added and removed through their group, which keeps its index right
+void testGroupIndex()
+{
+
+    for (const bool compact : { false, true })
+    {
+        const auto what = std::string(compact ? " (compact)" : "");
+
+        pepon::PeponLoadOptions options;
+        options.compact = compact;
+
+        pepon::PeponFile pf;
+        pf.loadFromMemory("[Index]\na : int = 1\nb : int = 2\nc : int = 3\n", options);
+
+        auto& group = pf.getGroup("Index");
+        auto handle = pf.resolve("Index/c");
+
+        check(throwsSyntaxError([&pf]() { pf.loadFromMemory("[Twice]\na : int = 1\na : int = 2\n"); }), "duplicated name in a file" + what);
+        check(throwsSyntaxError([&group]() { group.addVariable(std::make_unique<pepon::SingleValue<int>>("b", 5)); }), "duplicated name added" + what);
+
+        check(group.removeVariable("a") && !group.removeVariable("a"), "remove a variable once" + what);
+        check(group.size() == 2U && group.get<int>("b") == 2 && group.get<int>("c") == 3, "variables after a removed one" + what);
+        check(throwsSyntaxError([&group]() { group.get<int>("a"); }), "removed variable is not found" + what);
+
+        check(pf.get<int>(handle) == 3, "handle resolved again after a removal" + what);
+
+        group.addVariable(std::make_unique<pepon::SingleValue<int>>("z", 5));
+        group.addVariable(std::make_unique<pepon::SingleValue<int>>("a", 6));
+
+        check(group.get<int>("z") == 5 && group.get<int>("a") == 6 && group.size() == 4U, "added variables are found" + what);
+
+        // Names of built variables are copied: temporary names do not dangle
+        const std::string prefix(32U, 'n');
+        group.addVariable(std::make_unique<pepon::SingleValue<int>>(prefix + "1", 7));
+        group.addVariable(std::make_unique<pepon::ListValue<int>>(prefix + "2", std::list<int> { 8 }));
+
+        check(group.get<int>(prefix + "1") == 7 && group.get<std::list<int>>(prefix + "2").front() == 8, "temporary names copied" + what);
+        check(pf.get<int>(handle) == 3, "handle resolved again after an addition" + what);
+    }
+
+}
+
+
+
+// Compact groups hold the values of an eager load, inline
+void testCompact()
+{
+
+    const auto text = makeLargeText();
+
+    pepon::PeponFile eager;
+    eager.loadFromMemory(text);
+
+    pepon::PeponLoadOptions options;
+    options.compact = true;
+    options.threads = 4U;
+
+    pepon::PeponFile compact;
+    compact.loadFromMemory(text, options);
+
+    const auto& group = compact.getGroup("Group 12");
+
+    check(group.getStorage() == pepon::Group::e_storage::COMPACT && group.getVars().empty() && group.getValues().size() == 5U, "compact storage");
+    check(group.get<int>("count") == 12 && group.get<std::string_view>("name") == "name 12", "compact scalars");
+    check(group.get<std::vector<float>>("values") == std::vector<float> { 1.5f, 12.0f, -2.25f }, "compact vector");
+    check(group.get<pepon::BitVector>("flags").size() == 3U && group.get<pepon::BitVector>("flags")[2], "compact vector<bool>");
+
+    std::size_t visited = 0U;
+    group.forEach([&visited](std::string_view, const auto&) { ++visited; });
+
+    check(visited == 5U, "forEach visits compact values");
+    check(savedText(compact, "compact.pep") == savedText(eager, "eager.pep"), "compact load == eager load");
+
+
+    // Both storages write every kind of value with the same text, with or without quotes and blobs
+    std::string every = "[Every kind]\n"
+                        "i : int = -3\nu : uint = 4\nb : bool = true\nf : float = 0.1\nd : double = 0.3333333333333333\ns : string = \"text\"\n";
+
+    for (const auto* container : { "vector", "deque", "list" })
+    {
+        const auto prefix = std::string(container);
+
+        every += prefix + "I : " + prefix + "<int> = { 1, -2 }\n";
+        every += prefix + "U : " + prefix + "<uint> = { 3, 4 }\n";
+        every += prefix + "B : " + prefix + "<bool> = { true, false }\n";
+        every += prefix + "F : " + prefix + "<float> = { 1.5, 0.1 }\n";
+        every += prefix + "D : " + prefix + "<double> = { 2.5, 1e-300 }\n";
+        every += prefix + "S : " + prefix + "<string> = { \"x\", \"y\" }\n";
+    }
+
+    pepon::PeponFile everyEager;
+    everyEager.loadFromMemory(every);
+
+    pepon::PeponFile everyCompact;
+    everyCompact.loadFromMemory(every, options);
+
+    check(everyCompact.getGroup("Every kind").getStorage() == pepon::Group::e_storage::COMPACT &&
+          everyEager.getGroup("Every kind").getVars().size() == 24U, "every kind of value in both storages");
+
+    for (const bool useQuotes : { false, true })
+    {
+        pepon::PeponQuotes quotes;
+        quotes.useQuotes = useQuotes;
+
+        everyEager.useQuotation(quotes);
+        everyCompact.useQuotation(quotes);
+
+        for (const std::size_t blobsFrom : { std::size_t(0U), std::size_t(1U) })
+        {
+            pepon::PeponSaveOptions saveOptions;
+            saveOptions.binaryLiteralsFrom = blobsFrom;
+
+            const auto eagerFile   = makePath("every eager.pep");
+            const auto compactFile = makePath("every compact.pep");
+
+            everyEager.saveFile(eagerFile, saveOptions);
+            everyCompact.saveFile(compactFile, saveOptions);
+
+            const auto what = std::string(useQuotes ? " (quotes" : " (no quotes") + (blobsFrom > 0U ? ", blobs)" : ")");
+            check(readFile(compactFile) == readFile(eagerFile), "compact and variable storage write the same text" + what);
+
+            // print() is the same text in both storages, without blobs
+            if (blobsFrom == 0U)
+            {
+                std::ostringstream printed;
+                everyCompact.print(printed);
+
+                std::ostringstream eagerPrinted;
+                everyEager.print(eagerPrinted);
+
+                check(printed.str() == readFile(compactFile), "compact print() == saveFile()" + what);
+                check(eagerPrinted.str() == printed.str(), "compact and variable storage print the same text" + what);
+                check(!(eagerPrinted.flags() & std::ios_base::boolalpha), "print() keeps the flags of the stream" + what);
+            }
+        }
+    }
+
+}
+
+
+
+// Loads replace everything, only once they have succeeded. Key handles follow them
+void testLoadAgain()
+{
+
+    const auto first  = makePath("first.pep");
+    const auto second = makePath("second.pep");
+
+    writeFile(first,  "[Settings]\nvalue : int = 1\nname : string = \"first\"\n");
+    writeFile(second, "[Settings]\nvalue : int = 2\n\n[Other]\nx : double = 0.5\n");
+
+    pepon::PeponFile pf;
+    pf.loadFile(first);
+
+    auto handle = pf.resolve("Settings/value");
+    check(pf.get<int>(handle) == 1, "handle after the first load");
+
+    // Same file, then another one
+    pf.loadFile(first);
+    check(pf.get<int>(handle) == 1, "handle after loading the same file again");
+
+    pf.loadFile(second);
+    check(pf.get<int>(handle) == 2 && pf.getGroup("Other").get<double>("x") == 0.5, "second file replaces the first one");
+    check(throwsSyntaxError([&pf]() { pf.getGroup("Settings").get<std::string_view>("name"); }), "variables of the first file are gone");
+
+
+    // Failed loads change nothing
+    const auto broken = makePath("broken.pep");
+    writeFile(broken, "[Settings]\nvalue : int = 3\nlist : vector<int> = { 1, 2\n");
+
+    check(throwsSyntaxError([&]() { pf.loadFile(broken); }), "broken file is rejected");
+    check(throwsSyntaxError([&]() { pf.loadFromMemory("value : int = 4\n"); }), "variable without a group is rejected");
+    check(throwsSyntaxError([&]() { pf.loadBinary(broken); }), "text file is not a binary image");
+
+    check(pf.get<int>(handle) == 2 && pf.getGroup("Other").get<double>("x") == 0.5, "failed loads keep the loaded data");
+    check(pf.reload().isEmpty(), "failed loads keep the file to reload");
+
+
+    // Other kinds of loads
+    const auto image = makePath("second.bin");
+    pf.saveBinary(image);
+
+    pf.loadFromMemory("[Settings]\nvalue : int = 5\n");
+    check(pf.get<int>(handle) == 5, "handle after loadFromMemory()");
+
+    pf.loadBinary(image);
+    check(pf.get<int>(handle) == 2, "handle after loadBinary()");
+
+    const auto index = makePath("first.idx");
+    pepon::PeponFile::saveIndex(first, index);
+
+    pf.loadIndexed(first, index);
+    check(pf.get<int>(handle) == 1, "handle after loadIndexed()");
+
+}
+
+
+
+// Readers keep their snapshot while loads publish new ones
+void testSharedPeponFile()
+{
+
+    pepon::SharedPeponFile config;
+
+    const auto empty = config.get();
+    check(empty != nullptr, "first snapshot is empty, not null");
+
+    config.loadFromMemory("[Settings]\nvalue : int = 1\n");
+    const auto first = config.get();
+
+    const auto fileName = makePath("shared.pep");
+    writeFile(fileName, "[Settings]\nvalue : int = 2\n");
+
+    config.reloadAsync(fileName).get();
+
+    check(first->getGroup("Settings").get<int>("value") == 1, "old snapshot is kept by its readers");
+    check(config.get()->getGroup("Settings").get<int>("value") == 2, "reloadAsync() publishes a new snapshot");
+
+    writeFile(fileName, "[Settings\n");
+
+    check(throwsSyntaxError([&]() { config.reloadAsync(fileName).get(); }), "reloadAsync() reports errors");
+    check(config.get()->getGroup("Settings").get<int>("value") == 2, "failed loads keep the current snapshot");
+
+
+    // Readers while loads go on: every snapshot is whole
+    config.loadFromMemory("[Settings]\nvalue : int = 0\ncopy : int = 0\n");
+
+    std::atomic<bool> isDone { false };
+    std::atomic<int> torn { 0 };
+
+    std::vector<std::thread> readers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&config, &isDone, &torn]()
+        {
+            while (!isDone)
+            {
+                const auto snapshot = config.get();
+                const auto& group = snapshot->getGroup("Settings");
+
+                if (group.get<int>("value") != group.get<int>("copy"))
+                    ++torn;
+            }
+        });
+    }
+
+    for (int i = 0; i < 200; ++i)
+    {
+        const auto number = std::to_string(i);
+        config.loadFromMemory("[Settings]\nvalue : int = " + number + "\ncopy : int = " + number + "\n");
+    }
+
+    isDone = true;
+
+    for (auto& reader : readers)
+        reader.join();
+
+    check(torn == 0, "readers never see half a load");
+
+}
+
+
+
+// Bit packed vector<bool> values behave like std::vector<bool>
+void testBitVector()
+{
+
+    std::vector<bool> expected;
+    pepon::BitVector bits;
+
+    std::uint32_t seed = 777U;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+
+        expected.push_back((seed >> 16U) % 3U == 0U);
+        bits.push_back(expected.back());
+    }
+
+    bits.set(130U, !expected[130U]);
+    expected[130U] = !expected[130U];
+
+    check(bits.size() == 200U && bits.getWords().size() == 4U, "bit vector size");
+    check(std::equal(bits.begin(), bits.end(), expected.begin(), expected.end()), "bit vector values");
+    check(bits.count() == static_cast<std::size_t>(std::count(expected.begin(), expected.end(), true)), "bit vector count");
+
+    // Unused bits of the last word stay 0
+    const pepon::BitVector ones(70U, true);
+    check(ones.count() == 70U && ones.getWords()[1] == 0x3FU, "unused bits are 0");
+    check(pepon::BitVector({ ~std::uint64_t(0U), ~std::uint64_t(0U) }, 65U) == pepon::BitVector(65U, true), "words are masked");
+    check(pepon::BitVector::wordCount(std::numeric_limits<std::uint64_t>::max()) == std::numeric_limits<std::uint64_t>::max() / 64U + 1U, "word count never overflows");
+
+
+    // Parsed, saved and loaded back
+    pepon::PeponFile pf;
+    pf.loadFromMemory("[Bits]\nflags : vector<bool> = { true, 0, 1, false, I_JUST_LIED, true }\nlist : list<bool> = { 1, 0 }\n");
+
+    const auto& flags = pf.getGroup("Bits").get<pepon::BitVector>("flags");
+    check(flags.size() == 6U && flags[0] && !flags[1] && flags[2] && !flags[3] && !flags[4] && flags[5], "parsed vector<bool>");
+    check(pf.getGroup("Bits").get<std::list<bool>>("list") == std::list<bool> { true, false }, "list<bool> is not packed");
+
+    pepon::PeponQuotes quotes;
+    quotes.useQuotes = false;
+
+    const auto fileName = makePath("bits.pep");
+    pf.useQuotation(quotes);
+    pf.saveFile(fileName);
+
+    pepon::PeponFile loaded;
+    loaded.loadFile(fileName);
+
+    check(loaded.getGroup("Bits").get<pepon::BitVector>("flags") == flags, "vector<bool> round trip");
+
+}
+
+
+
+// Numbers read without copy, or copied exactly into the caller's buffers
+void testSpans()
+{
+
+    for (const bool compact : { false, true })
+    {
+        const auto what = std::string(compact ? " (compact)" : "");
+
+        pepon::PeponLoadOptions options;
+        options.compact = compact;
+
+        pepon::PeponFile pf;
+        pf.loadFromMemory("[Numbers]\nints : vector<int> = { 1, -2, 3 }\nfloats : deque<float> = { 0.5, 1.5 }\n"
+                          "units : list<uint> = { 4000000000 }\nname : string = \"x\"\n", options);
+
+        const auto& group = pf.getGroup("Numbers");
+        const auto span = group.getSpan<int>("ints");
+
+        check(span.size() == 3U && span[1] == -2 && span.data() == group.get<std::vector<int>>("ints").data(), "span is a view of the vector" + what);
+        check(throwsSyntaxError([&group]() { group.getSpan<float>("ints"); }), "span of another type" + what);
+        check(throwsSyntaxError([&group]() { group.getSpan<float>("floats"); }), "span of a deque" + what);
+
+        std::vector<double> doubles(4U, -1.0);
+        check(group.copyTo("ints", doubles.data(), doubles.size()) == 3U && doubles == std::vector<double> { 1.0, -2.0, 3.0, -1.0 }, "int -> double copy" + what);
+        check(group.copyTo("floats", doubles.data(), 1U) == 1U && doubles[0] == 0.5, "copies up to count" + what);
+
+        long long units = 0;
+        check(group.copyTo("units", &units, 1U) == 1U && units == 4000000000LL, "uint -> long long copy" + what);
+
+        int narrow[2] = {};
+        float single[3] = {};
+
+        check(throwsSyntaxError([&]() { group.copyTo("units", narrow, 2U); }), "uint -> int is not exact" + what);
+        check(throwsSyntaxError([&]() { group.copyTo("ints", single, 3U); }), "int -> float is not exact" + what);
+        check(throwsSyntaxError([&]() { group.copyTo("name", narrow, 2U); }), "strings are not copied" + what);
+        check(throwsSyntaxError([&]() { group.copyTo("missing", narrow, 2U); }), "missing variable" + what);
+    }
+
+}
+
+
+
+// Blob literals: raw little endian values, base64 or hexadecimal encoded
+void testBlobs()
+{
+
+    const std::string text = "[Blobs]\n"
+                             "w : vector<float> = b64{AACAPwAAAEA=}\n"
+                             "h : vector<int> = hex{ 01000000 feffffff }\n"
+                             "m : vector<double> = b64{\n"
+                             "    AAAAAAAA8D8A\n"
+                             "    AAAAAAAAQA==\n"
+                             "}\n"
+                             "e : vector<uint> = hex{}\n";
+
+    for (const bool lazy : { false, true })
+    {
+        const auto what = std::string(lazy ? " (lazy)" : "");
+
+        pepon::PeponLoadOptions options;
+        options.lazy = lazy;
+
+        pepon::PeponFile pf;
+        pf.loadFromMemory(text, options);
+
+        const auto& group = pf.getGroup("Blobs");
+
+        check(group.get<std::vector<float>>("w") == std::vector<float> { 1.0f, 2.0f }, "base64 blob" + what);
+        check(group.get<std::vector<int>>("h") == std::vector<int> { 1, -2 }, "hexadecimal blob" + what);
+        check(group.get<std::vector<double>>("m") == std::vector<double> { 1.0, 2.0 }, "multiline blob" + what);
+        check(group.get<std::vector<uint>>("e").empty(), "empty blob" + what);
+    }
+
+
+    // Broken blobs
+    for (const auto* value : { "vector<int> = hex{ 010000 }", "vector<int> = hex{ 0100000g }", "vector<float> = b64{AACAPw=A}",
+                               "vector<double> = b64{AACAPw==}", "list<int> = hex{ 01000000 }", "vector<string> = hex{ 01000000 }" })
+    {
+        pepon::PeponFile pf;
+        check(throwsSyntaxError([&pf, value]() { pf.loadFromMemory(std::string("[Blobs]\nx : ") + value + "\n"); }), std::string("broken blob rejected: ") + value);
+    }
+
+}
+
+
+
+// Large containers are parsed in parallel in a single chunk, and by their chunk's thread otherwise
+void testContainerThreads()
+{
+
+    // Large enough to be parsed in parts
+    auto makeVector = [](int first)
+    {
+        std::string values;
+
+        for (int i = 0; i < 80000; ++i)
+            values += std::to_string(first + i) + ", ";
+
+        return values + "0";
+    };
+
+    const auto single = "[Single]\nvalues : vector<int> = { " + makeVector(0) + " }\n";
+
+    std::string several;
+
+    for (int i = 0; i < 4; ++i)
+        several += "[Group " + std::to_string(i) + "]\nvalues : vector<int> = { " + makeVector(i) + " }\n\n";
+
+    for (const auto& [text, what] : { std::pair(single, "large vector of a single chunk"), std::pair(several, "large vectors of several chunks") })
+    {
+        pepon::PeponFile serial;
+        serial.loadFromMemory(text);
+
+        pepon::PeponLoadOptions options;
+        options.threads = 4U;
+
+        pepon::PeponFile threaded;
+        threaded.loadFromMemory(text, options);
+
+        check(savedText(threaded, "threaded.pep") == savedText(serial, "serial.pep"), what);
+    }
+
+}
+
+
+
+// Every event of a PeponReader, as text
+class EventRecorder final : public pepon::PeponHandler
+{
+
+    public:
+
+        // Skip broken lines (true), or stop there
+        explicit EventRecorder(bool skipErrors = false) : m_skipErrors(skipErrors) {}
+
+        void onComment(std::string_view comment) override { events += "comment " + std::string(comment) + '\n'; }
+        void onGroupBegin(std::string_view name) override  { events += "group " + std::string(name) + '\n'; }
+
+        void onScalar(std::string_view name, pepon::e_cppTypes type, std::string_view rawValue) override
+        {
+            events += "scalar " + std::string(name) + ' ' + std::to_string(static_cast<int>(type)) + " [" + std::string(rawValue) + "]\n";
+        }
+
+        void onContainerBegin(std::string_view name, std::string_view container, pepon::e_cppTypes type, pepon::e_blobEncoding) override
+        {
+            events += "container " + std::string(name) + ' ' + std::string(container) + ' ' + std::to_string(static_cast<int>(type)) + '\n';
+        }
+
+        void onContainerElement(std::string_view rawValue) override { events += "  [" + std::string(rawValue) + "]\n"; }
+        void onContainerEnd() override                              { events += "end\n"; }
+
+        auto onError(const pepon::SyntaxError&, std::size_t lineNumber) -> bool override
+        {
+            events += "error " + std::to_string(lineNumber) + '\n';
+            return m_skipErrors;
+        }
+
+    public:
+
+        std::string events;
+
+    private:
+
+        bool m_skipErrors;
+
+};
+
+
+// Streamed events do not depend on the window size, nor on the source
+void testReader()
+{
+
+    const std::string text = "// Header\n"
+                             "[First group]\n"
+                             "a : int = 1\n"
+                             "s : string = \"one line\"\n"
+                             "m : string = \"first line\n"
+                             "  [not a group]\n"
+                             "last\"\n"
+                             "v : vector<double> = { 1.5, 2.5,\n"
+                             "  3.5,\n"
+                             "  4.5 }\n"
+                             "\n"
+                             "# Second\n"
+                             "[Second]\n"
+                             "l : list<string> = { x, y }\n"
+                             "b : vector<float> = b64{AACAPwAAAEA=}\n";
+
+    EventRecorder expected;
+    check(pepon::PeponReader(expected).readMemory(text), "readMemory() reads everything");
+
+    check(expected.events.find("group First group\nscalar a") != std::string::npos && expected.events.find("group Second") != std::string::npos,
+          "reader events");
+    check(expected.events.find("group not a group") == std::string::npos, "multiline strings are not parsed");
+
+    for (const std::size_t windowSize : { std::size_t(8U), std::size_t(17U), std::size_t(64U) })
+    {
+        EventRecorder small;
+        pepon::PeponReader(small, windowSize).readMemory(text);
+
+        check(small.events == expected.events, "same events with a " + std::to_string(windowSize) + " bytes window");
+    }
+
+    const auto fileName = makePath("reader.pep");
+    writeFile(fileName, text);
+
+    EventRecorder fromFile;
+    pepon::PeponReader(fromFile, 16U).readFile(fileName);
+
+    std::istringstream stream(text);
+    EventRecorder fromStream;
+    pepon::PeponReader(fromStream, 16U).readStream(stream);
+
+    check(fromFile.events == expected.events && fromStream.events == expected.events, "same events from a file and a stream");
+
+
+    // Errors: skip the line, or stop
+    const std::string broken = "[G]\na : int = 1\nb : int = { 2\n}\nc int = 3 }\nd : int = 4\n";
+
+    EventRecorder skipping(true);
+    check(pepon::PeponReader(skipping).readMemory(broken), "skipped errors do not stop reading");
+    check(skipping.events.find("error 5") != std::string::npos && skipping.events.find("scalar d") != std::string::npos, "reading goes on after an error");
+
+    EventRecorder stopping(false);
+    check(!pepon::PeponReader(stopping).readMemory(broken), "handlers can stop reading");
+    check(stopping.events.find("scalar d") == std::string::npos, "nothing is read after a stop");
+
+    pepon::PeponHandler throwing;
+    check(throwsSyntaxError([&]() { pepon::PeponReader(throwing).readMemory(broken); }), "errors are thrown by default");
+
+}
+
+
+
+// Streamed text loads back into the written values, in the format of saveFile()
+void testWriter()
+{
+
+    pepon::PeponQuotes quotes;
+    quotes.useQuotes = false;
+
+    // Same values into any sink
+    auto writeAll = [&quotes](pepon::PeponWriter& writer)
+    {
+        writer.useQuotation(quotes);
+
+        writer.comment("Generated");
+        writer.beginGroup("Exports");
+        writer.write("count", 3);
+        writer.write("big", 4000000000U);
+        writer.write("enabled", true);
+        writer.write("ratio", 0.1);
+        writer.write("name", std::string("exports"));
+        writer.write("weights", std::vector<float> { 0.5f, 1.0f, 2.0f });
+        writer.write("queue", std::deque<int> { -1, -2 });
+        writer.write("names", std::list<std::string> { "a", "b" });
+        writer.endGroup();
+
+        writer.beginGroup("Second");
+        writer.write("flags", std::vector<bool> { true, false, true });
+        writer.flush();
+    };
+
+    std::string memory;
+    pepon::PeponWriter toMemory(memory);
+    writeAll(toMemory);
+
+    pepon::PeponFile pf;
+    pf.loadFromMemory(memory);
+
+    const auto& group = pf.getGroup("Exports");
+
+    check(group.get<int>("count") == 3 && group.get<uint>("big") == 4000000000U && group.get<bool>("enabled"), "written scalars");
+    check(group.get<double>("ratio") == 0.1 && group.get<std::string_view>("name") == "exports", "written double and string");
+    check(group.get<std::vector<float>>("weights") == std::vector<float> { 0.5f, 1.0f, 2.0f }, "written vector");
+    check(group.get<std::deque<int>>("queue") == std::deque<int> { -1, -2 }, "written deque");
+    check(group.get<std::list<std::string>>("names") == std::list<std::string> { "a", "b" }, "written list");
+    check(group.getComments().size() == 1U && group.getComments().front() == "Generated", "written comment");
+    check(pf.getGroup("Second").get<pepon::BitVector>("flags").size() == 3U, "written vector<bool>");
+
+    pf.useQuotation(quotes);
+    const auto saved = savedText(pf, "written.pep");
+
+    const auto fromWriter = makePath("writer.pep");
+    writeFile(fromWriter, memory);
+
+    pepon::PeponFile reloaded;
+    reloaded.loadFile(fromWriter);
+    reloaded.useQuotation(quotes);
+
+    check(savedText(reloaded, "rewritten.pep") == saved, "writer format == saveFile() format");
+
+
+    // Other sinks
+    std::ostringstream stream;
+    {
+        pepon::PeponWriter toStream(stream);
+        writeAll(toStream);
+    }
+
+    const auto fileName = makePath("writer_fd.pep");
+    const int descriptor = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    {
+        pepon::PeponWriter toDescriptor(descriptor);
+        writeAll(toDescriptor);
+    }
+    ::close(descriptor);
+
+    check(stream.str() == memory && readFile(fileName) == memory, "same text in every sink");
+
+    std::string outside;
+    pepon::PeponWriter writer(outside);
+    check(throwsSyntaxError([&writer]() { writer.write("x", 1); }), "values outside of a group");
+
+}
+
+
+
+// Groups and variables that do not match a filter are never loaded
+void testFilters()
+{
+
+    check(pepon::globMatch("Net*", "Network") && pepon::globMatch("G?oup *", "Group 12") && pepon::globMatch("*", ""), "glob matches");
+    check(!pepon::globMatch("Net*", "Sub Network") && !pepon::globMatch("G?", "G") && !pepon::globMatch("a*b", "a-c"), "glob mismatches");
+
+    const std::string text = "// Network comment\n"
+                             "[Network]\n"
+                             "timeout : int = 30\n"
+                             "host : string = \"local\"\n"
+                             "\n"
+                             "// Skipped comment\n"
+                             "[Skipped]\n"
+                             "note : string = \"looks like\n"
+                             "[Network 2]\n"
+                             "a group\"\n"
+                             "broken : int = { 1\n"
+                             "}\n"
+                             "\n"
+                             "[Network 2]\n"
+                             "timeout : int = 60\n"
+                             "secret : string = \"hidden\"\n";
+
+    pepon::PeponFilter filter;
+    filter.groups    = { "Net*" };
+    filter.variables = [](std::string_view, std::string_view variable) { return variable != "secret"; };
+
+    for (const bool lazy : { false, true })
+    {
+        for (const unsigned threads : { 1U, 4U })
+        {
+            const auto what = std::string(lazy ? " (lazy, " : " (") + std::to_string(threads) + " threads)";
+
+            pepon::PeponLoadOptions options;
+            options.filter  = filter;
+            options.lazy    = lazy;
+            options.threads = threads;
+
+            pepon::PeponFile pf;
+            pf.loadFromMemory(text, options);
+
+            check(pf.getGroup("Network").get<int>("timeout") == 30 && pf.getGroup("Network 2").get<int>("timeout") == 60, "matching groups are loaded" + what);
+            check(throwsSyntaxError([&pf]() { pf.getGroup("Network 2").get<std::string_view>("secret"); }), "filtered variable" + what);
+            check(pf.getGroup("Network 2").getComments().empty(), "comments of skipped groups are skipped" + what);
+
+            bool found = true;
+
+            try
+            {
+                pf.getGroup("Skipped");
+            }
+            catch (const std::exception&)
+            {
+                found = false;
+            }
+
+            check(!found, "skipped group is not loaded" + what);
+        }
+    }
+
+
+    // Binary images and indexed files are filtered too
+    pepon::PeponFile everything;
+    everything.loadFromMemory("[Network]\ntimeout : int = 30\nsecret : int = 1\n\n[Other]\nx : int = 1\n");
+
+    const auto image = makePath("filter.bin");
+    everything.saveBinary(image);
+
+    pepon::PeponLoadOptions options;
+    options.filter = filter;
+
+    pepon::PeponFile binary;
+    binary.loadBinary(image, options);
+
+    check(binary.getGroup("Network").size() == 1U, "filtered binary image");
+    check(throwsSyntaxError([&binary]() { binary.resolve("Other/x"); }), "filtered binary group");
+
+    const auto fileName = makePath("filter.pep");
+    const auto index    = makePath("filter.idx");
+
+    writeFile(fileName, text);
+    pepon::PeponFile::saveIndex(fileName, index);
+
+    pepon::PeponFile indexed;
+    indexed.loadIndexed(fileName, index, options);
+
+    check(indexed.getGroup("Network 2").get<int>("timeout") == 60 && indexed.getGroup("Network 2").size() == 1U, "filtered indexed file");
+    check(throwsSyntaxError([&indexed]() { indexed.resolve("Skipped/note"); }), "filtered indexed group");
+
+}
+
+
+
+// Group indexes are checked before any group is parsed from them
+void testGroupIndexFile()
+{
+
+    const auto fileName = makePath("indexed.pep");
+    const auto index    = makePath("indexed.idx");
+
+    writeFile(fileName, "// A\n[A]\na : int = 1\n\n[B]\nb : int = 2\n");
+    pepon::PeponFile::saveIndex(fileName, index);
+
+    pepon::PeponFile pf;
+    pf.loadIndexed(fileName, index);
+
+    check(pf.getGroup("B").get<int>("b") == 2 && pf.getGroup("A").getComments().front() == "A", "indexed groups");
+
+    const auto image = readFile(index);
+
+    // Header: magic, version, group count, file size and time. Entries: offset, size, name size (padded), name
+    constexpr std::size_t HEADER_SIZE = 32U;
+    constexpr std::size_t ENTRY_SIZE  = 24U;
+
+    const auto firstName  = HEADER_SIZE + ENTRY_SIZE;
+    const auto secondName = firstName + 1U + ENTRY_SIZE;
+
+    check(image.size() == secondName + 1U && image[firstName] == 'A' && image[secondName] == 'B', "group index layout");
+
+    auto rejects = [&](std::string_view what, auto patch)
+    {
+        auto broken = image;
+        patch(broken);
+
+        writeFile(index, broken);
+
+        pepon::PeponFile other;
+        check(throwsSyntaxError([&]() { other.loadIndexed(fileName, index); }), std::string("broken group index rejected: ") + std::string(what));
+    };
+
+    rejects("unsorted", [&](std::string& broken) { std::swap(broken[firstName], broken[secondName]); });
+    rejects("duplicated", [&](std::string& broken) { broken[secondName] = 'A'; });
+    rejects("overlapping", [&](std::string& broken) { std::fill_n(broken.begin() + static_cast<std::ptrdiff_t>(firstName + 1U), 8, '\0'); });
+    rejects("out of the file", [&](std::string& broken) { broken[firstName + 1U + 8U] = '\x7f'; });
+    rejects("huge count", [&](std::string& broken) { std::fill_n(broken.begin() + 12, 4, '\xff'); });
+    rejects("truncated", [&](std::string& broken) { broken.pop_back(); });
+
+
+    // Saves write every group, not only those parsed so far
+    const std::string_view threeGroups = "[A]\na : int = 1\n\n[B]\nb : int = 2\n\n[C]\nc : int = 3\n";
+
+    pepon::PeponFile eager;
+    eager.loadFromMemory(threeGroups);
+
+    const auto expected = savedText(eager, "eager.pep");
+
+    for (const bool useMemoryMap : { false, true })
+    {
+        const auto what = std::string(useMemoryMap ? " (memory mapped)" : "");
+
+        writeFile(fileName, threeGroups);
+        pepon::PeponFile::saveIndex(fileName, index);
+
+        pepon::PeponLoadOptions options;
+        options.useMemoryMap = useMemoryMap;
+
+        pepon::PeponFile partial;
+        partial.loadIndexed(fileName, index, options);
+        partial.getGroup("B");
+
+        // getGroup() on another thread while the groups left are parsed and written
+        std::thread reader([&partial]() { partial.getGroup("C"); partial.getGroup("A"); });
+        const auto saved = savedText(partial, "partial.pep");
+        reader.join();
+
+        check(saved == expected, "saveFile() writes the groups of an indexed file not parsed yet" + what);
+
+        pepon::PeponFile imageSource;
+        imageSource.loadIndexed(fileName, index, options);
+        imageSource.getGroup("B");
+
+        const auto image = makePath("partial.bin");
+        imageSource.saveBinary(image);
+
+        pepon::PeponFile fromImage;
+        fromImage.loadBinary(image);
+
+        check(savedText(fromImage, "from image.pep") == expected, "saveBinary() writes the groups of an indexed file not parsed yet" + what);
+
+        // Over the indexed file itself: it is replaced, not truncated under the groups
+        pepon::PeponQuotes noQuotes;
+        noQuotes.useQuotes = false;
+
+        pepon::PeponFile self;
+        self.loadIndexed(fileName, index, options);
+        self.useQuotation(noQuotes);
+        self.getGroup("B");
+        self.saveFile(fileName);
+
+        pepon::PeponFile reloaded;
+        reloaded.loadFile(fileName);
+
+        check(self.getGroup("C").get<int>("c") == 3 && savedText(reloaded, "reloaded.pep") == expected, "saveFile() over its indexed file" + what);
+    }
+
+}
+
+
+
+// Cached images load into the parsed values, until the file changes. Damaged entries are parsed again
+void testParseCache()
+{
+
+    const auto directory = makePath("cache");
+    std::filesystem::remove_all(directory);
+
+    const auto fileName = makePath("cached.pep");
+    const auto text = makeLargeText();
+
+    writeFile(fileName, text);
+
+    pepon::PeponFile parsed;
+    parsed.loadFromMemory(text);
+
+    const auto expected = savedText(parsed, "parsed.pep");
+
+    pepon::PeponLoadOptions options;
+    options.cacheDirectory = directory;
+
+    // Every entry of the cache
+    auto entries = [&directory]()
+    {
+        std::vector<std::filesystem::path> files;
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+            files.push_back(entry.path());
+
+        return files;
+    };
+
+    pepon::PeponFile first;
+    first.loadFile(fileName, options);
+
+    check(entries().size() == 1U, "first load writes a cache entry");
+    check(savedText(first, "first.pep") == expected, "first load parses the file");
+
+    const auto entryTime = std::filesystem::last_write_time(entries().front());
+
+    pepon::PeponFile second;
+    second.loadFile(fileName, options);
+
+    check(savedText(second, "second.pep") == expected, "cached image == parsed file");
+    check(std::filesystem::last_write_time(entries().front()) == entryTime, "cached image is not written again");
+
+
+    // Changed file: parsed again
+    writeFile(fileName, "[Group 1]\ncount : int = 1000\n");
+    std::filesystem::last_write_time(fileName, std::filesystem::last_write_time(fileName) + std::chrono::seconds(2));
+
+    pepon::PeponFile changed;
+    changed.loadFile(fileName, options);
+
+    check(changed.getGroup("Group 1").get<int>("count") == 1000 && changed.getGroup("Group 1").size() == 1U, "changed file is parsed again");
+
+
+    // Damaged entries: parsed again
+    for (const auto& entry : entries())
+    {
+        auto damaged = readFile(entry.string());
+        damaged.resize(damaged.size() - 16U);
+        writeFile(entry.string(), damaged);
+    }
+
+    pepon::PeponFile repaired;
+    repaired.loadFile(fileName, options);
+
+    check(repaired.getGroup("Group 1").get<int>("count") == 1000, "damaged entry is parsed again");
+
+    pepon::PeponFile fromRepaired;
+    fromRepaired.loadFile(fileName, options);
+
+    check(fromRepaired.getGroup("Group 1").get<int>("count") == 1000, "repaired entry");
+
+
+    // Selective loads are not cached
+    std::filesystem::remove_all(directory);
+
+    options.filter.groups = { "Group 1" };
+
+    pepon::PeponFile filtered;
+    filtered.loadFile(fileName, options);
+
+    check(entries().empty(), "selective loads are not cached");
+
+}
+
+// Runs "attach" in a child process. True if it returned true
+template <typename Function>
+auto inChildProcess(Function attach) -> bool
+{
+    const pid_t child = fork();
+
+    if (child < 0)
+        return false;
+
+    if (child == 0)
+    {
+        bool attached = false;
+
+        try
+        {
+            attached = attach();
+        }
+        catch (...)
+        {
+        }
+
+        // No atexit handlers: they belong to the parent
+        _exit(attached ? 0 : 1);
+    }
+
+    int status = 0;
+
+    return waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+void testSharedMemory()
+{
+
+    pepon::PeponFile original;
+    original.loadFromMemory(makeLargeText());
+
+    const std::string name = "/pepon_test_" + std::to_string(getpid());
+
+    original.saveShared(name);
+    const int fileDescriptor = original.saveShared();
+
+    check(fileDescriptor >= 0, "memfd created");
+
+
+    // Another process loads the segment
+    auto loads = [](pepon::PeponFile& pf)
+    {
+        const auto& group = pf.getGroup("Group 7");
+
+        return group.get<int>("count") == 7 &&
+               group.get<std::string_view>("name") == "name 7" &&
+               group.get<std::vector<float>>("values").at(1) == 7.0F &&
+               pf.getGroup("Large").get<std::vector<double>>("weights").size() == 120001U;
+    };
+
+    check(inChildProcess([&]() { pepon::PeponFile pf; pf.loadShared(name); return loads(pf); }), "named segment loaded by another process");
+    check(inChildProcess([&]() { pepon::PeponFile pf; pf.loadShared(fileDescriptor); return loads(pf); }), "inherited memfd loaded by another process");
+
+
+    // Another process reads the arrays in place
+    auto readsInPlace = [](const pepon::MappedFile& segment)
+    {
+        const pepon::BinaryView view(segment.view());
+
+        const auto weights = view.findGroup("Large")->find("weights")->getArray<double>();
+        const auto* begin = reinterpret_cast<const char*>(weights.data());
+
+        return weights.size() == 120001U && weights[3] == 3.5 &&
+               begin >= segment.view().data() && begin < segment.view().data() + segment.size() &&
+               view.findGroup("Group 7")->find("values")->getArray<float>()[1] == 7.0F;
+    };
+
+    check(inChildProcess([&]() { return readsInPlace(pepon::SharedSegment::attach(name)); }), "named segment read in place by another process");
+    check(inChildProcess([&]() { return readsInPlace(pepon::SharedSegment::attach(fileDescriptor)); }), "inherited memfd read in place by another process");
+
+
+    // Through the PeponFile API: numeric containers stay in the segment, getSpan() and copyTo() read them in place
+    auto queriesInPlace = [](pepon::PeponFile& pf)
+    {
+        const auto& large   = pf.getGroup("Large");
+        const auto& weights = *large.find("weights");
+
+        const auto span = large.getSpan<double>("weights");
+
+        std::vector<double> copied(4U);
+        const auto count = large.copyTo("weights", copied.data(), copied.size());
+
+        const bool inPlace = weights.isInImage() && !weights.isDecoded() &&
+                             span.size() == 120001U && span[3] == 3.5 && count == 4U && copied[3] == 3.5;
+
+        // get() copies it, once
+        return inPlace && large.get<std::vector<double>>("weights")[3] == 3.5 && weights.isDecoded() &&
+               large.getSpan<double>("weights").data() == span.data();
+    };
+
+    check(inChildProcess([&]() { pepon::PeponFile pf; pf.loadShared(name); return queriesInPlace(pf); }), "loadShared() queries read the segment in place");
+
+
+    // Unlinked segments: attached processes keep their mapping, new ones fail
+    auto segment = pepon::SharedSegment::attach(name);
+    pepon::SharedSegment::remove(name);
+
+    check(readsInPlace(segment), "mapping kept once unlinked");
+    check(inChildProcess([&]() { pepon::PeponFile pf; return throwsSyntaxError([&]() { pf.loadShared(name); }); }), "unlinked segment not found");
+
+    close(fileDescriptor);
+
+}
+
+// Reloads parse the changed groups into their own text: memory stays bounded, and the file can be rewritten in place
+void testReload()
+{
+
+    const auto fileName = makePath("reload.pep");
+
+    // Same size every time: only the modification time tells the versions apart
+    auto makeText = [](int version)
+    {
+        const auto digit = std::to_string(version % 10);
+        return "[Kept]\nname : string = \"kept\"\nvalues : vector<int> = { 1, 2, 3 }\n\n"
+               "[Changing]\nversion : int = " + digit + "\nlabel : string = \"version " + digit + "\"\n";
+    };
+
+    writeFile(fileName, makeText(0));
+    const auto start = std::filesystem::last_write_time(fileName);
+
+    auto rewrite = [&](int version)
+    {
+        writeFile(fileName, makeText(version));
+        std::filesystem::last_write_time(fileName, start + std::chrono::seconds(version));
+    };
+
+    pepon::PeponLoadOptions options;
+    options.useMemoryMap = true;
+
+    pepon::PeponFile pf;
+    pf.loadFile(fileName, options);
+
+    // The first reload needs the mapped text: replace the file
+    const auto replacement = makePath("reload.tmp");
+    writeFile(replacement, makeText(1));
+    std::filesystem::rename(replacement, fileName);
+    std::filesystem::last_write_time(fileName, start + std::chrono::seconds(1));
+
+    auto changes = pf.reload();
+
+    check(changes.changedGroups == std::vector<std::string> { "Changing" } &&
+          changes.changedVariables == std::vector<std::string> { "Changing/label", "Changing/version" } &&
+          changes.addedGroups.empty() && changes.removedGroups.empty(), "first reload changes");
+
+    const auto* kept = &pf.getGroup("Kept");
+    const auto firstSize = pf.getTextSize();
+
+    check(firstSize < 2U * makeText(1).size(), "first reload releases the loaded file");
+
+
+    // Then in place: nothing is a view into the file anymore
+    bool changed = true;
+
+    for (int version = 2; version <= 200; ++version)
+    {
+        rewrite(version);
+        changes = pf.reload();
+
+        changed = changed && changes.changedVariables == std::vector<std::string> { "Changing/label", "Changing/version" } &&
+                  pf.getGroup("Changing").get<int>("version") == version % 10;
+    }
+
+    check(changed, "in place rewrites reloaded");
+    check(&pf.getGroup("Kept") == kept, "unchanged group kept");
+    check(kept->get<std::string_view>("name") == "kept" && kept->get<std::vector<int>>("values") == std::vector<int> { 1, 2, 3 }, "unchanged group values");
+    check(pf.getTextSize() == firstSize, "memory bounded across reloads");
+
+
+    // Removed, added, then the same text again
+    writeFile(fileName, "[Added]\nx : int = 1\n\n[Kept]\nname : string = \"kept\"\nvalues : vector<int> = { 1, 2, 3 }\n\n");
+    std::filesystem::last_write_time(fileName, start + std::chrono::seconds(300));
+
+    changes = pf.reload();
+
+    check(changes.addedGroups == std::vector<std::string> { "Added" } && changes.removedGroups == std::vector<std::string> { "Changing" } &&
+          changes.addedVariables == std::vector<std::string> { "Added/x" } &&
+          changes.removedVariables == std::vector<std::string> { "Changing/label", "Changing/version" }, "groups added and removed");
+    check(&pf.getGroup("Kept") == kept, "unchanged group kept when others are removed");
+
+    std::filesystem::last_write_time(fileName, start + std::chrono::seconds(301));
+    check(pf.reload().isEmpty(), "same text, no changes");
+
+}
+
+// Changes compare decoded values with the data loaded before. Subscribers only get the changes of their key
+void testChanges()
+{
+
+    const auto fileName = makePath("changes.pep");
+
+    const std::string settings = "[Settings]\nvalue : int = 1\nname : string = \"first\"\nlist : deque<double> = { 1.5, 2 }\n\n";
+    const std::string other    = "[Other]\nx : double = 0.5\n";
+
+    writeFile(fileName, settings + other);
+    const auto start = std::filesystem::last_write_time(fileName);
+
+    auto update = [&](std::string_view text, int seconds)
+    {
+        writeFile(fileName, text);
+        std::filesystem::last_write_time(fileName, start + std::chrono::seconds(seconds));
+    };
+
+    pepon::PeponFile pf;
+
+    std::mutex mutex;
+    std::vector<std::pair<std::string, pepon::PeponChanges>> received;
+
+    for (std::string key : { "Settings", "Settings/value", "Other/x" })
+    {
+        pf.subscribe(key, [&mutex, &received, key](const pepon::PeponChanges& changes)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            received.emplace_back(key, changes);
+        });
+    }
+
+    auto takeReceived = [&]()
+    {
+        pf.waitForNotifications();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::exchange(received, {});
+    };
+
+    using t_names = std::vector<std::string>;
+
+    pf.loadFile(fileName);
+    auto notified = takeReceived();
+
+    check(notified.size() == 3U && notified[0].first == "Settings" &&
+          notified[0].second.addedGroups == t_names { "Settings" } &&
+          notified[0].second.addedVariables == t_names { "Settings/list", "Settings/name", "Settings/value" } &&
+          notified[1].second.addedGroups.empty() && notified[1].second.addedVariables == t_names { "Settings/value" } &&
+          notified[2].second.addedVariables == t_names { "Other/x" }, "first load adds everything");
+
+    pf.loadFile(fileName);
+    check(takeReceived().empty(), "loading the same file again changes nothing");
+
+    auto handle = pf.resolve("Settings/value");
+
+
+    // Another layout of the same values
+    update("[Settings]\nvalue:int=01\n  name : string = \"first\"\nlist : deque<double> = {1.50,\n    2.0}\n\n[Other]\nx : double = 0.50\n", 1);
+
+    check(pf.reload().isEmpty() && takeReceived().empty(), "another layout is no change");
+    check(pf.get<int>(handle) == 1, "handle after the first reload");
+
+    const auto* otherGroup = &pf.getGroup("Other");
+
+    update(settings + "[Other]\nx : double = 5e-1\n", 2);
+
+    check(pf.reload().isEmpty() && takeReceived().empty(), "another number format is no change");
+    check(&pf.getGroup("Other") == otherGroup, "same values: group kept");
+
+
+    // Only the subscribers of what changed are called
+    update("[Settings]\nvalue : int = 2\nname : string = \"first\"\nlist : deque<double> = { 1.5, 2 }\n\n" + other, 3);
+
+    auto changes = pf.reload();
+    notified = takeReceived();
+
+    check(changes.changedGroups == t_names { "Settings" } && changes.changedVariables == t_names { "Settings/value" } &&
+          changes.addedVariables.empty() && changes.removedVariables.empty(), "changed value");
+    check(notified.size() == 2U && notified[0].first == "Settings" && notified[1].first == "Settings/value" &&
+          notified[0].second.changedGroups == t_names { "Settings" } && notified[1].second.changedGroups.empty() &&
+          notified[1].second.changedVariables == t_names { "Settings/value" }, "subscribers of the changed value");
+    check(&pf.getGroup("Other") == otherGroup, "unchanged group kept");
+    check(pf.get<int>(handle) == 2, "handle resolved again after a reload");
+
+    // Same text of another type
+    update("[Settings]\nvalue : uint = 2\nname : string = \"first\"\nlist : deque<double> = { 1.5, 2 }\n\n" + other, 4);
+    check(pf.reload().changedVariables == t_names { "Settings/value" }, "changed type");
+
+    takeReceived();
+
+    // Comments only (they belong to the next group)
+    update("// Note\n[Settings]\nvalue : uint = 2\nname : string = \"first\"\nlist : deque<double> = { 1.5, 2 }\n\n" + other, 5);
+
+    pf.loadFile(fileName);
+    notified = takeReceived();
+
+    check(notified.size() == 1U && notified[0].first == "Settings" && notified[0].second.changedGroups == t_names { "Settings" } &&
+          notified[0].second.changedVariables.empty(), "changed comments");
+
+
+    // Another file: compared to the loaded data
+    const auto second = makePath("changes_second.pep");
+    writeFile(second, "[Settings]\nvalue : uint = 2\n\n[Added]\ny : int = 1\n");
+
+    pf.loadFile(second);
+    notified = takeReceived();
+
+    check(notified.size() == 2U && notified[0].first == "Settings" && notified[1].first == "Other/x" &&
+          notified[0].second.changedGroups == t_names { "Settings" } &&
+          notified[0].second.removedVariables == t_names { "Settings/list", "Settings/name" } &&
+          notified[1].second.removedVariables == t_names { "Other/x" }, "another file");
+
+
+    // Lazy values are compared without decoding them: a bad value nobody reads is no error
+    const auto lazyName = makePath("changes_lazy.pep");
+    writeFile(lazyName, "[G]\nok : int = 1\nbad : double = abc\nlist : vector<int> = { 1, 2 }\n");
+
+    pepon::PeponLoadOptions lazy;
+    lazy.lazy = true;
+
+    pepon::PeponFile lazyFile;
+    lazyFile.loadFile(lazyName, lazy);
+    lazyFile.subscribe("G/ok", [](const pepon::PeponChanges&) {});
+
+    check(lazyFile.getGroup("G").get<int>("ok") == 1, "lazy value read");
+    check(!throwsSyntaxError([&]() { lazyFile.loadFile(lazyName, lazy); }), "lazy load again with a bad value");
+    check(!lazyFile.getGroup("G").find("bad")->isDecoded() && !lazyFile.getGroup("G").find("list")->isDecoded(),
+          "lazy values not decoded by the comparison");
+
+    writeFile(lazyName, "[G]\nok : int = 2\nbad : double = abc\nlist : vector<int> = { 1, 2 }\n");
+    check(lazyFile.reload().changedVariables == t_names { "G/ok" }, "changed lazy value");
+
+    writeFile(lazyName, "[G]\nok : int = 02\nbad : double = abc\nlist : vector<int> = {1,2}\n");
+    check(lazyFile.reload().isEmpty(), "another layout of lazy values is no change");
+    check(!lazyFile.getGroup("G").find("ok")->isDecoded() && !lazyFile.getGroup("G").find("list")->isDecoded(),
+          "changed text decoded into a copy only");
+
+    // Containers of a cached image are read in place, and compared to the parsed values
+    pepon::PeponLoadOptions cached;
+    cached.cacheDirectory = makePath("changes_cache");
+    std::filesystem::remove_all(cached.cacheDirectory);
+
+    writeFile(lazyName, "[G]\nok : int = 2\nlist : vector<int> = { 1, 2 }\nbits : vector<bool> = { true, false }\n"
+                        "names : list<string> = { \"a\", \"b\" }\nvalues : deque<double> = { 0.5 }\n");
+
+    pepon::PeponFile cachedFile;
+    cachedFile.subscribe("G", [](const pepon::PeponChanges&) {});
+    cachedFile.loadFile(lazyName, cached);
+
+    bool notifiedAgain = false;
+    cachedFile.subscribe("G/list", [&notifiedAgain](const pepon::PeponChanges&) { notifiedAgain = true; });
+
+    cachedFile.loadFile(lazyName, cached);
+    cachedFile.waitForNotifications();
+
+    check(!notifiedAgain, "cached image is the same as the parsed file");
+    check(cachedFile.getGroup("G").find("list")->isInImage() && !cachedFile.getGroup("G").find("list")->isDecoded(),
+          "cached containers not decoded by the comparison");
+
+    // The same values loaded another way: lazy text, then a lazy cache hit, then eager text, then lazy text again
+    cached.lazy = true;
+    std::filesystem::remove_all(cached.cacheDirectory);
+
+    writeFile(lazyName, "[G]\ni : int = 42\nd : double = 0.5\nv : vector<int> = { 1, 2 }\ns : list<string> = { \"a\" }\n");
+
+    pepon::PeponFile modes;
+    std::vector<pepon::PeponChanges> modeChanges;
+    modes.subscribe("G", [&mutex, &modeChanges](const pepon::PeponChanges& changes)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        modeChanges.push_back(changes);
+    });
+
+    modes.loadFile(lazyName, cached);
+    check(!modes.getGroup("G").find("i")->isInImage(), "lazy text load");
+
+    modes.loadFile(lazyName, cached);
+    check(modes.getGroup("G").find("v")->isInImage(), "lazy cache hit");
+
+    modes.loadFile(lazyName);
+    modes.loadFile(lazyName, lazy);
+    modes.waitForNotifications();
+
+    check(modeChanges.size() == 1U && modeChanges[0].addedGroups == t_names { "G" }, "same values, however they were loaded");
+    check(!modes.getGroup("G").find("i")->isDecoded() && !modes.getGroup("G").find("v")->isDecoded(),
+          "eager to lazy: lazy values stay lazy");
+
+}
+
+// Both reading paths (io_uring when available, and one read after another) read the whole file,
+// and stop without hanging when the file gets shorter or "onData" throws
+void testAsyncFileReader()
+{
+
+    using pepon::AsyncFileReader;
+
+    const auto fileName = makePath("async.bin");
+
+    // Many reads, the last one short
+    std::string content(20U * AsyncFileReader::READ_SIZE + 12345U, '\0');
+
+    for (std::size_t i = 0U; i < content.size(); ++i)
+        content[i] = static_cast<char>('a' + (i * 7U) % 26U);
+
+    for (const bool useIoUring : { true, false })
+    {
+        const std::string path = useIoUring ? (AsyncFileReader::hasIoUring() ? "io_uring" : "io_uring unavailable") : "pread";
+
+        writeFile(fileName, content);
+
+        std::size_t last = 0U;
+        bool growing = true;
+
+        auto file = AsyncFileReader::readFile(fileName, [&](std::string_view ready)
+        {
+            growing = growing && ready.size() > last;
+            last = ready.size();
+        }, useIoUring);
+
+        check(file.view() == content && last == content.size() && growing, "whole file read: " + path);
+
+
+        // Shorter in the middle of a read that is not done yet: a short read is queued again, then the next ones fail
+        bool truncated = false;
+
+        check(throwsSyntaxError([&]()
+        {
+            AsyncFileReader::readFile(fileName, [&](std::string_view ready)
+            {
+                if (!truncated)
+                    truncated = (::truncate(fileName.c_str(), static_cast<off_t>(ready.size() + AsyncFileReader::READ_SIZE * 3U / 2U)) == 0);
+            }, useIoUring);
+        }) && truncated, "file truncated while read: " + path);
+
+
+        // "onData" throws with reads in flight
+        writeFile(fileName, content);
+
+        bool rethrown = false;
+
+        try
+        {
+            AsyncFileReader::readFile(fileName, [](std::string_view) { throw std::runtime_error("stop"); }, useIoUring);
+        }
+        catch (const std::runtime_error& error)
+        {
+            rethrown = (std::string(error.what()) == "stop");
+        }
+
+        check(rethrown, "onData exception rethrown: " + path);
+    }
+
+    // Empty files get one call
+    writeFile(fileName, "");
+
+    std::size_t calls = 0U;
+    AsyncFileReader::readFile(fileName, [&calls](std::string_view ready) { calls += ready.empty() ? 1U : 2U; }, false);
+
+    check(calls == 1U, "empty file");
+
+}
+
+} // anonymous namespace
 
 
 // Main function
@@ -73,5 +2090,41 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] const char* argv[])
     // Save Pepon data to file
     pf.saveFile("./pepon_out.txt");
 
+
+    // Behaviour checks
+    run("memory map", testMemoryMap);
+    run("text arena", testTextArena);
+    run("structural index", testStructuralIndex);
+    run("parallel", testParallel);
+    run("numbers", testNumbers);
+    run("lazy", testLazy);
+    run("binary", testBinary);
+    run("save file", testSaveFile);
+    run("group index", testGroupIndex);
+    run("compact", testCompact);
+    run("load again", testLoadAgain);
+    run("shared pepon file", testSharedPeponFile);
+    run("bit vector", testBitVector);
+    run("spans", testSpans);
+    run("blobs", testBlobs);
+    run("container threads", testContainerThreads);
+    run("reader", testReader);
+    run("writer", testWriter);
+    run("filters", testFilters);
+    run("group index file", testGroupIndexFile);
+    run("parse cache", testParseCache);
+    run("shared memory", testSharedMemory);
+    run("reload", testReload);
+    run("changes", testChanges);
+    run("async file reader", testAsyncFileReader);
+
+    if (failures > 0)
+    {
+        cout << failures << " check(s) failed" << endl;
+        return 1;
+    }
+
+    cout << "Every check passed" << endl;
+
     return 0;
 }